@@ -5,7 +5,11 @@
 // wrapped similarly in their own translation units.
 
 #include "default_eye.hpp"
+#include "eye_style_asset.hpp"
 #include "../../external/Uncanny_Eyes/uncannyEyes/graphics/defaultEye.h"
+#if PME_INDEXED_ASSETS
+#include "defaultEye_indexed.h"  // tools/palettize.py output, generated by CMake
+#endif
 
 static_assert(PME_SCLERA_WIDTH == SCLERA_WIDTH && PME_SCLERA_HEIGHT == SCLERA_HEIGHT,
               "Sclera dimension mismatch; adjust PME_SCLERA_* if upstream asset changes");
@@ -14,20 +18,31 @@ static_assert(PME_IRIS_MAP_WIDTH == IRIS_MAP_WIDTH && PME_IRIS_MAP_HEIGHT == IRI
 static_assert(PME_EYELID_WIDTH == SCREEN_WIDTH && PME_EYELID_HEIGHT == SCREEN_HEIGHT,
               "Eyelid dimension mismatch; adjust PME_EYELID_* if upstream asset changes");
 
+#if !PME_PROCEDURAL_SCLERA && !PME_INDEXED_ASSETS
 // Accessor returns reference to underlying asset data (no copy)
 const uint16_t (&get_sclera())[PME_SCLERA_HEIGHT][PME_SCLERA_WIDTH] {
     return sclera;
 }
+#endif
 
+#if !PME_INDEXED_ASSETS
 // Iris map accessor
 const uint16_t (&get_iris_map())[PME_IRIS_MAP_HEIGHT][PME_IRIS_MAP_WIDTH] {
     return iris;
 }
+#endif
 
 // Eyelid maps
 const uint8_t (&get_upper_eyelid())[PME_EYELID_HEIGHT][PME_EYELID_WIDTH] { return upper; }
 const uint8_t (&get_lower_eyelid())[PME_EYELID_HEIGHT][PME_EYELID_WIDTH] { return lower; }
 
+// Registry entry (eye_style.hpp): index 0, the style every panel boots with
+#if PME_PROCEDURAL_SCLERA
+PME_EYE_STYLE_FROM_UPSTREAM_PROCEDURAL(default_eye, "default", kDefaultScleraRecipe)
+#else
+PME_EYE_STYLE_FROM_UPSTREAM(default_eye, "default")
+#endif
+
 // Clean up imported macros to avoid accidental downstream reliance.
 #undef SCLERA_WIDTH
 #undef SCLERA_HEIGHT
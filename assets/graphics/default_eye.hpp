@@ -14,6 +14,7 @@
 //
 #pragma once
 #include <cstdint>
+#include "procedural_sclera.hpp"
 
 // Dimensions from original file
 #define PME_SCLERA_WIDTH      200
@@ -33,11 +34,28 @@
 #define PME_EYELID_WIDTH      128
 #define PME_EYELID_HEIGHT     128
 
+#if !PME_PROCEDURAL_SCLERA && !PME_INDEXED_ASSETS
 // Accessor to underlying sclera image (returns a reference to 2D array)
 const uint16_t (&get_sclera())[PME_SCLERA_HEIGHT][PME_SCLERA_WIDTH];
+#endif
 
-// Accessor to underlying iris color map (radial rows * angular columns)
+// Stand-in for the sclera table with PME_PROCEDURAL_SCLERA: off-white, darkening toward the corners,
+// red veins that fade out toward the iris. Centre and rim are fitted to the table's ring means over
+// the visible window (tools/sclera_bench.cpp checks them).
+inline constexpr eyes::ScleraRecipe kDefaultScleraRecipe{
+    0xFFFE,     // centre (248, 252, 240)
+    0x3A49,     // rim (56, 72, 72)
+    0xB105,     // vein (176, 32, 40)
+    2, 24,      // vein blend at the centre / corners
+    5,          // vein walks
+    0x5C1E7Au,
+};
+
+#if !PME_INDEXED_ASSETS
+// Accessor to underlying iris color map (radial rows * angular columns; with PME_INDEXED_ASSETS only
+// the palettized map is linked, see EyeStyle::indexed)
 const uint16_t (&get_iris_map())[PME_IRIS_MAP_HEIGHT][PME_IRIS_MAP_WIDTH];
+#endif
 
 // Eyelid threshold maps (0 transparent -> 255 fully covered). Upper covers from top downward,
 // lower covers from bottom upward. Taken from upstream 'upper' and 'lower' arrays when
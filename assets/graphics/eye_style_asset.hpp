@@ -0,0 +1,69 @@
+// Turns one included upstream Uncanny Eyes graphics header into an eyes::EyeStyle.
+// Use once per translation unit, right after including the header (its arrays have internal
+// linkage, so every style gets its own TU - see styles/*.cpp and default_eye.cpp).
+#pragma once
+#include "default_eye.hpp"
+#include "eye_style.hpp"
+#include "procedural_sclera.hpp"
+
+#ifndef PROGMEM
+#define PROGMEM // Arduino flash qualifier used by some upstream headers; const data is in flash here
+#endif
+
+#define PME_EYE_STYLE_CHECK_UPSTREAM_()                                                                 \
+    static_assert(SCREEN_WIDTH == PME_EYELID_WIDTH && SCREEN_HEIGHT == PME_EYELID_HEIGHT,              \
+                  "eyelid maps must match the reference screen");                                      \
+    static_assert(SCLERA_WIDTH >= PME_EYELID_WIDTH && SCLERA_HEIGHT >= PME_EYELID_HEIGHT,              \
+                  "sclera must cover the reference screen");                                           \
+    static_assert(IRIS_MAP_HEIGHT <= 256, "iris map rows are indexed with 8 bits");
+
+// With PME_INDEXED_ASSETS the sclera and iris map come from the palettized header the TU includes
+// after the upstream one (<upstream>_indexed.h, written by tools/palettize.py at build time); the
+// upstream RGB565 tables are left unreferenced, so the linker drops them
+#if PME_INDEXED_ASSETS
+#define PME_EYE_STYLE_INDEXED_(scl, scl_palette)                                                        \
+    static_assert(sizeof sclera_index == SCLERA_WIDTH * SCLERA_HEIGHT &&                               \
+                  sizeof iris_index == IRIS_MAP_WIDTH * IRIS_MAP_HEIGHT,                               \
+                  "palettized header does not match the upstream one");                                \
+    static constexpr IndexedAssets indexed{scl, scl_palette, &iris_index[0][0], iris_palette};
+#define PME_EYE_STYLE_SCLERA_ nullptr
+#define PME_EYE_STYLE_IRIS_ nullptr
+#define PME_EYE_STYLE_INDEXED_PTR_ &indexed
+#else
+#define PME_EYE_STYLE_INDEXED_(scl, scl_palette)
+#define PME_EYE_STYLE_SCLERA_ &sclera[0][0]
+#define PME_EYE_STYLE_IRIS_ &iris[0][0]
+#define PME_EYE_STYLE_INDEXED_PTR_ nullptr
+#endif
+
+#define PME_EYE_STYLE_FROM_UPSTREAM(fn, label) PME_EYE_STYLE_FROM_UPSTREAM_PUPIL(fn, label, Circle)
+
+// As above, drawn with a pupil shape other than the circle (a PupilShape enumerator)
+#define PME_EYE_STYLE_FROM_UPSTREAM_PUPIL(fn, label, shape)                                             \
+    PME_EYE_STYLE_CHECK_UPSTREAM_()                                                                    \
+    namespace eyes::styles {                                                                           \
+    const EyeStyle &fn() {                                                                             \
+        PME_EYE_STYLE_INDEXED_(&sclera_index[0][0], sclera_palette)                                    \
+        static constexpr EyeStyle s{label, PME_EYE_STYLE_SCLERA_, SCLERA_WIDTH, SCLERA_HEIGHT,         \
+                                    PME_EYE_STYLE_IRIS_, IRIS_MAP_WIDTH, IRIS_MAP_HEIGHT, IRIS_WIDTH,  \
+                                    &upper[0][0], &lower[0][0], nullptr, PupilShape::shape,            \
+                                    PME_EYE_STYLE_INDEXED_PTR_};                                       \
+        return s;                                                                                      \
+    }                                                                                                  \
+    }
+
+// As above, but the sclera is synthesised from recipe (a ScleraRecipe) at the upstream sclera's
+// size; the upstream sclera table is left unreferenced, so the linker drops it
+#define PME_EYE_STYLE_FROM_UPSTREAM_PROCEDURAL(fn, label, recipe)                                       \
+    PME_EYE_STYLE_CHECK_UPSTREAM_()                                                                    \
+    namespace eyes::styles {                                                                           \
+    const EyeStyle &fn() {                                                                             \
+        PME_EYE_STYLE_INDEXED_(nullptr, nullptr)                                                       \
+        static constexpr ProceduralSclera gen{recipe, SCLERA_WIDTH, SCLERA_HEIGHT};                    \
+        static constexpr EyeStyle s{label, nullptr, SCLERA_WIDTH, SCLERA_HEIGHT,                       \
+                                    PME_EYE_STYLE_IRIS_, IRIS_MAP_WIDTH, IRIS_MAP_HEIGHT, IRIS_WIDTH,  \
+                                    &upper[0][0], &lower[0][0], &gen, PupilShape::Circle,              \
+                                    PME_EYE_STYLE_INDEXED_PTR_};                                       \
+        return s;                                                                                      \
+    }                                                                                                  \
+    }
@@ -0,0 +1,9 @@
+// Uncanny Eyes "dragon" style (MIT License, Adafruit Industries); built with PME_EXTRA_EYE_STYLES.
+// Source: external/Uncanny_Eyes/uncannyEyes/graphics/dragonEye.h
+#include "eye_style_asset.hpp"
+#include "../../../external/Uncanny_Eyes/uncannyEyes/graphics/dragonEye.h"
+#if PME_INDEXED_ASSETS
+#include "dragonEye_indexed.h"
+#endif
+
+PME_EYE_STYLE_FROM_UPSTREAM_PUPIL(dragon, "dragon", Slit)
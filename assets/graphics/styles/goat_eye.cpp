@@ -0,0 +1,9 @@
+// Uncanny Eyes "goat" style (MIT License, Adafruit Industries); built with PME_EXTRA_EYE_STYLES.
+// Source: external/Uncanny_Eyes/uncannyEyes/graphics/goatEye.h
+#include "eye_style_asset.hpp"
+#include "../../../external/Uncanny_Eyes/uncannyEyes/graphics/goatEye.h"
+#if PME_INDEXED_ASSETS
+#include "goatEye_indexed.h"
+#endif
+
+PME_EYE_STYLE_FROM_UPSTREAM(goat, "goat")
@@ -0,0 +1,9 @@
+// Uncanny Eyes "newt" style (MIT License, Adafruit Industries); built with PME_EXTRA_EYE_STYLES.
+// Source: external/Uncanny_Eyes/uncannyEyes/graphics/newtEye.h
+#include "eye_style_asset.hpp"
+#include "../../../external/Uncanny_Eyes/uncannyEyes/graphics/newtEye.h"
+#if PME_INDEXED_ASSETS
+#include "newtEye_indexed.h"
+#endif
+
+PME_EYE_STYLE_FROM_UPSTREAM(newt, "newt")
@@ -0,0 +1,9 @@
+// Uncanny Eyes "terminator" style (MIT License, Adafruit Industries); built with PME_EXTRA_EYE_STYLES.
+// Source: external/Uncanny_Eyes/uncannyEyes/graphics/terminatorEye.h
+#include "eye_style_asset.hpp"
+#include "../../../external/Uncanny_Eyes/uncannyEyes/graphics/terminatorEye.h"
+#if PME_INDEXED_ASSETS
+#include "terminatorEye_indexed.h"
+#endif
+
+PME_EYE_STYLE_FROM_UPSTREAM(terminator, "terminator")
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "panel_geometry.hpp"
+
+namespace eyes {
+
+// Panel fitted to this board (2x WaveShare 1.5" SSD1351, 128x128). Changing this selects the
+// renderer/driver instantiation; add a matching line to the instantiation lists if it is new.
+using ActivePanel = Panel128x128;
+
+} // namespace eyes
@@ -19,6 +19,22 @@ constexpr uint8_t right_cs  = 22; // example
 constexpr uint8_t right_dc  = 26; // example
 constexpr uint8_t right_res = 27; // example
 
+// Control channel (UART1; UART0 carries stdio)
+constexpr uint8_t ctrl_uart_tx = 4;
+constexpr uint8_t ctrl_uart_rx = 5;
+constexpr uint32_t ctrl_uart_baud = 115200;
+
+// Presence sensor (I2C0, AMG8833 thermal array)
+constexpr uint8_t sensor_i2c_sda = 8;
+constexpr uint8_t sensor_i2c_scl = 9;
+constexpr uint32_t sensor_i2c_baud = 400 * 1000;
+
+// Asset pack SD card (SPI1, PME_ASSET_STREAMING)
+constexpr uint8_t sd_sck  = 14;
+constexpr uint8_t sd_mosi = 15;
+constexpr uint8_t sd_miso = 28;
+constexpr uint8_t sd_cs   = 13;
+
 // Audio (MAX98357A)
 constexpr uint8_t i2s_bclk  = 10;
 constexpr uint8_t i2s_lrclk = 11;
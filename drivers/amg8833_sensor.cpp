@@ -0,0 +1,171 @@
+#include "amg8833_sensor.hpp"
+
+#include <cmath>
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+namespace eyes {
+
+Amg8833Sensor* Amg8833Sensor::instance_ = nullptr;
+
+namespace {
+    // Registers
+    constexpr uint8_t kRegPowerControl = 0x00;
+    constexpr uint8_t kRegReset = 0x01;
+    constexpr uint8_t kRegFrameRate = 0x02;
+    constexpr uint32_t kInitTimeoutUs = 2000;
+    // Blob detection, in 0.25 C steps: pixels this far over the frame mean form the blob, and the
+    // hottest pixel must be at least kPresentRise over it for someone to be there
+    constexpr int kBlobRise = 6;     // 1.5 C
+    constexpr int kPresentRise = 8;  // 2 C
+    // Rough distance from blob area: a head fills ~1 pixel at 1.2 m and area falls off as 1/d^2
+    constexpr float kOnePixelDistanceMm = 1200.f;
+}
+
+bool Amg8833Sensor::write_reg(uint8_t reg, uint8_t value) {
+    uint8_t b[2] = {reg, value};
+    return i2c_write_timeout_us(i2c_, addr_, b, 2, false, kInitTimeoutUs) == 2;
+}
+
+bool Amg8833Sensor::init() {
+    if (instance_) return false;
+    i2c_init(i2c_, baud_);
+    gpio_set_function(sda_, GPIO_FUNC_I2C);
+    gpio_set_function(scl_, GPIO_FUNC_I2C);
+    gpio_pull_up(sda_);
+    gpio_pull_up(scl_);
+    // Normal mode, initial reset, 10 fps: a few short blocking writes at boot only (also sets the
+    // controller's target address, which the DMA transactions reuse)
+    if (!write_reg(kRegPowerControl, 0x00) || !write_reg(kRegReset, 0x3F) || !write_reg(kRegFrameRate, 0x00)) {
+        return false;
+    }
+    dma_tx_ = dma_claim_unused_channel(false);
+    dma_rx_ = dma_claim_unused_channel(false);
+    if (dma_tx_ < 0 || dma_rx_ < 0) {
+        if (dma_tx_ >= 0) dma_channel_unclaim(dma_tx_);
+        if (dma_rx_ >= 0) dma_channel_unclaim(dma_rx_);
+        dma_tx_ = dma_rx_ = -1;
+        return false;
+    }
+    // One transaction per frame: write the pixel register address, restart, read 128 bytes, stop
+    cmd_[0] = kRegPixels;
+    for (int i = 0; i < kPixels * 2; ++i) {
+        uint32_t c = I2C_IC_DATA_CMD_CMD_BITS;
+        if (i == 0) c |= I2C_IC_DATA_CMD_RESTART_BITS;
+        if (i == kPixels * 2 - 1) c |= I2C_IC_DATA_CMD_STOP_BITS;
+        cmd_[1 + i] = c;
+    }
+    i2c_hw_t* hw = i2c_get_hw(i2c_);
+    dma_channel_config tx = dma_channel_get_default_config(dma_tx_);
+    channel_config_set_transfer_data_size(&tx, DMA_SIZE_32);
+    channel_config_set_read_increment(&tx, true);
+    channel_config_set_write_increment(&tx, false);
+    channel_config_set_dreq(&tx, i2c_get_dreq(i2c_, true));
+    dma_channel_configure(dma_tx_, &tx, &hw->data_cmd, cmd_, 0, false);
+    dma_channel_config rx = dma_channel_get_default_config(dma_rx_);
+    channel_config_set_transfer_data_size(&rx, DMA_SIZE_8);
+    channel_config_set_read_increment(&rx, false);
+    channel_config_set_write_increment(&rx, true);
+    channel_config_set_dreq(&rx, i2c_get_dreq(i2c_, false));
+    dma_channel_configure(dma_rx_, &rx, raw_, &hw->data_cmd, 0, false);
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS | I2C_IC_DMA_CR_RDMAE_BITS;
+
+    instance_ = this;
+    dma_channel_set_irq1_enabled(dma_rx_, true);
+    irq_add_shared_handler(DMA_IRQ_1, &Amg8833Sensor::dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+    return true;
+}
+
+void Amg8833Sensor::dma_irq_handler() {
+    Amg8833Sensor* s = instance_;
+    if (!s || !dma_channel_get_irq1_status(s->dma_rx_)) return;
+    dma_channel_acknowledge_irq1(s->dma_rx_);
+    s->done_us_ = time_us_32();
+    s->done_.store(true, std::memory_order_release);
+    s->sample_arrived();
+}
+
+void Amg8833Sensor::start_read() {
+    done_.store(false, std::memory_order_relaxed);
+    // RX first so no byte arrives before its channel is armed
+    dma_channel_transfer_to_buffer_now(dma_rx_, raw_, kPixels * 2);
+    dma_channel_transfer_from_buffer_now(dma_tx_, cmd_, kPixels * 2 + 1);
+    busy_ = true;
+}
+
+void Amg8833Sensor::abort_read() {
+    dma_channel_abort(dma_tx_);
+    dma_channel_abort(dma_rx_);
+    done_.store(false, std::memory_order_relaxed);
+    busy_ = false;
+}
+
+void Amg8833Sensor::poll(uint32_t now_us) {
+    if (dma_rx_ < 0) return;
+    if (busy_) {
+        i2c_hw_t* hw = i2c_get_hw(i2c_);
+        if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+            (void)hw->clr_tx_abrt; // read to clear; the controller has flushed its TX FIFO
+            abort_read();
+            ++errors_;
+            next_read_us_ = now_us + kFramePeriodUs;
+        } else if (done_.load(std::memory_order_acquire)) {
+            busy_ = false;
+            locate(raw_, latest_);
+            latest_.stamp_us = done_us_;
+            fresh_ = true;
+        } else if (now_us - started_us_ > kTimeoutUs) {
+            abort_read();
+            ++errors_;
+            next_read_us_ = now_us + kFramePeriodUs;
+        }
+        return;
+    }
+    if ((int32_t)(now_us - next_read_us_) < 0) return;
+    started_us_ = now_us;
+    next_read_us_ = now_us + kFramePeriodUs;
+    start_read();
+}
+
+bool Amg8833Sensor::take(PresenceReading& out) {
+    if (!fresh_) return false;
+    out = latest_;
+    fresh_ = false;
+    return true;
+}
+
+bool Amg8833Sensor::locate(const uint8_t raw[128], PresenceReading& out) {
+    int t[kPixels];
+    int sum = 0, hottest = -4096;
+    for (int i = 0; i < kPixels; ++i) {
+        int v = raw[2 * i] | ((raw[2 * i + 1] & 0x0F) << 8);
+        if (v & 0x800) v -= 0x1000;
+        t[i] = v;
+        sum += v;
+        if (v > hottest) hottest = v;
+    }
+    const int mean = sum / kPixels;
+    out.present = hottest - mean >= kPresentRise;
+    if (!out.present) return false;
+    // Weighted centroid of the blob (weight = rise over the blob threshold; the hottest pixel is
+    // always in it)
+    const int thr = mean + kBlobRise;
+    int w_sum = 0, wx = 0, wy = 0, area = 0;
+    for (int i = 0; i < kPixels; ++i) {
+        int w = t[i] - thr;
+        if (w <= 0) continue;
+        w_sum += w;
+        wx += w * (i & 7);
+        wy += w * (i >> 3);
+        ++area;
+    }
+    out.x = ((float)wx / w_sum - 3.5f) * (1.f / 3.5f);
+    out.y = ((float)wy / w_sum - 3.5f) * (1.f / 3.5f);
+    out.distance_mm = kOnePixelDistanceMm / std::sqrt((float)area);
+    return true;
+}
+
+} // namespace eyes
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "hardware/i2c.h"
+#include "presence_sensor.hpp"
+
+namespace eyes {
+
+// Panasonic AMG8833 (Grid-EYE) 8x8 thermopile array as a presence sensor. A frame read is one I2C
+// transaction driven entirely by DMA: one channel feeds the controller's command FIFO (register
+// address, then 128 read commands), the other drains the 128 pixel bytes. The RX channel's
+// completion IRQ stamps the sample; poll() locates the warmest blob in it and starts the next read.
+class Amg8833Sensor : public PresenceSensor {
+public:
+    static constexpr uint8_t kAddress = 0x69;       // AD_SELECT high (0x68 when low)
+    static constexpr uint32_t kFramePeriodUs = 100000; // sensor runs at 10 fps
+    static constexpr uint32_t kTimeoutUs = 20000;      // a 400 kHz frame read takes ~3.5 ms
+
+    Amg8833Sensor(i2c_inst_t* i2c, uint32_t baud, uint8_t pin_sda, uint8_t pin_scl, uint8_t address = kAddress)
+        : i2c_(i2c), baud_(baud), sda_(pin_sda), scl_(pin_scl), addr_(address) {}
+
+    bool init() override;
+    void poll(uint32_t now_us) override;
+    bool take(PresenceReading& out) override;
+    // Transfers aborted by the controller (NAK) or timed out
+    uint32_t errors() const override { return errors_; }
+
+    // Warmest blob of an 8x8 frame (raw register bytes, 12-bit two's complement, 0.25 C/LSB):
+    // centroid of the pixels well above the frame mean; distance is a rough guess from its area.
+    static bool locate(const uint8_t raw[128], PresenceReading& out);
+
+private:
+    static constexpr int kPixels = 64;
+    static constexpr uint8_t kRegPixels = 0x80;
+
+    bool write_reg(uint8_t reg, uint8_t value);
+    void start_read();
+    void abort_read();
+    static void dma_irq_handler();
+
+    i2c_inst_t* i2c_;
+    uint32_t baud_;
+    uint8_t sda_;
+    uint8_t scl_;
+    uint8_t addr_;
+    int dma_tx_ = -1;
+    int dma_rx_ = -1;
+    bool busy_ = false;
+    uint32_t started_us_ = 0;
+    uint32_t next_read_us_ = 0;
+    uint32_t errors_ = 0;
+    std::atomic<bool> done_{false};     // set by the DMA IRQ
+    uint32_t done_us_ = 0;              // written by the IRQ before done_
+    uint32_t cmd_[kPixels * 2 + 1]{};   // data_cmd words: register address, then read commands
+    uint8_t raw_[kPixels * 2]{};
+    PresenceReading latest_{};
+    bool fresh_ = false;
+
+    static Amg8833Sensor* instance_;
+};
+
+} // namespace eyes
@@ -0,0 +1,220 @@
+#include "frame_capture.hpp"
+
+#include <cstring>
+#include "pico/stdlib.h"
+#include "pico/stdio.h"
+#include "pico/stdio_uart.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+namespace eyes {
+
+FrameCapture* FrameCapture::instance_ = nullptr;
+
+namespace {
+    constexpr uint8_t kSync0 = 0xA5;
+    constexpr uint8_t kSync1 = 0xC3;
+    constexpr uint8_t kFlagKey = 0x01;
+
+    // CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF; Python: binascii.crc_hqx(data, 0xFFFF)), a nibble at a time
+    constexpr uint16_t kCrcNibble[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+
+    uint16_t crc16(const uint8_t* p, size_t n) {
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 0; i < n; ++i) {
+            crc = (uint16_t)((crc << 4) ^ kCrcNibble[(crc >> 12) ^ (p[i] >> 4)]);
+            crc = (uint16_t)((crc << 4) ^ kCrcNibble[(crc >> 12) ^ (p[i] & 0x0F)]);
+        }
+        return crc;
+    }
+}
+
+bool FrameCapture::init() {
+    if (instance_) return false;
+    dma_ = dma_claim_unused_channel(false);
+    if (dma_ < 0) return false;
+    instance_ = this;
+    // Flush whatever stdio has queued, then take the UART: text goes through write_text from here on
+    stdio_flush();
+    stdio_set_driver_enabled(&stdio_uart, false);
+    uart_set_baudrate(uart_, baud_);
+    dma_channel_config c = dma_channel_get_default_config(dma_);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, uart_get_dreq(uart_, true));
+    dma_channel_configure(dma_, &c, &uart_get_hw(uart_)->dr, nullptr, 0, false);
+    dma_channel_set_irq1_enabled(dma_, true);
+    irq_add_shared_handler(DMA_IRQ_1, &FrameCapture::dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+    stdio_.out_chars = &FrameCapture::stdio_out_chars;
+    stdio_.crlf_enabled = false;
+    stdio_set_driver_enabled(&stdio_, true);
+    return true;
+}
+
+size_t FrameCapture::encode_row(const uint16_t* src, uint16_t* ref, int w, bool key, uint8_t* out) {
+    size_t n = 0;
+    int i = 0;
+    while (i < w) {
+        int run = 0;
+        if (!key) {
+            while (i + run < w && run < 128 && src[i + run] == ref[i + run]) ++run;
+        }
+        if (run) {
+            out[n++] = (uint8_t)(run - 1);
+            i += run;
+            continue;
+        }
+        // Literal until the next unchanged word: a lone one costs as much as sending it
+        size_t tok = n++;
+        int lit = 0;
+        while (i < w && lit < 128 && (key || src[i] != ref[i])) {
+            uint16_t v = key ? src[i] : (uint16_t)(src[i] ^ ref[i]);
+            out[n++] = (uint8_t)v;
+            out[n++] = (uint8_t)(v >> 8);
+            ref[i] = src[i];
+            ++i;
+            ++lit;
+        }
+        out[tok] = (uint8_t)(0x80 | (lit - 1));
+    }
+    return n;
+}
+
+int FrameCapture::acquire() {
+    uint32_t irq = save_and_disable_interrupts();
+    int b = state_[0] == kFree ? 0 : (state_[1] == kFree ? 1 : -1);
+    if (b >= 0) state_[b] = kFilling;
+    restore_interrupts(irq);
+    return b;
+}
+
+void FrameCapture::submit(int b, size_t len) {
+    uint8_t* p = buf_[b];
+    p[0] = kSync0;
+    p[1] = kSync1;
+    p[11] = (uint8_t)len;
+    p[12] = (uint8_t)(len >> 8);
+    uint16_t crc = crc16(p + 2, kHeaderBytes - 2 + len);
+    p[kHeaderBytes + len] = (uint8_t)crc;
+    p[kHeaderBytes + len + 1] = (uint8_t)(crc >> 8);
+    uint32_t irq = save_and_disable_interrupts();
+    state_[b] = kReady;
+    len_[b] = kHeaderBytes + len + 2;
+    start_next();
+    restore_interrupts(irq);
+}
+
+void FrameCapture::start_next() {
+    if (sending_ >= 0) return;
+    for (int b = 0; b < 2; ++b) {
+        if (state_[b] != kReady) continue;
+        state_[b] = kSending;
+        sending_ = (int8_t)b;
+        dma_channel_transfer_from_buffer_now(dma_, buf_[b], (uint32_t)len_[b]);
+        return;
+    }
+}
+
+void FrameCapture::dma_irq_handler() {
+    FrameCapture* self = instance_;
+    if (!self || !dma_channel_get_irq1_status(self->dma_)) return;
+    dma_channel_acknowledge_irq1(self->dma_);
+    if (self->sending_ >= 0) self->state_[self->sending_] = kFree;
+    self->sending_ = -1;
+    self->start_next();
+}
+
+bool FrameCapture::begin(uint8_t display, const Rect& area) {
+    if (display != display_ || area.w == 0 || area.h == 0) return false;
+    area_ = area;
+    if (area_.x + area_.w > kMaxW) area_.w = (uint16_t)(kMaxW - area_.x);
+    if (area_.y + area_.h > kMaxH) area_.h = (uint16_t)(kMaxH - area_.y);
+    y_ = area_.y;
+    band_buf_ = -1;
+    band_rows_ = 0;
+    ++frame_;
+    active_ = true;
+    return true;
+}
+
+void FrameCapture::open_band(int band) {
+    band_buf_ = acquire();
+    band_rows_ = 0;
+    if (band_buf_ < 0) {
+        ++dropped_;
+        ++dropped_unreported_;
+        return;
+    }
+    const uint32_t now = time_us_32();
+    band_key_ = !keyed_[band] || now - key_us_[band] >= kKeyIntervalUs;
+    if (band_key_) {
+        keyed_[band] = true;
+        key_us_[band] = now;
+    }
+    uint8_t* p = buf_[band_buf_];
+    p[2] = kTypeBand;
+    p[3] = display_;
+    p[4] = band_key_ ? kFlagKey : 0;
+    p[5] = (uint8_t)frame_;
+    p[6] = (uint8_t)(frame_ >> 8);
+    p[7] = (uint8_t)area_.x;
+    p[8] = (uint8_t)y_;
+    p[9] = (uint8_t)area_.w;
+    p[13] = (uint8_t)(dropped_unreported_ > 255 ? 255 : dropped_unreported_);
+    dropped_unreported_ = 0;
+    band_pos_ = kHeaderBytes;
+}
+
+void FrameCapture::close_band() {
+    if (band_buf_ < 0) return;
+    buf_[band_buf_][10] = (uint8_t)band_rows_;
+    submit(band_buf_, band_pos_ - kHeaderBytes);
+    band_buf_ = -1;
+}
+
+void FrameCapture::row(const uint16_t* src) {
+    if (!active_ || y_ >= area_.y + area_.h) return;
+    if (y_ == area_.y || y_ % kBandRows == 0) {
+        close_band();
+        open_band(y_ / kBandRows);
+    }
+    if (band_buf_ >= 0) {
+        band_pos_ += encode_row(src, &ref_[y_][area_.x], area_.w, band_key_, buf_[band_buf_] + band_pos_);
+        ++band_rows_;
+    }
+    ++y_;
+}
+
+void FrameCapture::end() {
+    if (!active_) return;
+    close_band();
+    active_ = false;
+}
+
+void FrameCapture::write_text(const char* s, int len) {
+    // Text is rare (status lines) and must not be lost, so it waits for a buffer
+    constexpr int kChunk = (int)(kPacketMax - kHeaderBytes - 2);
+    while (len > 0) {
+        int b;
+        while ((b = acquire()) < 0) tight_loop_contents();
+        int n = len < kChunk ? len : kChunk;
+        uint8_t* p = buf_[b];
+        std::memset(p + 2, 0, kHeaderBytes - 2);
+        p[2] = kTypeText;
+        std::memcpy(p + kHeaderBytes, s, (size_t)n);
+        submit(b, (size_t)n);
+        s += n;
+        len -= n;
+    }
+}
+
+void FrameCapture::stdio_out_chars(const char* buf, int len) {
+    if (instance_) instance_->write_text(buf, len);
+}
+
+} // namespace eyes
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "hardware/uart.h"
+#include "pico/stdio/driver.h"
+#include "display.hpp"
+
+namespace eyes {
+
+// Streams the pixels one display is blitted over the stdio UART, for debugging rendering on the
+// real prop (format: docs/capture.md, decoder: tools/capture_decode.py). The display driver feeds
+// each blit row by row while its own DMA streams to the panel. Every band of kBandRows rows is XOR'd
+// against what was last sent for those rows and run-length coded into one of two packet buffers; a
+// DMA channel drains the other into the UART. A band that finds both buffers busy is skipped and
+// keeps its old reference, so the next frame that gets through carries the accumulated change;
+// rendering never waits on the link. While capture owns the UART, stdio text goes out as packets too.
+class FrameCapture {
+public:
+    static constexpr int kMaxW = 128;
+    static constexpr int kMaxH = 128;
+    static constexpr int kBandRows = 16;
+    static constexpr int kBands = kMaxH / kBandRows;
+    static constexpr uint32_t kKeyIntervalUs = 2000000; // each band is re-sent whole this often
+    static constexpr size_t kHeaderBytes = 14;
+    // Per row at worst one literal token per 128 words plus two bytes per word (see encode_row)
+    static constexpr size_t kPacketMax = kHeaderBytes + kBandRows * (1 + kMaxW * 2) + 2;
+
+    FrameCapture(uart_inst_t* uart, uint32_t baud) : uart_(uart), baud_(baud) {}
+
+    // Takes over the UART from stdio (raised to baud) and claims a DMA channel
+    bool init();
+    // Display id to capture (ids are given to the drivers with Ssd1351Display::set_capture)
+    void set_display(uint8_t id) { display_ = id; }
+
+    // Driver side: begin() returns false when this display is not being captured; otherwise every
+    // row of area follows, top to bottom, then end().
+    bool begin(uint8_t display, const Rect& area);
+    void row(const uint16_t* src);
+    void end();
+
+    // Bands skipped because the link was still busy with earlier packets
+    uint32_t dropped_bands() const { return dropped_; }
+
+    // XOR (against ref, or against 0 for a key row) and run-length code w pixels into out; ref is
+    // updated to src. Tokens: 0x00-0x7F = 1-128 unchanged words, 0x80-0xFF = 1-128 literal words
+    // follow (little-endian). Returns bytes written, at most 2 * w + ceil(w / 128).
+    static size_t encode_row(const uint16_t* src, uint16_t* ref, int w, bool key, uint8_t* out);
+
+private:
+    enum : uint8_t { kFree, kFilling, kReady, kSending };
+    enum : uint8_t { kTypeBand = 1, kTypeText = 2 };
+
+    int acquire();                  // free buffer index (now filling), or -1
+    void submit(int b, size_t len); // seal the packet in buffer b and queue it
+    void open_band(int band);
+    void close_band();
+    void start_next();              // with interrupts off: send the ready buffer if the link is idle
+    void write_text(const char* s, int len);
+    static void dma_irq_handler();
+    static void stdio_out_chars(const char* buf, int len);
+
+    uart_inst_t* uart_;
+    uint32_t baud_;
+    int dma_ = -1;
+    uint8_t display_ = 0;
+    uint16_t frame_ = 0;
+    // Blit in progress
+    bool active_ = false;
+    Rect area_{};
+    int y_ = 0;
+    int band_buf_ = -1;             // buffer of the open band, -1 = none (skipped)
+    bool band_key_ = false;
+    size_t band_pos_ = 0;
+    int band_rows_ = 0;
+    uint32_t key_us_[kBands]{};
+    bool keyed_[kBands]{};
+    uint32_t dropped_ = 0;
+    uint32_t dropped_unreported_ = 0;   // carried in the next band's header
+    // Packet buffers: state changes under disabled interrupts (the DMA IRQ frees them)
+    uint8_t buf_[2][kPacketMax];
+    volatile uint8_t state_[2] = {kFree, kFree};
+    size_t len_[2]{};
+    volatile int8_t sending_ = -1;
+    uint16_t ref_[kMaxH][kMaxW]{};  // what the decoder holds for every pixel
+    stdio_driver_t stdio_{};
+
+    static FrameCapture* instance_;
+};
+
+} // namespace eyes
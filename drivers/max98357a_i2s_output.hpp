@@ -15,11 +15,13 @@ public:
     bool start() override;
     void stop() override;
     size_t write_samples(const int16_t* samples, size_t count) override;
+    uint64_t samples_played() const override { return samples_played_; }
 
 private:
     uint8_t bclk_;
     uint8_t lrclk_;
     uint8_t din_;
+    uint64_t samples_played_ = 0;
 };
 
 } // namespace eyes
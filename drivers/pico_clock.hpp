@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "scheduler.hpp"
+
+namespace eyes {
+
+// Scheduler clock on the 64-bit hardware timer. Idle waits sleep in WFE until the next release (a
+// pico_time alarm raises the event) or until an IRQ wakes a task (signal() sends the event).
+class PicoClock : public Clock {
+public:
+    uint64_t now_us() override { return time_us_64(); }
+    void wait_until(uint64_t t_us) override { best_effort_wfe_or_timeout(from_us_since_boot(t_us)); }
+    void signal() override { __sev(); }
+};
+
+} // namespace eyes
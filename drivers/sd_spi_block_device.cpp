@@ -0,0 +1,234 @@
+#include "sd_spi_block_device.hpp"
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+namespace eyes {
+
+SdSpiBlockDevice* SdSpiBlockDevice::instance_ = nullptr;
+
+namespace {
+    // Commands (SPI mode)
+    constexpr uint8_t kGoIdle = 0;
+    constexpr uint8_t kSendIfCond = 8;
+    constexpr uint8_t kSendCsd = 9;
+    constexpr uint8_t kStopTransmission = 12;
+    constexpr uint8_t kSetBlockLen = 16;
+    constexpr uint8_t kReadMultiple = 18;
+    constexpr uint8_t kAppCmd = 55;
+    constexpr uint8_t kReadOcr = 58;
+    constexpr uint8_t kSdSendOpCond = 41;   // after kAppCmd
+    // R1 bits and tokens
+    constexpr uint8_t kR1Idle = 0x01;
+    constexpr uint8_t kR1IllegalCommand = 0x04;
+    constexpr uint8_t kStartBlock = 0xFE;
+    constexpr uint32_t kCommandTimeoutUs = 50000;
+    // Source of the 0xFF bytes the TX channel clocks out during a data block
+    const uint8_t kFill = 0xFF;
+}
+
+uint8_t SdSpiBlockDevice::xfer(uint8_t b) {
+    uint8_t r = 0xFF;
+    spi_write_read_blocking(spi_, &b, &r, 1);
+    return r;
+}
+
+bool SdSpiBlockDevice::wait_ready(uint32_t timeout_us) {
+    const uint32_t t0 = time_us_32();
+    while (xfer(0xFF) != 0xFF) {
+        if (time_us_32() - t0 > timeout_us) return false;
+    }
+    return true;
+}
+
+uint8_t SdSpiBlockDevice::command(uint8_t cmd, uint32_t arg) {
+    if (!wait_ready(kCommandTimeoutUs)) return 0xFF;
+    // Only CMD0 and CMD8 are CRC-checked in SPI mode
+    const uint8_t crc = cmd == kGoIdle ? 0x95 : cmd == kSendIfCond ? 0x87 : 0x01;
+    const uint8_t frame[6] = {(uint8_t)(0x40 | cmd), (uint8_t)(arg >> 24), (uint8_t)(arg >> 16),
+                              (uint8_t)(arg >> 8), (uint8_t)arg, crc};
+    spi_write_blocking(spi_, frame, sizeof frame);
+    if (cmd == kStopTransmission) xfer(0xFF); // stuff byte
+    // R1 arrives within 8 bytes (top bit clear)
+    uint8_t r1 = 0xFF;
+    for (int i = 0; i < 8 && (r1 & 0x80); ++i) r1 = xfer(0xFF);
+    return r1;
+}
+
+bool SdSpiBlockDevice::read_register(uint8_t cmd, uint8_t* out, int len) {
+    if (command(cmd, 0) != 0) return false;
+    const uint32_t t0 = time_us_32();
+    uint8_t t;
+    while ((t = xfer(0xFF)) == 0xFF) {
+        if (time_us_32() - t0 > kReadTimeoutUs) return false;
+    }
+    if (t != kStartBlock) return false;
+    for (int i = 0; i < len; ++i) out[i] = xfer(0xFF);
+    xfer(0xFF); xfer(0xFF); // CRC16
+    return true;
+}
+
+bool SdSpiBlockDevice::init() {
+    if (instance_) return false;
+    spi_init(spi_, kInitHz);
+    spi_set_format(spi_, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    gpio_set_function(sck_, GPIO_FUNC_SPI);
+    gpio_set_function(mosi_, GPIO_FUNC_SPI);
+    gpio_set_function(miso_, GPIO_FUNC_SPI);
+    gpio_pull_up(miso_);
+    gpio_init(cs_);
+    gpio_set_dir(cs_, GPIO_OUT);
+    gpio_put(cs_, 1);
+    // 74+ clocks with CS high put the card in native mode, ready for CMD0
+    for (int i = 0; i < 10; ++i) xfer(0xFF);
+    // The card is alone on this bus, so CS stays asserted from here on
+    gpio_put(cs_, 0);
+    uint8_t r1 = 0xFF;
+    for (int i = 0; i < 10 && r1 != kR1Idle; ++i) r1 = command(kGoIdle, 0);
+    if (r1 != kR1Idle) return false;
+    // CMD8 separates v2 cards (echo the check pattern) from v1 cards (illegal command)
+    bool v2 = false;
+    r1 = command(kSendIfCond, 0x1AA);
+    if (r1 == kR1Idle) {
+        uint8_t r7[4];
+        for (uint8_t& b : r7) b = xfer(0xFF);
+        if (r7[3] != 0xAA) return false;
+        v2 = true;
+    } else if (!(r1 & kR1IllegalCommand)) {
+        return false;
+    }
+    // Power up (ACMD41, announcing high capacity support to v2 cards)
+    const uint32_t t0 = time_us_32();
+    do {
+        if (time_us_32() - t0 > kInitTimeoutUs) return false;
+        command(kAppCmd, 0);
+        r1 = command(kSdSendOpCond, v2 ? 0x40000000u : 0);
+    } while (r1 == kR1Idle);
+    if (r1 != 0) return false;
+    if (v2) {
+        if (command(kReadOcr, 0) != 0) return false;
+        uint8_t ocr[4];
+        for (uint8_t& b : ocr) b = xfer(0xFF);
+        block_addressed_ = (ocr[0] & 0x40) != 0; // CCS
+    }
+    if (!block_addressed_ && command(kSetBlockLen, kBlockSize) != 0) return false;
+    // Capacity from the CSD
+    uint8_t csd[16];
+    if (!read_register(kSendCsd, csd, sizeof csd)) return false;
+    if ((csd[0] >> 6) == 1) {
+        const uint32_t c_size = ((uint32_t)(csd[7] & 0x3F) << 16) | (csd[8] << 8) | csd[9];
+        blocks_ = (c_size + 1) * 1024;
+    } else {
+        const uint32_t c_size = ((uint32_t)(csd[6] & 0x03) << 10) | (csd[7] << 2) | (csd[8] >> 6);
+        const int mult = ((csd[9] & 0x03) << 1) | (csd[10] >> 7);
+        const int read_bl_len = csd[5] & 0x0F;
+        blocks_ = (c_size + 1) << (mult + 2 + read_bl_len - 9);
+    }
+    hz_ = spi_set_baudrate(spi_, hz_);
+
+    dma_tx_ = dma_claim_unused_channel(false);
+    dma_rx_ = dma_claim_unused_channel(false);
+    if (dma_tx_ < 0 || dma_rx_ < 0) {
+        if (dma_tx_ >= 0) dma_channel_unclaim(dma_tx_);
+        if (dma_rx_ >= 0) dma_channel_unclaim(dma_rx_);
+        dma_tx_ = dma_rx_ = -1;
+        return false;
+    }
+    spi_hw_t* hw = spi_get_hw(spi_);
+    dma_channel_config tx = dma_channel_get_default_config(dma_tx_);
+    channel_config_set_transfer_data_size(&tx, DMA_SIZE_8);
+    channel_config_set_read_increment(&tx, false);
+    channel_config_set_write_increment(&tx, false);
+    channel_config_set_dreq(&tx, spi_get_dreq(spi_, true));
+    dma_channel_configure(dma_tx_, &tx, &hw->dr, &kFill, 0, false);
+    dma_channel_config rx = dma_channel_get_default_config(dma_rx_);
+    channel_config_set_transfer_data_size(&rx, DMA_SIZE_8);
+    channel_config_set_read_increment(&rx, false);
+    channel_config_set_write_increment(&rx, true);
+    channel_config_set_dreq(&rx, spi_get_dreq(spi_, false));
+    dma_channel_configure(dma_rx_, &rx, nullptr, &hw->dr, 0, false);
+
+    instance_ = this;
+    dma_channel_set_irq1_enabled(dma_rx_, true);
+    irq_add_shared_handler(DMA_IRQ_1, &SdSpiBlockDevice::dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+    return true;
+}
+
+void SdSpiBlockDevice::dma_irq_handler() {
+    SdSpiBlockDevice* d = instance_;
+    if (!d || !dma_channel_get_irq1_status(d->dma_rx_)) return;
+    dma_channel_acknowledge_irq1(d->dma_rx_);
+    d->data_done_.store(true, std::memory_order_release);
+    d->transfer_event();
+}
+
+bool SdSpiBlockDevice::stop_stream() {
+    streaming_ = false;
+    // The card may be mid-block; CMD12 ends the stream, then it signals busy until it is done
+    command(kStopTransmission, 0);
+    return wait_ready(kCommandTimeoutUs);
+}
+
+void SdSpiBlockDevice::fail() {
+    dma_channel_abort(dma_tx_);
+    dma_channel_abort(dma_rx_);
+    data_done_.store(false, std::memory_order_relaxed);
+    if (streaming_) stop_stream();
+    state_ = State::Idle;
+    ok_ = false;
+    ++errors_;
+}
+
+bool SdSpiBlockDevice::start_read(uint32_t lba, uint32_t count, uint8_t* dst) {
+    if (dma_rx_ < 0 || state_ != State::Idle || count == 0 || lba >= blocks_ || count > blocks_ - lba) return false;
+    if (streaming_ && stream_lba_ != lba && !stop_stream()) { ++errors_; ok_ = false; return true; }
+    if (!streaming_) {
+        if (command(kReadMultiple, block_addressed_ ? lba : lba * kBlockSize) != 0) {
+            ++errors_;
+            ok_ = false;
+            return true; // over at once (failed)
+        }
+        streaming_ = true;
+        stream_lba_ = lba;
+    }
+    remaining_ = count;
+    dst_ = dst;
+    token_since_us_ = time_us_32();
+    state_ = State::Token;
+    return true;
+}
+
+void SdSpiBlockDevice::poll() {
+    if (state_ == State::Data) {
+        if (!data_done_.load(std::memory_order_acquire)) return;
+        xfer(0xFF); xfer(0xFF); // CRC16 (not checked in SPI mode)
+        dst_ += kBlockSize;
+        ++stream_lba_;
+        if (!--remaining_) {
+            state_ = State::Idle;
+            ok_ = true;
+            return;
+        }
+        // Within a stream the next block is often ready already: look for its token right away
+        token_since_us_ = time_us_32();
+        state_ = State::Token;
+    }
+    if (state_ != State::Token) return;
+    for (int i = 0; i < kTokenPollBytes; ++i) {
+        const uint8_t t = xfer(0xFF);
+        if (t == 0xFF) continue;
+        if (t != kStartBlock) { fail(); return; } // data error token
+        // RX first so no byte arrives before its channel is armed
+        data_done_.store(false, std::memory_order_relaxed);
+        dma_channel_transfer_to_buffer_now(dma_rx_, dst_, kBlockSize);
+        dma_channel_transfer_from_buffer_now(dma_tx_, &kFill, kBlockSize);
+        state_ = State::Data;
+        return;
+    }
+    if (time_us_32() - token_since_us_ > kReadTimeoutUs) fail();
+}
+
+} // namespace eyes
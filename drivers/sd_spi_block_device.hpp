@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "hardware/spi.h"
+#include "block_device.hpp"
+
+namespace eyes {
+
+// SD/SDHC card in SPI mode on its own SPI controller (the panels keep SPI0). The card is brought up
+// with short blocking commands at boot; after that every read is a CMD18 multi-block stream that is
+// left open, so a read that continues where the last one ended costs no command at all. Each data
+// block moves by DMA (one channel clocks out 0xFF, the other drains the data), and the RX channel's
+// completion IRQ raises transfer_event(); poll() waits for start tokens a few bytes at a time and
+// never blocks on the card except to stop a stream for a non-sequential read (CMD12).
+class SdSpiBlockDevice : public BlockDevice {
+public:
+    static constexpr uint32_t kInitHz = 400 * 1000;
+    static constexpr uint32_t kDataHz = 25 * 1000 * 1000;   // default speed mode limit
+    static constexpr uint32_t kReadTimeoutUs = 100000;      // start token of a block
+    static constexpr uint32_t kInitTimeoutUs = 1000000;     // ACMD41 power-up
+
+    SdSpiBlockDevice(spi_inst_t* spi, uint8_t pin_sck, uint8_t pin_mosi, uint8_t pin_miso, uint8_t pin_cs,
+                     uint32_t hz = kDataHz)
+        : spi_(spi), sck_(pin_sck), mosi_(pin_mosi), miso_(pin_miso), cs_(pin_cs), hz_(hz) {}
+
+    bool init() override;
+    uint32_t block_count() const override { return blocks_; }
+    bool start_read(uint32_t lba, uint32_t count, uint8_t* dst) override;
+    void poll() override;
+    bool busy() const override { return state_ != State::Idle; }
+    bool ok() const override { return ok_; }
+    uint32_t errors() const override { return errors_; }
+
+private:
+    enum class State : uint8_t { Idle, Token, Data };
+    // Start tokens are polled this many bytes per poll() before returning (~3 us at 25 MHz)
+    static constexpr int kTokenPollBytes = 8;
+
+    uint8_t xfer(uint8_t b);
+    bool wait_ready(uint32_t timeout_us);
+    uint8_t command(uint8_t cmd, uint32_t arg);
+    bool read_register(uint8_t cmd, uint8_t* out, int len);
+    bool stop_stream();
+    void fail();
+    static void dma_irq_handler();
+
+    spi_inst_t* spi_;
+    uint8_t sck_, mosi_, miso_, cs_;
+    uint32_t hz_;
+    uint32_t blocks_ = 0;
+    bool block_addressed_ = false;   // SDHC/SDXC: commands take block numbers, not byte offsets
+    int dma_tx_ = -1;
+    int dma_rx_ = -1;
+    State state_ = State::Idle;
+    bool ok_ = false;
+    uint32_t errors_ = 0;
+    // Open CMD18 stream and the block it delivers next
+    bool streaming_ = false;
+    uint32_t stream_lba_ = 0;
+    // Read in progress
+    uint32_t remaining_ = 0;
+    uint8_t* dst_ = nullptr;
+    uint32_t token_since_us_ = 0;
+    std::atomic<bool> data_done_{false};   // set by the DMA IRQ
+
+    static SdSpiBlockDevice* instance_;
+};
+
+} // namespace eyes
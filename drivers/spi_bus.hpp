@@ -1,19 +1,23 @@
 #pragma once
 
 #include <cstdint>
-#include "hardware/spi.h"
+#include "hal.hpp"
 
 namespace eyes {
 
 class SpiBus {
 public:
-    explicit SpiBus(spi_inst_t* inst, uint32_t hz) : inst_(inst), hz_(hz) {}
-    bool init() { spi_init(inst_, hz_); return true; }
-    spi_inst_t* inst() const { return inst_; }
+    explicit SpiBus(hal::Spi* inst, uint32_t hz) : inst_(inst), hz_(hz) {}
+    bool init() { hz_ = hal::spi_begin(inst_, hz_); return true; }
+    hal::Spi* inst() const { return inst_; }
     // Attempt to change SPI frequency at runtime; returns actual set rate
-    uint32_t set_frequency(uint32_t hz) { hz_ = spi_set_baudrate(inst_, hz); return hz_; }
+    uint32_t set_frequency(uint32_t hz) { hz_ = hal::spi_baudrate(inst_, hz); return hz_; }
+    uint32_t frequency() const { return hz_; }
+    // Bits per SPI frame (8 for commands, 16 for RGB565 pixel streams). Waits for the bus to go idle
+    // first: changing the format mid-frame corrupts the transfer.
+    void set_frame_bits(uint32_t bits) { hal::spi_frame_bits(inst_, bits); }
 private:
-    spi_inst_t* inst_;
+    hal::Spi* inst_;
     uint32_t hz_;
 };
 
@@ -1,32 +1,52 @@
 #include "ssd1351_display.hpp"
+#if !PME_HOST_BUILD
+#include "frame_capture.hpp"
+#endif
 
-#include "pico/stdlib.h"
-#include "hardware/spi.h"
-#include "hardware/gpio.h"
-#include "hardware/dma.h"
+#include "hal.hpp"
+#include "pico2_panel.hpp"
+#include "pixel_kernels.hpp"
+#include "mem_placement.hpp"
 
 namespace eyes {
 
-bool Ssd1351Display::init() {
-    // Init GPIOs
-    gpio_init(cs_);
-    gpio_set_dir(cs_, GPIO_OUT);
-    gpio_put(cs_, 1);
+namespace {
+    // Shared by every panel: blits are serialised on the SPI bus. SCRATCH_X keeps the DMA reads off the
+    // striped SRAM banks the renderer is working in (see mem_placement.hpp).
+    constexpr size_t kDmaLineMax = 128; // SSD1351 GDDRAM width
+    PME_DMA_RAM uint16_t g_dma_line[2][kDmaLineMax]; // color-converted lines (16-bit SPI frames)
+}
 
-    gpio_init(dc_);
-    gpio_set_dir(dc_, GPIO_OUT);
-    gpio_put(dc_, 0);
+template <class Panel>
+bool Ssd1351Display<Panel>::init() {
+    begin_reset();
+    hal::sleep_ms(kResetPulseMs);
+    end_reset();
+    hal::sleep_ms(kResetPulseMs);
+    if (!configure()) return false;
+    hal::sleep_ms(kPowerOnSettleMs);
+    return true;
+}
 
-    gpio_init(res_);
-    gpio_set_dir(res_, GPIO_OUT);
-    gpio_put(res_, 1);
+template <class Panel>
+void Ssd1351Display<Panel>::begin_reset() {
+    // Init GPIOs
+    hal::pin_output(cs_, 1);
+    hal::pin_output(dc_, 0);
+    hal::pin_output(res_, 1);
 
     // Ensure SPI is initialized
     bus_.init();
 
-    // Hardware reset
-    hw_reset();
+    // Hardware reset (released by end_reset)
+    hal::pin_put(res_, 0);
+}
+
+template <class Panel>
+void Ssd1351Display<Panel>::end_reset() { hal::pin_put(res_, 1); }
 
+template <class Panel>
+bool Ssd1351Display<Panel>::configure() {
     cs_select();
     // Unlock commands
     write_cmd(CMD_COMMANDLOCK); write_data((const uint8_t*)"\x12", 1);
@@ -68,126 +88,176 @@ bool Ssd1351Display::init() {
     write_cmd(CMD_DISPLAYON);
     cs_deselect();
 
-    sleep_ms(20);
-
     // Allocate TX DMA channel (optional)
+    // 16-bit transfers (one pixel per SPI frame) paced by the SPI TX DREQ
     if (use_dma_ && dma_tx_chan_ < 0) {
-        int ch = dma_claim_unused_channel(false);
-        if (ch >= 0) {
-            dma_tx_chan_ = ch;
-            // Configure channel for 8-bit transfers paced by SPI TX DREQ
-            dma_channel_config c = dma_channel_get_default_config(ch);
-            channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
-            channel_config_set_dreq(&c, spi_get_dreq(bus_.inst(), true));
-            dma_channel_configure(ch, &c,
-                &spi_get_hw(bus_.inst())->dr, // dst: SPI data register
-                nullptr,                      // src set per transfer
-                0,                            // count set per transfer
-                false);
-        } else {
-            use_dma_ = false; // fallback
-        }
+        dma_tx_chan_ = hal::spi_tx_dma(bus_.inst());
+        if (dma_tx_chan_ < 0) use_dma_ = false; // fallback
     }
     return true;
 }
 
-void Ssd1351Display::fill(uint16_t color) {
+template <class Panel>
+void Ssd1351Display<Panel>::fill(uint16_t color) {
     Rect r{0, 0, w_, h_};
     // Prepare a small buffer and stream it repeatedly to avoid large stack
     const size_t chunk_pixels = 64; // multiple of 2 not required, RGB565 2 bytes each
     uint16_t buf[chunk_pixels];
-    for (size_t i = 0; i < chunk_pixels; ++i) buf[i] = color;
+    px::fill(buf, color, chunk_pixels);
 
     cs_select();
     set_window(0, 0, w_, h_);
     write_cmd(CMD_WRITERAM);
+    dc_data();
+    bus_.set_frame_bits(16);
     size_t total = static_cast<size_t>(w_) * static_cast<size_t>(h_);
     while (total > 0) {
         size_t now = total > chunk_pixels ? chunk_pixels : total;
         write_data_u16(buf, now);
         total -= now;
     }
+    bus_.set_frame_bits(8);
     cs_deselect();
 }
 
-void Ssd1351Display::blit(uint16_t const* pixels, const Rect& area) {
-    if (!pixels || area.w == 0 || area.h == 0) return;
+template <class Panel>
+void Ssd1351Display<Panel>::blit(uint16_t const* pixels, const Rect& area) {
+    if (!pixels) return;
+    stream([&](int y) { return pixels + (size_t)y * area.w; }, area);
+}
+
+template <class Panel>
+void Ssd1351Display<Panel>::blit_rows(uint16_t const* const* rows, const Rect& area) {
+    if (!rows) return;
+    stream([&](int y) { return rows[y]; }, area);
+}
+
+template <class Panel>
+template <class RowAt>
+void Ssd1351Display<Panel>::stream(RowAt row_at, const Rect& area) {
+    if (area.w == 0 || area.h == 0) return;
     cs_select();
     set_window(area.x, area.y, area.w, area.h);
     write_cmd(CMD_WRITERAM);
-    size_t count = (size_t)area.w * area.h;
-    if (use_dma_ && dma_tx_chan_ >= 0) {
-        // Convert line-by-line to reduce temp buffer size
-        constexpr size_t LINE_MAX = 128; // width cap
-        uint8_t conv[LINE_MAX * 2];
-        const uint16_t* src = pixels;
-        for (int y=0; y<area.h; ++y) {
-            size_t line_pixels = area.w;
-            for (size_t i=0;i<line_pixels;++i) {
-                uint16_t px = src[i];
-                conv[2*i]   = (uint8_t)(px >> 8);
-                conv[2*i+1] = (uint8_t)(px & 0xFF);
-            }
-            src += area.w;
-            dc_data();
-            dma_channel_set_read_addr(dma_tx_chan_, conv, false);
-            dma_channel_set_trans_count(dma_tx_chan_, line_pixels*2, true);
-            dma_channel_wait_for_finish_blocking(dma_tx_chan_);
+    dc_data();
+    bus_.set_frame_bits(16);
+    const size_t w = area.w;
+    // Capture encodes each row while the panel DMA is busy with it
+    const bool cap = capture_begin(area);
+    if (use_dma_ && dma_tx_chan_ >= 0 && passthrough()) {
+        // No color work: the DMA reads each source directly, one transfer per contiguous run of rows
+        // (a whole framebuffer is a single transfer; flash sclera rows are runs of one)
+        for (int y = 0; y < area.h;) {
+            const uint16_t* src = row_at(y);
+            int n = 1;
+            while (y + n < area.h && row_at(y + n) == src + n * w) ++n;
+            hal::dma_start(dma_tx_chan_, src, (uint32_t)(n * w));
+            if (cap) for (int i = 0; i < n; ++i) capture_row(src + i * w);
+            y += n;
+            hal::dma_wait(dma_tx_chan_);
+        }
+    } else if (use_dma_ && dma_tx_chan_ >= 0) {
+        // Ping-pong line buffers: convert line y+1 (color stage) while line y streams out
+        size_t line_pixels = w > kDmaLineMax ? kDmaLineMax : w;
+        convert(row_at(0), g_dma_line[0], line_pixels);
+        for (int y = 0; y < area.h; ++y) {
+            hal::dma_start(dma_tx_chan_, g_dma_line[y & 1], (uint32_t)line_pixels);
+            if (y + 1 < area.h) convert(row_at(y + 1), g_dma_line[(y + 1) & 1], line_pixels);
+            if (cap) capture_row(row_at(y));
+            hal::dma_wait(dma_tx_chan_);
         }
     } else {
-        write_data_u16(pixels, count);
+        for (int y = 0; y < area.h; ++y) {
+            write_data_u16(row_at(y), w);
+            if (cap) capture_row(row_at(y));
+        }
     }
+    if (cap) capture_end();
+    // Commands after this are bytes again (waits for the last frames to shift out)
+    bus_.set_frame_bits(8);
     cs_deselect();
 }
 
-void Ssd1351Display::cs_select() { gpio_put(cs_, 0); }
-void Ssd1351Display::cs_deselect() { gpio_put(cs_, 1); }
-void Ssd1351Display::dc_command() { gpio_put(dc_, 0); }
-void Ssd1351Display::dc_data() { gpio_put(dc_, 1); }
-
-void Ssd1351Display::hw_reset() {
-    gpio_put(res_, 0);
-    sleep_ms(10);
-    gpio_put(res_, 1);
-    sleep_ms(10);
+// Frame capture is the firmware's stdio UART; a host build records the bus in the HAL instead
+#if PME_HOST_BUILD
+template <class Panel>
+bool Ssd1351Display<Panel>::capture_begin(const Rect&) { return false; }
+template <class Panel>
+void Ssd1351Display<Panel>::capture_row(const uint16_t*) {}
+template <class Panel>
+void Ssd1351Display<Panel>::capture_end() {}
+#else
+template <class Panel>
+bool Ssd1351Display<Panel>::capture_begin(const Rect& area) {
+    return capture_ && capture_->begin(capture_id_, area);
 }
+template <class Panel>
+void Ssd1351Display<Panel>::capture_row(const uint16_t* src) { capture_->row(src); }
+template <class Panel>
+void Ssd1351Display<Panel>::capture_end() { capture_->end(); }
+#endif
+
+template <class Panel>
+void Ssd1351Display<Panel>::cs_select() { hal::pin_put(cs_, 0); }
+template <class Panel>
+void Ssd1351Display<Panel>::cs_deselect() { hal::pin_put(cs_, 1); }
+template <class Panel>
+void Ssd1351Display<Panel>::dc_command() { hal::pin_put(dc_, 0); }
+template <class Panel>
+void Ssd1351Display<Panel>::dc_data() { hal::pin_put(dc_, 1); }
 
-void Ssd1351Display::write_cmd(uint8_t cmd) {
+template <class Panel>
+void Ssd1351Display<Panel>::write_cmd(uint8_t cmd) {
     dc_command();
-    spi_write_blocking(bus_.inst(), &cmd, 1);
+    hal::spi_write(bus_.inst(), &cmd, 1);
 }
 
-void Ssd1351Display::write_data(const uint8_t* data, size_t len) {
+template <class Panel>
+void Ssd1351Display<Panel>::write_data(const uint8_t* data, size_t len) {
     if (!data || !len) return;
     dc_data();
-    spi_write_blocking(bus_.inst(), data, len);
+    hal::spi_write(bus_.inst(), data, len);
 }
 
-void Ssd1351Display::write_data_u16(const uint16_t* data, size_t count) {
+// Pixel data in 16-bit SPI frames (the caller has set the frame size and D/C)
+template <class Panel>
+void Ssd1351Display<Panel>::write_data_u16(const uint16_t* data, size_t count) {
     if (!data || !count) return;
-    dc_data();
+    if (passthrough()) {
+        hal::spi_write16(bus_.inst(), data, count);
+        return;
+    }
     // Convert in chunks to reduce per-pixel SPI calls
     constexpr size_t CHUNK = 256; // larger burst for better throughput
-    uint8_t buf[CHUNK * 2];
+    uint16_t buf[CHUNK];
     size_t i = 0;
     while (i < count) {
         size_t n = count - i;
         if (n > CHUNK) n = CHUNK;
-        for (size_t k = 0; k < n; ++k) {
-            uint16_t px = data[i + k];
-            buf[2*k]     = static_cast<uint8_t>(px >> 8);
-            buf[2*k + 1] = static_cast<uint8_t>(px & 0xFF);
-        }
-        spi_write_blocking(bus_.inst(), buf, n * 2);
+        convert(data + i, buf, n);
+        hal::spi_write16(bus_.inst(), buf, n);
         i += n;
     }
 }
 
-void Ssd1351Display::set_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+template <class Panel>
+void Ssd1351Display<Panel>::convert(const uint16_t* src, uint16_t* dst, size_t n) const {
+    if (color_) {
+        color_->convert(src, dst, n);
+        return;
+    }
+    px::copy(dst, src, n);
+}
+
+template <class Panel>
+void Ssd1351Display<Panel>::set_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
     uint8_t col[2] = { static_cast<uint8_t>(x), static_cast<uint8_t>(x + w - 1) };
     uint8_t row[2] = { static_cast<uint8_t>(y), static_cast<uint8_t>(y + h - 1) };
     write_cmd(CMD_SETCOLUMN); write_data(col, 2);
     write_cmd(CMD_SETROW);    write_data(row, 2);
 }
 
+// Explicit instantiations: one line per supported panel geometry.
+template class Ssd1351Display<ActivePanel>;
+
 } // namespace eyes
@@ -1,23 +1,46 @@
 #pragma once
 
 #include <cstdint>
+#include "color_pipeline.hpp"
 #include "display.hpp"
+#include "panel_geometry.hpp"
 #include "spi_bus.hpp"
 
 namespace eyes {
 
+class FrameCapture;
+
+// SSD1351 driver specialised on panel geometry (window, line buffer and mux ratio are compile-time).
+template <class Panel>
 class Ssd1351Display : public Display {
 public:
-    Ssd1351Display(SpiBus& bus, uint16_t width, uint16_t height,
-                   uint8_t pin_cs, uint8_t pin_dc, uint8_t pin_res)
-        : bus_(bus), w_(width), h_(height), cs_(pin_cs), dc_(pin_dc), res_(pin_res) {}
+    static_assert(Panel::kWidth <= 128 && Panel::kHeight <= 128, "SSD1351 GDDRAM is 128x128");
+
+    Ssd1351Display(SpiBus& bus, uint8_t pin_cs, uint8_t pin_dc, uint8_t pin_res)
+        : bus_(bus), cs_(pin_cs), dc_(pin_dc), res_(pin_res) {}
 
     bool init() override;
+    // Boot in phases so panels sharing a bus reset and settle in parallel (see App::init):
+    // begin_reset() on all, wait kResetPulseMs, end_reset() on all, wait kResetPulseMs,
+    // configure() on all, then allow kPowerOnSettleMs before the first frame is shown.
+    static constexpr uint32_t kResetPulseMs = 10;
+    static constexpr uint32_t kPowerOnSettleMs = 20;
+    void begin_reset();   // GPIO + bus setup, RES asserted
+    void end_reset();     // RES released
+    bool configure();     // command sequence and DMA channel (panel must be out of reset)
     void fill(uint16_t color) override;
     void blit(uint16_t const* pixels, const Rect& area) override;
-    uint16_t width() const override { return w_; }
-    uint16_t height() const override { return h_; }
+    // One window write for all rows; with an identity color stage each run of rows that is contiguous
+    // in memory goes to SPI in a single DMA transfer straight from its source (XIP flash included).
+    void blit_rows(uint16_t const* const* rows, const Rect& area) override;
+    uint16_t width() const override { return Panel::kWidth; }
+    uint16_t height() const override { return Panel::kHeight; }
     void enable_dma(bool en) { use_dma_ = en; }
+    // Color stage applied on transmit (nullptr or identity = pixels are sent as stored).
+    void set_color_pipeline(const ColorPipeline* color) { color_ = color; }
+    // Feed every blit to a frame capture as display `id` (nullptr = off); the capture sees the
+    // pixels before the color stage.
+    void set_capture(FrameCapture* capture, uint8_t id) { capture_ = capture; capture_id_ = id; }
 
 private:
     // SSD1351 command set (subset)
@@ -45,20 +68,32 @@ private:
     void cs_deselect();
     void dc_command();
     void dc_data();
-    void hw_reset();
     void write_cmd(uint8_t cmd);
     void write_data(const uint8_t* data, size_t len);
     void write_data_u16(const uint16_t* data, size_t count);
     void set_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void convert(const uint16_t* src, uint16_t* dst, size_t n) const;
+    // Frame capture hooks (begin() false = this blit is not captured)
+    bool capture_begin(const Rect& area);
+    void capture_row(const uint16_t* src);
+    void capture_end();
+    bool passthrough() const { return !color_ || color_->identity(); }
+    // RAM write of area's pixels, row y read from row_at(y); SPI runs 16-bit frames for the data
+    template <class RowAt>
+    void stream(RowAt row_at, const Rect& area);
+
+    static constexpr uint16_t w_ = Panel::kWidth;
+    static constexpr uint16_t h_ = Panel::kHeight;
 
     SpiBus& bus_;
-    uint16_t w_;
-    uint16_t h_;
     uint8_t cs_;
     uint8_t dc_;
     uint8_t res_;
     bool use_dma_ = true; // default attempt DMA
     int dma_tx_chan_ = -1;
+    const ColorPipeline* color_ = nullptr;
+    FrameCapture* capture_ = nullptr;
+    uint8_t capture_id_ = 0;
 };
 
 } // namespace eyes
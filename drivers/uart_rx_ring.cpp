@@ -0,0 +1,60 @@
+#include "uart_rx_ring.hpp"
+
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+namespace eyes {
+
+UartRxRing* UartRxRing::instances_[2] = {nullptr, nullptr};
+
+bool UartRxRing::init() {
+    unsigned idx = uart_get_index(uart_);
+    if (idx > 1 || instances_[idx]) return false;
+    uart_init(uart_, baud_);
+    gpio_set_function(tx_, GPIO_FUNC_UART);
+    gpio_set_function(rx_, GPIO_FUNC_UART);
+    uart_set_hw_flow(uart_, false, false);
+    uart_set_fifo_enabled(uart_, true);
+    instances_[idx] = this;
+    unsigned irq = idx == 0 ? UART0_IRQ : UART1_IRQ;
+    irq_set_exclusive_handler(irq, &UartRxRing::irq_handler);
+    irq_set_enabled(irq, true);
+    uart_set_irq_enables(uart_, true, false); // RX (and RX timeout) only
+    return true;
+}
+
+void UartRxRing::irq_handler() {
+    for (UartRxRing* r : instances_) {
+        if (r) r->on_irq();
+    }
+}
+
+void UartRxRing::on_irq() {
+    // One timestamp per IRQ: bytes drained together arrived within one FIFO threshold/timeout
+    uint32_t now = time_us_32();
+    uint16_t head = head_.load(std::memory_order_relaxed);
+    while (uart_is_readable(uart_)) {
+        uint8_t b = (uint8_t)uart_getc(uart_);
+        uint16_t next = (uint16_t)((head + 1) & (kSize - 1));
+        if (next == tail_.load(std::memory_order_acquire)) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            continue; // drop newest; the framed parser resynchronises
+        }
+        data_[head] = b;
+        stamp_[head] = now;
+        head = next;
+    }
+    head_.store(head, std::memory_order_release);
+}
+
+bool UartRxRing::read(uint8_t& byte, uint32_t& stamp_us) {
+    uint16_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) return false;
+    byte = data_[tail];
+    stamp_us = stamp_[tail];
+    tail_.store((uint16_t)((tail + 1) & (kSize - 1)), std::memory_order_release);
+    return true;
+}
+
+} // namespace eyes
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "hardware/uart.h"
+
+namespace eyes {
+
+// Interrupt-driven UART receiver. The RX IRQ drains the hardware FIFO into a lock-free
+// single-producer/single-consumer ring, stamping each byte with its arrival time so
+// consumers can measure latency from receipt. Never blocks the main loop.
+class UartRxRing {
+public:
+    static constexpr size_t kSize = 256; // power of two
+
+    UartRxRing(uart_inst_t* uart, uint32_t baud, uint8_t pin_tx, uint8_t pin_rx)
+        : uart_(uart), baud_(baud), tx_(pin_tx), rx_(pin_rx) {}
+
+    bool init();
+    // Pop one byte; returns false when empty. stamp_us = time_us_32() when the byte was received.
+    bool read(uint8_t& byte, uint32_t& stamp_us);
+    // Bytes dropped because the ring was full (consumer too slow)
+    uint32_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+private:
+    static void irq_handler();
+    void on_irq();
+
+    uart_inst_t* uart_;
+    uint32_t baud_;
+    uint8_t tx_;
+    uint8_t rx_;
+    uint8_t data_[kSize]{};
+    uint32_t stamp_[kSize]{};
+    std::atomic<uint16_t> head_{0}; // written by IRQ
+    std::atomic<uint16_t> tail_{0}; // written by consumer
+    std::atomic<uint32_t> overruns_{0};
+
+    static UartRxRing* instances_[2]; // indexed by uart_get_index
+};
+
+} // namespace eyes
@@ -0,0 +1,24 @@
+// Thin hardware layer for the display path: GPIO outputs, SPI writes, one SPI TX DMA channel per
+// driver, and time. The firmware gets inline forwards to the Pico SDK (hal_pico.hpp); a host build
+// (PME_HOST_BUILD) gets a Linux backend that models the bus at its configured clock, records what is
+// sent tagged with CS and D/C, and feeds emulated panels (hal_host.hpp, docs/host_hal.md).
+//
+//     pin_output(pin, level)        GPIO as output, driven to level
+//     pin_put(pin, level)
+//     pin_spi(pin)                  pin muxed to its SPI function
+//     spi_begin(spi, hz)            init at hz (8-bit frames, mode 0); returns the rate set
+//     spi_baudrate(spi, hz)         returns the rate set
+//     spi_frame_bits(spi, bits)     waits for the bus to go idle, then sets the frame size
+//     spi_write(spi, data, len)     8-bit items; returns once they have shifted out
+//     spi_write16(spi, data, count) 16-bit items; returns once they have shifted out
+//     spi_tx_dma(spi)               DMA channel writing 16-bit items to spi's TX FIFO, or -1
+//     dma_start(ch, src, count)     start a transfer of count items from src
+//     dma_wait(ch)                  wait until the channel has moved its last item
+//     sleep_ms(ms), time_us()
+#pragma once
+
+#if PME_HOST_BUILD
+#include "hal_host.hpp"
+#else
+#include "hal_pico.hpp"
+#endif
@@ -0,0 +1,121 @@
+#include "hal_host.hpp"
+
+namespace eyes::hal {
+
+HostBus& HostBus::get() {
+    static HostBus bus;
+    return bus;
+}
+
+void HostBus::reset() {
+    const uint32_t clk = clk_peri_hz_;
+    *this = HostBus{};
+    clk_peri_hz_ = clk;
+}
+
+void HostBus::attach(int spi, SpiDevice* dev, uint8_t cs, uint8_t dc, uint8_t res) {
+    devices_.push_back(Attached{spi, dev, cs, dc, res});
+}
+
+// The SDK's spi_set_baudrate: even prescale 2..254, then post-divide 1..256, rounding the rate down
+uint32_t HostBus::set_baudrate(Spi& spi, uint32_t hz) {
+    const uint32_t in = clk_peri_hz_;
+    uint32_t prescale = 2, postdiv = 256;
+    for (; prescale <= 254; prescale += 2)
+        if (in < (prescale + 2) * 256 * (uint64_t)hz) break;
+    if (prescale > 254) prescale = 254;
+    for (; postdiv > 1; --postdiv)
+        if (in / (prescale * (postdiv - 1)) > hz) break;
+    spi.hz = in / (prescale * postdiv);
+    return spi.hz;
+}
+
+uint64_t HostBus::frames_ns(const Spi& spi, uint64_t frames) const {
+    return spi.hz ? frames * spi.frame_bits * 1000000000ull / spi.hz : 0;
+}
+
+void HostBus::put(uint8_t pin, bool level) {
+    if (pin >= kPins || pins_[pin] == level) return;
+    pins_[pin] = level;
+    for (const Attached& a : devices_) {
+        if (pin != a.cs && pin != a.dc && pin != a.res) continue;
+        if (spi_[a.spi].free_ns > now_ns_) ++stats_.hazards;
+        if (pin == a.res && !level) a.dev->on_reset();
+    }
+}
+
+void HostBus::wait_idle(const Spi& spi) {
+    if (spi.free_ns > now_ns_) now_ns_ = spi.free_ns;
+}
+
+uint64_t HostBus::queue(Spi& spi, const void* data, size_t count, int item_bits) {
+    const uint64_t start = spi.free_ns > now_ns_ ? spi.free_ns : now_ns_;
+    const uint64_t dur = frames_ns(spi, count);
+    spi.free_ns = start + dur;
+    stats_.frames += count;
+    stats_.busy_ns += dur;
+    // Items as they leave on the wire: an 8-bit frame carries the low byte of its item, a 16-bit
+    // frame the whole item (zero-extended from an 8-bit one), most significant byte first
+    const bool wide = spi.frame_bits > 8;
+    const size_t len = wide ? count * 2 : count;
+    stats_.bytes += len;
+    uint8_t buf[256];
+    const Attached* to = nullptr;
+    for (const Attached& a : devices_)
+        if (a.spi == spi.index && !pins_[a.cs]) { to = &a; break; }
+    const bool dc = to && pins_[to->dc];
+    size_t i = 0;
+    while (i < count) {
+        size_t n = 0;
+        for (; i < count && n + 2 <= sizeof buf; ++i) {
+            const uint16_t item = item_bits == 16 ? static_cast<const uint16_t*>(data)[i]
+                                                  : static_cast<const uint8_t*>(data)[i];
+            if (wide) buf[n++] = (uint8_t)(item >> 8);
+            buf[n++] = (uint8_t)item;
+        }
+        if (recording_) record(spi, to, dc, start, buf, n);
+        for (const Attached& a : devices_)
+            if (a.spi == spi.index && !pins_[a.cs]) a.dev->on_bytes(pins_[a.dc], buf, n);
+    }
+    return spi.free_ns;
+}
+
+void HostBus::record(const Spi& spi, const Attached* to, bool dc, uint64_t t_ns, const uint8_t* data, size_t len) {
+    const uint8_t cs = to ? to->cs : kNoPin;
+    if (segments_.empty() || segments_.back().spi != spi.index || segments_.back().cs != cs ||
+        segments_.back().dc != dc || segments_.back().frame_bits != spi.frame_bits)
+        segments_.push_back(Segment{t_ns, (uint8_t)spi.index, cs, dc, (uint8_t)spi.frame_bits, (uint32_t)bytes_.size(), 0});
+    bytes_.insert(bytes_.end(), data, data + len);
+    segments_.back().len += (uint32_t)len;
+}
+
+void HostBus::write(Spi& spi, const void* data, size_t count, int item_bits) {
+    ++stats_.writes;
+    now_ns_ = queue(spi, data, count, item_bits);
+}
+
+int HostBus::claim_dma(Spi& spi) {
+    for (int ch = 0; ch < kDmaChannels; ++ch) {
+        if (dma_[ch].spi) continue;
+        dma_[ch].spi = &spi;
+        dma_[ch].done_ns = 0;
+        return ch;
+    }
+    return -1;
+}
+
+void HostBus::dma_start(int ch, const void* src, uint32_t count) {
+    Dma& d = dma_[ch];
+    ++stats_.dma_transfers;
+    const uint64_t end = queue(*d.spi, src, count, 16);
+    // The channel is done once its last item is in the TX FIFO, up to kTxFifoFrames before the bus
+    const uint32_t fifo = count < (uint32_t)kTxFifoFrames ? count : (uint32_t)kTxFifoFrames;
+    d.done_ns = end - frames_ns(*d.spi, fifo);
+    if (d.done_ns < now_ns_) d.done_ns = now_ns_;
+}
+
+void HostBus::dma_wait(int ch) {
+    if (dma_[ch].done_ns > now_ns_) now_ns_ = dma_[ch].done_ns;
+}
+
+} // namespace eyes::hal
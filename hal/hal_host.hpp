@@ -0,0 +1,148 @@
+// Linux backend of the HAL (hal.hpp, PME_HOST_BUILD): no hardware, a model of it. Time is virtual
+// and only moves when the bus makes the caller wait, on sleep_ms(), or when a tool charges CPU work
+// with HostBus::advance_us(). Each SPI controller shifts frame_bits per item at its clock, rounded as
+// the RP2350's PL022 divider rounds it from clk_peri; a blocking write returns once its last frame is
+// out, a DMA transfer lets the caller run on until its last item is in the 8-frame TX FIFO. Bytes
+// reach the devices attached to the bus whose CS pin is low, with the level of their D/C pin, and
+// can be recorded as (CS, D/C)-tagged segments. A CS, D/C or RES pin that changes while frames are
+// still shifting is counted as a hazard: on the board those frames would go to the wrong place.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eyes::hal {
+
+// One SPI controller (spi0/spi1 are HostBus::get().spi(0/1))
+struct Spi {
+    int index = 0;
+    uint32_t hz = 0;
+    uint32_t frame_bits = 8;
+    uint64_t free_ns = 0;       // when the last queued frame has shifted out
+};
+
+// Something on an SPI bus: a panel emulator, a logic analyser
+class SpiDevice {
+public:
+    virtual ~SpiDevice() = default;
+    // Bytes shifted while this device was selected, dc = level of its D/C pin. A 16-bit frame arrives
+    // as two bytes, most significant first (the order it is on the wire).
+    virtual void on_bytes(bool dc, const uint8_t* data, size_t len) = 0;
+    virtual void on_reset() {}  // its RES pin went low
+};
+
+class HostBus {
+public:
+    static constexpr int kPins = 48;
+    static constexpr int kSpis = 2;
+    static constexpr int kDmaChannels = 16;
+    static constexpr int kTxFifoFrames = 8;
+    static constexpr uint8_t kNoPin = 0xFF;
+
+    // A run of bytes sent to the same device with the same D/C level (cs = kNoPin: nobody selected)
+    struct Segment {
+        uint64_t t_ns;          // first frame starts shifting
+        uint8_t spi;
+        uint8_t cs;
+        bool dc;
+        uint8_t frame_bits;
+        uint32_t offset;        // into bytes()
+        uint32_t len;
+    };
+    struct Stats {
+        uint64_t bytes = 0;
+        uint64_t frames = 0;
+        uint64_t busy_ns = 0;   // time the bus spent shifting
+        uint32_t writes = 0;    // blocking writes
+        uint32_t dma_transfers = 0;
+        uint32_t hazards = 0;
+    };
+
+    HostBus() { for (int i = 0; i < kSpis; ++i) spi_[i].index = i; }
+    static HostBus& get();
+
+    // Back to power-on: time 0, pins low, no devices, no DMA channels claimed, nothing recorded
+    void reset();
+    void set_clk_peri(uint32_t hz) { clk_peri_hz_ = hz; }
+    uint32_t clk_peri() const { return clk_peri_hz_; }
+    Spi* spi(int index) { return index >= 0 && index < kSpis ? &spi_[index] : nullptr; }
+
+    // dev listens on spi while cs is low; res (optional) resets it when driven low
+    void attach(int spi, SpiDevice* dev, uint8_t cs, uint8_t dc, uint8_t res = kNoPin);
+
+    uint64_t now_ns() const { return now_ns_; }
+    void advance_us(uint64_t us) { now_ns_ += us * 1000; }
+    bool pin(uint8_t p) const { return p < kPins && pins_[p]; }
+
+    const Stats& stats() const { return stats_; }
+    void reset_stats() { stats_ = Stats{}; }
+    void set_recording(bool on) { recording_ = on; }
+    void clear_record() { segments_.clear(); bytes_.clear(); }
+    const std::vector<Segment>& segments() const { return segments_; }
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+    // Backend of the HAL calls
+    uint32_t set_baudrate(Spi& spi, uint32_t hz);
+    void put(uint8_t pin, bool level);
+    void wait_idle(const Spi& spi);
+    // Blocking write of count items (item_bits 8 or 16): returns when the last frame is shifted out
+    void write(Spi& spi, const void* data, size_t count, int item_bits);
+    int claim_dma(Spi& spi);
+    void dma_start(int ch, const void* src, uint32_t count);
+    void dma_wait(int ch);
+    void sleep_us(uint64_t us) { now_ns_ += us * 1000; }
+
+private:
+    struct Attached {
+        int spi;
+        SpiDevice* dev;
+        uint8_t cs, dc, res;
+    };
+    struct Dma {
+        Spi* spi = nullptr;
+        uint64_t done_ns = 0;
+    };
+
+    uint64_t frames_ns(const Spi& spi, uint64_t frames) const;
+    // Queue count items behind whatever spi is still shifting and deliver them; returns the time the
+    // last frame is out
+    uint64_t queue(Spi& spi, const void* data, size_t count, int item_bits);
+    void record(const Spi& spi, const Attached* to, bool dc, uint64_t t_ns, const uint8_t* data, size_t len);
+
+    uint32_t clk_peri_hz_ = 150000000;  // RP2350 default: clk_peri = clk_sys
+    uint64_t now_ns_ = 0;
+    bool pins_[kPins]{};
+    Spi spi_[kSpis]{};
+    Dma dma_[kDmaChannels]{};
+    std::vector<Attached> devices_;
+    Stats stats_{};
+    bool recording_ = false;
+    std::vector<Segment> segments_;
+    std::vector<uint8_t> bytes_;
+};
+
+inline void pin_output(uint32_t pin, bool level) { HostBus::get().put((uint8_t)pin, level); }
+inline void pin_put(uint32_t pin, bool level) { HostBus::get().put((uint8_t)pin, level); }
+inline void pin_spi(uint32_t) {}
+
+inline uint32_t spi_begin(Spi* spi, uint32_t hz) {
+    spi->frame_bits = 8;
+    return HostBus::get().set_baudrate(*spi, hz);
+}
+inline uint32_t spi_baudrate(Spi* spi, uint32_t hz) { return HostBus::get().set_baudrate(*spi, hz); }
+inline void spi_frame_bits(Spi* spi, uint32_t bits) {
+    HostBus::get().wait_idle(*spi);
+    spi->frame_bits = bits;
+}
+inline void spi_write(Spi* spi, const uint8_t* data, size_t len) { HostBus::get().write(*spi, data, len, 8); }
+inline void spi_write16(Spi* spi, const uint16_t* data, size_t count) { HostBus::get().write(*spi, data, count, 16); }
+
+inline int spi_tx_dma(Spi* spi) { return HostBus::get().claim_dma(*spi); }
+inline void dma_start(int ch, const void* src, uint32_t count) { HostBus::get().dma_start(ch, src, count); }
+inline void dma_wait(int ch) { HostBus::get().dma_wait(ch); }
+
+inline void sleep_ms(uint32_t ms) { HostBus::get().sleep_us((uint64_t)ms * 1000); }
+inline uint64_t time_us() { return HostBus::get().now_ns() / 1000; }
+
+} // namespace eyes::hal
@@ -0,0 +1,49 @@
+// Pico SDK backend of the HAL (hal.hpp): every call is an inline forward, so the firmware compiles
+// to the same SDK calls the drivers made directly.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/spi.h"
+
+namespace eyes::hal {
+
+using Spi = spi_inst_t;
+
+inline void pin_output(uint32_t pin, bool level) {
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_OUT);
+    gpio_put(pin, level);
+}
+inline void pin_put(uint32_t pin, bool level) { gpio_put(pin, level); }
+inline void pin_spi(uint32_t pin) { gpio_set_function(pin, GPIO_FUNC_SPI); }
+
+inline uint32_t spi_begin(Spi* spi, uint32_t hz) { return spi_init(spi, hz); }
+inline uint32_t spi_baudrate(Spi* spi, uint32_t hz) { return spi_set_baudrate(spi, hz); }
+inline void spi_frame_bits(Spi* spi, uint32_t bits) {
+    while (spi_is_busy(spi)) {}
+    spi_set_format(spi, bits, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+}
+inline void spi_write(Spi* spi, const uint8_t* data, size_t len) { spi_write_blocking(spi, data, len); }
+inline void spi_write16(Spi* spi, const uint16_t* data, size_t count) { spi_write16_blocking(spi, data, count); }
+
+inline int spi_tx_dma(Spi* spi) {
+    int ch = dma_claim_unused_channel(false);
+    if (ch < 0) return -1;
+    // 16-bit items paced by the SPI TX DREQ; source and count are set per transfer
+    dma_channel_config c = dma_channel_get_default_config(ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_dreq(&c, spi_get_dreq(spi, true));
+    dma_channel_configure(ch, &c, &spi_get_hw(spi)->dr, nullptr, 0, false);
+    return ch;
+}
+inline void dma_start(int ch, const void* src, uint32_t count) { dma_channel_transfer_from_buffer_now(ch, src, count); }
+inline void dma_wait(int ch) { dma_channel_wait_for_finish_blocking(ch); }
+
+inline void sleep_ms(uint32_t ms) { ::sleep_ms(ms); }
+inline uint64_t time_us() { return time_us_64(); }
+
+} // namespace eyes::hal
@@ -0,0 +1,179 @@
+#include "ssd1351_emulator.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace eyes {
+
+namespace {
+    constexpr uint8_t CMD_SETCOLUMN   = 0x15;
+    constexpr uint8_t CMD_SETROW      = 0x75;
+    constexpr uint8_t CMD_WRITERAM    = 0x5C;
+    constexpr uint8_t CMD_SETREMAP    = 0xA0;
+    constexpr uint8_t CMD_DISPLAYOFF  = 0xAE;
+    constexpr uint8_t CMD_DISPLAYON   = 0xAF;
+    constexpr uint8_t CMD_MUXRATIO    = 0xCA;
+    constexpr uint8_t CMD_COMMANDLOCK = 0xFD;
+
+    // Data bytes each command takes (datasheet command table); -1 = not modelled
+    int arg_count(uint8_t cmd) {
+        switch (cmd) {
+            case 0x15: case 0x75: return 2;
+            case 0x5C: case 0x5D: case 0xA4: case 0xA5: case 0xA6: case 0xA7:
+            case 0xAE: case 0xAF: case 0xB9: case 0x9E: case 0x9F: return 0;
+            case 0xA0: case 0xA1: case 0xA2: case 0xAB: case 0xB1: case 0xB3: case 0xB5:
+            case 0xB6: case 0xBB: case 0xBE: case 0xC7: case 0xCA: case 0xFD: return 1;
+            case 0xB2: case 0xB4: case 0xC1: return 3;
+            case 0x96: return 5;
+            case 0xB8: return 63;
+            default: return -1;
+        }
+    }
+
+    // Commands that need FD B1 first (FD B0, the reset state, makes them inaccessible)
+    bool restricted(uint8_t cmd) {
+        return cmd == 0xA2 || cmd == 0xB1 || cmd == 0xB3 || cmd == 0xBB || cmd == 0xBE || cmd == 0xC1;
+    }
+}
+
+void Ssd1351Emulator::on_reset() {
+    // RAM contents survive a reset; the registers return to their reset values
+    cmd_ = 0;
+    want_ = got_ = 0;
+    writing_ = have_high_ = false;
+    locked_ = false;
+    restricted_ = true;
+    display_on_ = false;
+    remap_ = 0x40;
+    mux_ = 127;
+    col_start_ = row_start_ = col_ = row_ = 0;
+    col_end_ = row_end_ = 127;
+}
+
+void Ssd1351Emulator::on_bytes(bool dc, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        if (!dc) command(data[i]);
+        else if (writing_) ram_byte(data[i]);
+        else if (want_ > 0) argument(data[i]);
+        else ++stats_.stray_data;
+    }
+}
+
+void Ssd1351Emulator::command(uint8_t cmd) {
+    if (writing_) end_ram_write();
+    want_ = 0;
+    const bool lock_cmd = cmd == CMD_COMMANDLOCK;
+    if ((locked_ && !lock_cmd) || (restricted_ && restricted(cmd))) {
+        ++stats_.ignored;
+        // Its data still arrives; swallow it
+        const int n = arg_count(cmd);
+        want_ = n > 0 ? n : 0;
+        cmd_ = 0;
+        got_ = 0;
+        return;
+    }
+    ++stats_.commands;
+    const int n = arg_count(cmd);
+    if (n < 0) { ++stats_.unknown; cmd_ = 0; return; }
+    cmd_ = cmd;
+    want_ = n;
+    got_ = 0;
+    switch (cmd) {
+        case CMD_WRITERAM:
+            writing_ = true;
+            have_high_ = false;
+            written_ = 0;
+            ++stats_.ram_writes;
+            break;
+        case CMD_DISPLAYOFF: display_on_ = false; break;
+        case CMD_DISPLAYON: display_on_ = true; break;
+        default: break;
+    }
+}
+
+void Ssd1351Emulator::argument(uint8_t b) {
+    if (got_ < (int)sizeof args_) args_[got_] = b;
+    ++got_;
+    if (--want_ > 0) return;
+    switch (cmd_) {
+        case CMD_SETCOLUMN:
+            col_start_ = args_[0] & 0x7F;
+            col_end_ = args_[1] & 0x7F;
+            col_ = col_start_;
+            ++stats_.windows;
+            break;
+        case CMD_SETROW:
+            row_start_ = args_[0] & 0x7F;
+            row_end_ = args_[1] & 0x7F;
+            row_ = row_start_;
+            ++stats_.windows;
+            break;
+        case CMD_SETREMAP: remap_ = args_[0]; break;
+        case CMD_MUXRATIO: mux_ = args_[0] & 0x7F; break;
+        case CMD_COMMANDLOCK:
+            if (args_[0] == 0x12) locked_ = false;
+            else if (args_[0] == 0x16) locked_ = true;
+            else if (args_[0] == 0xB0) restricted_ = true;
+            else if (args_[0] == 0xB1) restricted_ = false;
+            break;
+        default: break;
+    }
+}
+
+void Ssd1351Emulator::ram_byte(uint8_t b) {
+    if ((remap_ >> 6) >= 2) { ++stats_.stray_data; return; } // 262k formats not modelled
+    if (!have_high_) { high_ = b; have_high_ = true; return; }
+    have_high_ = false;
+    ram_[row_][col_] = (uint16_t)(high_ << 8 | b);
+    ++written_;
+    ++stats_.pixels;
+    // Grow the dirty box
+    if (!dirty_.w) {
+        dirty_ = Rect{col_, row_, 1, 1};
+    } else {
+        const int x0 = col_ < dirty_.x ? col_ : dirty_.x, y0 = row_ < dirty_.y ? row_ : dirty_.y;
+        const int x1 = col_ >= dirty_.x + dirty_.w ? col_ + 1 : dirty_.x + dirty_.w;
+        const int y1 = row_ >= dirty_.y + dirty_.h ? row_ + 1 : dirty_.y + dirty_.h;
+        dirty_ = Rect{(uint16_t)x0, (uint16_t)y0, (uint16_t)(x1 - x0), (uint16_t)(y1 - y0)};
+    }
+    // Address increment inside the window: along rows, or down columns with vertical increment
+    const bool vertical = remap_ & 0x01;
+    uint8_t &inner = vertical ? row_ : col_, &outer = vertical ? col_ : row_;
+    const uint8_t inner_start = vertical ? row_start_ : col_start_, inner_end = vertical ? row_end_ : col_end_;
+    const uint8_t outer_start = vertical ? col_start_ : row_start_, outer_end = vertical ? col_end_ : row_end_;
+    if (inner != inner_end) { ++inner; return; }
+    inner = inner_start;
+    outer = outer == outer_end ? outer_start : outer + 1;
+}
+
+void Ssd1351Emulator::end_ram_write() {
+    writing_ = false;
+    const uint32_t area = (uint32_t)(col_end_ - col_start_ + 1) * (row_end_ - row_start_ + 1);
+    if (written_ % area) ++stats_.short_writes;
+}
+
+bool Ssd1351Emulator::matches(const uint16_t* pixels, const Rect& area) const {
+    for (int y = 0; y < area.h; ++y)
+        if (std::memcmp(&ram_[area.y + y][area.x], pixels + (size_t)y * area.w, area.w * sizeof(uint16_t)) != 0)
+            return false;
+    return true;
+}
+
+bool Ssd1351Emulator::write_ppm(const char* path) const {
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", kSize, kSize);
+    for (int y = 0; y < kSize; ++y) {
+        uint8_t line[kSize * 3];
+        for (int x = 0; x < kSize; ++x) {
+            const uint16_t p = ram_[y][x];
+            line[x * 3 + 0] = (uint8_t)((p >> 11) * 255 / 31);
+            line[x * 3 + 1] = (uint8_t)(((p >> 5) & 0x3F) * 255 / 63);
+            line[x * 3 + 2] = (uint8_t)((p & 0x1F) * 255 / 31);
+        }
+        std::fwrite(line, 1, sizeof line, f);
+    }
+    return std::fclose(f) == 0;
+}
+
+} // namespace eyes
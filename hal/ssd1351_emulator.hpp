@@ -0,0 +1,77 @@
+// Software SSD1351 for the host HAL (hal_host.hpp): decodes the command/data stream it is sent into
+// its 128x128 GDDRAM, so a host build of Ssd1351Display can be checked pixel for pixel. The image is
+// kept in RAM address order (column, row as the driver addresses them); the remap flips that the
+// module applies between RAM and glass are not modelled, and only 65k-color writes are.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "display.hpp"
+#include "hal_host.hpp"
+
+namespace eyes {
+
+class Ssd1351Emulator : public hal::SpiDevice {
+public:
+    static constexpr int kSize = 128;
+
+    struct Stats {
+        uint32_t commands = 0;
+        uint32_t unknown = 0;       // commands this model does not know (their data is ignored)
+        uint32_t ignored = 0;       // commands dropped by the command lock (FD 16, or FD B0 for some)
+        uint32_t stray_data = 0;    // data bytes with no command expecting them
+        uint32_t windows = 0;       // column or row address set
+        uint32_t ram_writes = 0;    // WRITERAM commands
+        uint32_t pixels = 0;
+        uint32_t short_writes = 0;  // RAM writes that stopped before filling their window
+    };
+
+    void on_bytes(bool dc, const uint8_t* data, size_t len) override;
+    void on_reset() override;
+
+    uint16_t pixel(int x, int y) const { return ram_[y][x]; }
+    bool display_on() const { return display_on_; }
+    uint8_t remap() const { return remap_; }
+    uint8_t mux_ratio() const { return mux_; }
+    // Column/row address window of the last SETCOLUMN/SETROW
+    Rect window() const {
+        return Rect{col_start_, row_start_, (uint16_t)(col_end_ - col_start_ + 1), (uint16_t)(row_end_ - row_start_ + 1)};
+    }
+    // Bounding box of the pixels written since clear_dirty() (w = 0: none)
+    Rect dirty() const { return dirty_; }
+    void clear_dirty() { dirty_ = Rect{}; }
+    // True if the w x h pixels of area (row stride w) are what the RAM holds there
+    bool matches(const uint16_t* pixels, const Rect& area) const;
+
+    const Stats& stats() const { return stats_; }
+    void reset_stats() { stats_ = Stats{}; }
+    // Binary PPM of the RAM (RGB565 expanded to 8 bits per channel)
+    bool write_ppm(const char* path) const;
+
+private:
+    void command(uint8_t cmd);
+    void argument(uint8_t b);
+    void ram_byte(uint8_t b);
+    void end_ram_write();
+
+    uint16_t ram_[kSize][kSize]{};
+    uint8_t cmd_ = 0;
+    uint8_t args_[4]{};
+    int want_ = 0;              // data bytes the current command still takes
+    int got_ = 0;
+    bool writing_ = false;      // data is pixels (after WRITERAM)
+    bool have_high_ = false;
+    uint8_t high_ = 0;
+    uint32_t written_ = 0;      // pixels of this RAM write
+    bool locked_ = false;       // FD 16 until FD 12
+    bool restricted_ = true;    // FD B0 until FD B1
+    bool display_on_ = false;
+    uint8_t remap_ = 0x40;
+    uint8_t mux_ = 127;
+    uint8_t col_start_ = 0, col_end_ = 127, row_start_ = 0, row_end_ = 127;
+    uint8_t col_ = 0, row_ = 0;
+    Rect dirty_{};
+    Stats stats_{};
+};
+
+} // namespace eyes
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "audio_envelope.hpp"
 
 namespace eyes {
 
@@ -13,6 +14,27 @@ public:
     virtual bool start() = 0;
     virtual void stop() = 0;
     virtual size_t write_samples(const int16_t* samples, size_t count) = 0; // returns frames written
+    // Sample clock: frames consumed by the output since init (the timebase scripted animation locks to)
+    virtual uint64_t samples_played() const = 0;
+    // Analysis of every block the output accepts (nullptr = none), run inside write_samples
+    void set_analyzer(AudioEnvelope* analyzer) {
+        analyzer_ = analyzer;
+        if (analyzer_) analyzer_->set_sample_rate(sample_rate_hz_);
+    }
+
+protected:
+    // For implementations: init records the rate, write_samples hands over what it accepted
+    void set_rate(uint32_t hz) {
+        sample_rate_hz_ = hz;
+        if (analyzer_) analyzer_->set_sample_rate(hz);
+    }
+    void analyze(const int16_t* samples, size_t count) {
+        if (analyzer_) analyzer_->analyze(samples, count);
+    }
+
+private:
+    AudioEnvelope* analyzer_ = nullptr;
+    uint32_t sample_rate_hz_ = 0;   // 0 until init
 };
 
 } // namespace eyes
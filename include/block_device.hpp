@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+namespace eyes {
+
+// Abstract block storage for streamed assets (SD card, external flash; a file on the host). Reads
+// are asynchronous: start_read() sets up a transfer of whole blocks into RAM and returns, poll()
+// advances it without waiting on the bus, and the read is over once busy() is false. Sequential
+// reads (each starting where the previous one ended) are the fast path on every device.
+class BlockDevice {
+public:
+    static constexpr uint32_t kBlockSize = 512;
+
+    virtual ~BlockDevice() = default;
+    virtual bool init() = 0;
+    virtual uint32_t block_count() const = 0;
+    // Read count blocks from lba into dst (count * kBlockSize bytes, 4-byte aligned). False if a
+    // read is still in progress or the range is out of bounds.
+    virtual bool start_read(uint32_t lba, uint32_t count, uint8_t* dst) = 0;
+    // Advance the transfer in progress; call from the task that owns the device
+    virtual void poll() = 0;
+    virtual bool busy() const = 0;
+    // Outcome of the last read once it is over: false after a bus/card error or timeout
+    virtual bool ok() const = 0;
+    // Failed or timed-out reads since init
+    virtual uint32_t errors() const { return 0; }
+    // Blocking read for boot-time use (directory, headers): start, then poll until it is over
+    bool read(uint32_t lba, uint32_t count, uint8_t* dst) {
+        if (!start_read(lba, count, dst)) return false;
+        while (busy()) poll();
+        return ok();
+    }
+    // Called from the transfer IRQ when data has landed and poll() has work (e.g. to wake its task)
+    void on_transfer(void (*fn)(void*), void* ctx) { on_transfer_ = fn; on_transfer_ctx_ = ctx; }
+
+protected:
+    void transfer_event() { if (on_transfer_) on_transfer_(on_transfer_ctx_); }
+
+private:
+    void (*on_transfer_)(void*) = nullptr;
+    void* on_transfer_ctx_ = nullptr;
+};
+
+} // namespace eyes
@@ -15,6 +15,10 @@ public:
     virtual bool init() = 0;
     virtual void fill(uint16_t color) = 0;
     virtual void blit(uint16_t const* pixels, const Rect& area) = 0;
+    // As blit, but row y of the area is read from rows[y] (e.g. some rows straight from a flash asset).
+    virtual void blit_rows(uint16_t const* const* rows, const Rect& area) {
+        for (uint16_t y = 0; y < area.h; ++y) blit(rows[y], Rect{area.x, (uint16_t)(area.y + y), area.w, 1});
+    }
     virtual uint16_t width() const = 0;
     virtual uint16_t height() const = 0;
 };
@@ -1,18 +1,86 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include "display.hpp"
+#include "eye_animator.hpp"
+#include "eye_renderer.hpp"
+#include "perf_stats.hpp"
 
 namespace eyes {
 
+// One physical eye: a display, its slot in the EyeAnimator, and its render state (style, iris size,
+// eyelid mirroring and shapes are set by the owner). Each frame the App steps the animator once for
+// all eyes, ticks every Eye, then renders each group of eyes that shares an iris sprite.
+template <class Panel>
 class Eye {
 public:
-    explicit Eye(Display& display) : display_(display) {}
-    bool init() { return display_.init(); }
-    void tick(uint32_t /*ms*/) {}
-    void render() {}
+    Eye() = default;
+    void bind(Display* display, int slot) { display_ = display; slot_ = slot; }
+    bool init() { return display_ && display_->init(); }
+
+    int slot() const { return slot_; }
+    EyeRenderParams& params() { return params_; }
+    const EyeRenderParams& params() const { return params_; }
+    const EyelidSpans<Panel>& spans() const { return spans_; }
+
+    // Pull this eye's animated state and recompute what its eyelids leave visible. With lids false
+    // the eyelids keep last frame's opening and spans (the owner must keep their shapes too); the
+    // spans only grow if the new iris position needs the sub-pixel shift and they lack its margin.
+    void tick(const EyeAnimator& anim, bool lids = true) {
+        set_iris_position(params_, anim.iris_x(slot_), anim.iris_y(slot_));
+        params_.pupil_scale = anim.pupil_scale(slot_);
+        if (!lids) {
+            widen_eyelid_spans<Panel>(params_, spans_);
+            return;
+        }
+        params_.eyelid_open = anim.eyelid_open(slot_);
+        perf::Scope ps(perf::Section::Eyelids);
+        compute_eyelid_spans<Panel>(params_, spans_);
+    }
+
+    // Compose the (group's) iris sprite at this eye's position into frame, then its eyelids. With
+    // rows, pure sclera rows are left in flash (see FrameRows) and present must be given the same rows.
+    void render(uint16_t* frame, const IrisSprite<Panel>& iris, FrameRows<Panel>* rows = nullptr) const {
+        const perf::Section compose = params_.spherical ? perf::Section::ComposeSphere : perf::Section::Compose;
+        { perf::Scope ps(compose); compose_eye<Panel>(frame, iris, params_, &spans_, rows); }
+        { perf::Scope ps(perf::Section::Eyelids); apply_eyelids<Panel>(frame, params_); }
+    }
+
+    // Blit the frame. With reduced, only the rows that some lid opening left visible this frame or
+    // the last are sent: the rows outside are lid color on the panel already. That holds while the
+    // lid colors and the transmit color stage stay the same; invalidate() when either changes.
+    void present(const uint16_t* frame, const FrameRows<Panel>* rows = nullptr, bool reduced = false) {
+        if (!display_) return;
+        perf::Scope ps(perf::Section::Blit);
+        int y0 = 0, y1 = Panel::kHeight - 1;
+        if (reduced && sent_full_ && params_.eyelid_color_top == params_.eyelid_color_bottom) {
+            // Spans of a shut eye are empty (y0 = kHeight, y1 = -1); one row of margin each way
+            y0 = std::min(spans_.y0, sent_y0_) - 1;
+            y1 = std::max(spans_.y1, sent_y1_) + 1;
+            if (y0 < 0) y0 = 0;
+            if (y1 > Panel::kHeight - 1) y1 = Panel::kHeight - 1;
+        }
+        sent_full_ = true;
+        sent_y0_ = spans_.y0;
+        sent_y1_ = spans_.y1;
+        if (y1 < y0) return; // shut both frames: nothing on the panel changes
+        const Rect area{0, (uint16_t)y0, (uint16_t)Panel::kWidth, (uint16_t)(y1 - y0 + 1)};
+        if (rows && rows->flash_rows) display_->blit_rows(rows->row + y0, area);
+        else display_->blit(frame + (size_t)y0 * Panel::kWidth, area);
+    }
+    // The next present() sends the whole frame
+    void invalidate() { sent_full_ = false; }
+
 private:
-    Display& display_;
+    Display* display_ = nullptr;
+    int slot_ = 0;
+    EyeRenderParams params_{};
+    EyelidSpans<Panel> spans_{};
+    // Visible rows of the last frame presented (empty when shut); sent_full_ false = the panel
+    // holds nothing this eye can rely on
+    bool sent_full_ = false;
+    int sent_y0_ = Panel::kHeight, sent_y1_ = -1;
 };
 
 } // namespace eyes
@@ -0,0 +1,22 @@
+// Named RAM placement for the large buffers (budget: tools/ram_report.py, `ram_report` build target).
+// RP2350 main SRAM (SRAM0-7) is word-striped across banks, so buffers placed there share banks and
+// DMA reads of one compete with CPU access to another. SCRATCH_X/Y (SRAM8/9, 4 KB each) are separate
+// banks: the SPI DMA line buffers go to SCRATCH_X, so while a line streams out the renderer's
+// framebuffer and LUT traffic never waits on the DMA. Core 0's stack lives in SCRATCH_Y; SCRATCH_X
+// keeps 2 KB reserved for a core 1 stack, which leaves ~2 KB for buffers.
+#pragma once
+
+#ifndef PME_DMA_IN_SCRATCH
+#define PME_DMA_IN_SCRATCH 1
+#endif
+
+// Zero-initialised (.bss.*) named sections; the names group each subsystem in the link map.
+#define PME_FRAMEBUFFER_RAM __attribute__((section(".bss.pme_framebuffer"), aligned(4)))
+#define PME_LUT_RAM         __attribute__((section(".bss.pme_luts"), aligned(4)))
+#define PME_ASSET_RAM       __attribute__((section(".bss.pme_assets"), aligned(4)))
+#if PME_DMA_IN_SCRATCH
+// .scratch_x.* is copied from flash at boot by the SDK crt0, like __scratch_x("...")
+#define PME_DMA_RAM         __attribute__((section(".scratch_x.pme_dma"), aligned(4)))
+#else
+#define PME_DMA_RAM         __attribute__((section(".bss.pme_dma"), aligned(4)))
+#endif
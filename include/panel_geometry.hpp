@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace eyes {
+
+// Compile-time panel geometry. The renderer, eyelid tables and display drivers are templated on
+// this so loops and buffers are sized at compile time; a new panel is a new instantiation
+// (see the explicit instantiation lists at the bottom of eye_renderer.cpp / ssd1351_display.cpp).
+template <int W, int H, int MaxIrisR = (W < H ? W : H) / 2>
+struct PanelGeometry {
+    static_assert(W > 0 && H > 0 && W <= 256 && H <= 256, "panel dimensions must be 1..256");
+    static_assert(MaxIrisR > 0 && MaxIrisR <= 127, "iris radius must fit the sprite/LUT index types");
+    static constexpr int kWidth = W;
+    static constexpr int kHeight = H;
+    static constexpr int kPixels = W * H;
+    static constexpr int kMaxIrisR = MaxIrisR; // largest iris radius the LUTs/sprite can hold
+};
+
+using Panel128x128 = PanelGeometry<128, 128>;
+using Panel240x240 = PanelGeometry<240, 240>;
+
+} // namespace eyes
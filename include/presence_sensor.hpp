@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+namespace eyes {
+
+// Where the sensor sees the most likely person, in its own field of view
+struct PresenceReading {
+    bool present = false;
+    float x = 0.f;              // -1 (left edge) .. 1 (right edge) as seen from the sensor
+    float y = 0.f;              // -1 (top) .. 1 (bottom)
+    float distance_mm = 0.f;    // 0 = unknown (gaze stays parallel)
+    uint32_t stamp_us = 0;      // time_us_32() when the sample finished arriving
+};
+
+// Abstract presence / thermal / ToF sensor. Acquisition runs in the background (DMA, IRQ); poll()
+// only starts or finishes transfers and never waits on the bus, so it is safe in the render loop.
+class PresenceSensor {
+public:
+    virtual ~PresenceSensor() = default;
+    virtual bool init() = 0;
+    // Advance acquisition; call once per frame
+    virtual void poll(uint32_t now_us) = 0;
+    // Newest reading since the last take; false if there is none
+    virtual bool take(PresenceReading& out) = 0;
+    // Failed or timed-out transfers since init
+    virtual uint32_t errors() const { return 0; }
+    // Called from the acquisition IRQ when a sample has arrived (e.g. to wake the task that polls)
+    void on_sample(void (*fn)(void*), void* ctx) { on_sample_ = fn; on_sample_ctx_ = ctx; }
+
+protected:
+    void sample_arrived() { if (on_sample_) on_sample_(on_sample_ctx_); }
+
+private:
+    void (*on_sample_)(void*) = nullptr;
+    void* on_sample_ctx_ = nullptr;
+};
+
+} // namespace eyes
@@ -2,7 +2,6 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "hardware/spi.h"
-#include "hardware/i2c.h"
 #include "hardware/uart.h"
 #include "src/app.hpp"
 
@@ -15,29 +14,16 @@
 #define PIN_SCK  18
 #define PIN_MOSI 19
 
-// I2C defines
-// This example will use I2C0 on GPIO8 (SDA) and GPIO9 (SCL) running at 400KHz.
-// Pins can be changed, see the GPIO function select table in the datasheet for information on GPIO assignments
-#define I2C_PORT i2c0
-#define I2C_SDA 8
-#define I2C_SCL 9
-
-// UART defines
-// By default the stdout UART is `uart0`, so we will use the second one
-#define UART_ID uart1
-#define BAUD_RATE 115200
-
-// Use pins 4 and 5 for UART1
-// Pins can be changed, see the GPIO function select table in the datasheet for information on GPIO assignments
-#define UART_TX_PIN 4
-#define UART_RX_PIN 5
+// I2C0 (GPIO8/9) carries the presence sensor and UART1 the live control channel; pins in
+// boards/pico2_pins.hpp. stdout stays on uart0.
 
 
 
 int main() {
     stdio_init_all();
 
-    eyes::App app;
+    // Static: keeps App (render and animation state) out of the 2 KB core 0 stack in SCRATCH_Y
+    static eyes::App app;
     if (!app.init()) {
         // Fallback to a simple heartbeat if init fails
         while (true) { sleep_ms(1000); }
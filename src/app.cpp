@@ -5,14 +5,28 @@
 #include "hardware/gpio.h"
 
 #include "boards/pico2_pins.hpp"
+#include "hal.hpp"
 #include "drivers/spi_bus.hpp"
 #include "drivers/ssd1351_display.hpp"
+#include "drivers/uart_rx_ring.hpp"
+#include "drivers/amg8833_sensor.hpp"
+#include "drivers/frame_capture.hpp"
+#include "drivers/pico_clock.hpp"
+#include "drivers/sd_spi_block_device.hpp"
+#include "asset_pack.hpp"
+#include "block_cache.hpp"
+#include "style_stream.hpp"
+#include "fake_presence_sensor.hpp"
 #include "default_eye.hpp"
 #include "eye_renderer.hpp"
+#include "pixel_kernels.hpp"
+#include "perf_stats.hpp"
+#include "mem_placement.hpp"
 #include <cmath>
 #include <cstdint>
 #include <algorithm>
 #include <cstring>
+#include <cstdio>
 
 namespace eyes {
 
@@ -22,59 +36,70 @@ namespace {
     template<typename T>
     static inline T clamp_fallback(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
     SpiBus* g_spi = nullptr;
-    Ssd1351Display* g_left = nullptr;
-    Ssd1351Display* g_right = nullptr;
+    using Panel = ActivePanel;
+    constexpr int kRows = Panel::kHeight;
+    Ssd1351Display<Panel>* g_left = nullptr;
+    Ssd1351Display<Panel>* g_right = nullptr;
+    // Render target shared by both eyes (composed and blitted one eye at a time)
+    PME_FRAMEBUFFER_RAM uint16_t g_frame[Panel::kPixels];
+    // Outgoing style's eye during a style cross-fade, blended over g_frame
+    PME_FRAMEBUFFER_RAM uint16_t g_fade_frame[Panel::kPixels];
+    // Row sources of the eye in g_frame: untouched sclera rows are blitted straight from flash
+    FrameRows<Panel> g_rows;
+#if PME_ASSET_STREAMING
+    // RAM slot for one eye style streamed from the asset pack
+    PME_ASSET_RAM uint8_t g_style_arena[PME_STYLE_ARENA_KB * 1024];
+#endif
 
     // Per-emotion eyelid shape adjustment arrays (int8 per row, 0 = no change).
     // Positive values LOWER upper lid (more closed) and RAISE lower lid (more closed)
     // because they increase the coverage threshold; negatives do the opposite (more open).
-    static int8_t upper_neutral[128];
-    static int8_t lower_neutral[128];
-    static int8_t upper_sad[128];
-    static int8_t lower_sad[128];
-    static int8_t upper_fear[128];
-    static int8_t lower_fear[128];
-    static int8_t upper_anger[128];
-    static int8_t lower_anger[128];
-    static int8_t upper_disgust[128];
-    static int8_t lower_disgust[128];
-
-    bool shapes_inited = false;
-
-    void init_emotion_shapes() {
-        if (shapes_inited) return;
-        shapes_inited = true;
-        for (int y = 0; y < 128; ++y) {
+    // Generated at compile time (flash) so boot does no table work.
+    struct EmotionShapes {
+        int8_t upper_neutral[kRows], lower_neutral[kRows];
+        int8_t upper_sad[kRows], lower_sad[kRows];
+        int8_t upper_fear[kRows], lower_fear[kRows];
+        int8_t upper_anger[kRows], lower_anger[kRows];
+        int8_t upper_disgust[kRows], lower_disgust[kRows];
+    };
+
+    constexpr EmotionShapes make_emotion_shapes() {
+        EmotionShapes e{};
+        constexpr int mid = kRows / 2;
+        for (int y = 0; y < kRows; ++y) {
             // Neutral all zero
-            upper_neutral[y] = 0; lower_neutral[y] = 0;
+            e.upper_neutral[y] = 0; e.lower_neutral[y] = 0;
             // Base ramps 0..1 top->mid and bottom->mid
-            float topFrac = (y < 64) ? (1.f - (float)y / 64.f) : 0.f; // 1 at row0 -> 0 at 64
-            float botFrac = (y >= 64) ? ((float)(y - 64) / 64.f) : 0.f; // 0 at 64 ->1 at 127
+            float topFrac = (y < mid) ? (1.f - (float)y / mid) : 0.f; // 1 at row0 -> 0 at mid
+            float botFrac = (y >= mid) ? ((float)(y - mid) / mid) : 0.f; // 0 at mid ->1 at last row
 
             // Sad: drooped upper lid moderately (+), slight raise lower (+ small)
-            upper_sad[y] = (int8_t)(topFrac * 12.f); // up to +12 at top
-            lower_sad[y] = (int8_t)(botFrac * 4.f);  // up to +4 at bottom
+            e.upper_sad[y] = (int8_t)(topFrac * 12.f); // up to +12 at top
+            e.lower_sad[y] = (int8_t)(botFrac * 4.f);  // up to +4 at bottom
 
             // Fear: retracted upper (negative), retracted lower (negative)
-            upper_fear[y] = (int8_t)(-topFrac * 15.f); // -15 to 0
-            lower_fear[y] = (int8_t)(-botFrac * 10.f); // -10 to 0
+            e.upper_fear[y] = (int8_t)(-topFrac * 15.f); // -15 to 0
+            e.lower_fear[y] = (int8_t)(-botFrac * 10.f); // -10 to 0
 
             // Anger: lowered upper strongly (+), lower near neutral slight raise (+ small)
-            upper_anger[y] = (int8_t)(topFrac * 18.f); // +18 top
-            lower_anger[y] = (int8_t)(botFrac * 3.f);  // +3 bottom
+            e.upper_anger[y] = (int8_t)(topFrac * 18.f); // +18 top
+            e.lower_anger[y] = (int8_t)(botFrac * 3.f);  // +3 bottom
 
             // Disgust: slight upper raise (negative small), lower raise (positive moderate)
-            upper_disgust[y] = (int8_t)(-topFrac * 6.f);
-            lower_disgust[y] = (int8_t)(botFrac * 8.f);
+            e.upper_disgust[y] = (int8_t)(-topFrac * 6.f);
+            e.lower_disgust[y] = (int8_t)(botFrac * 8.f);
         }
+        return e;
     }
+    constexpr EmotionShapes g_shapes = make_emotion_shapes();
 }
 
 bool App::init() {
+    frame_ = g_frame;
     // SPI pin mux
-    gpio_set_function(pins::spi0_sck,  GPIO_FUNC_SPI);
-    gpio_set_function(pins::spi0_mosi, GPIO_FUNC_SPI);
-    if (pins::spi0_miso != 0xFF) gpio_set_function(pins::spi0_miso, GPIO_FUNC_SPI);
+    hal::pin_spi(pins::spi0_sck);
+    hal::pin_spi(pins::spi0_mosi);
+    if (pins::spi0_miso != 0xFF) hal::pin_spi(pins::spi0_miso);
 
     static SpiBus spi(spi0, 16 * 1000 * 1000);
     spi.init();
@@ -82,293 +107,631 @@ bool App::init() {
     spi.set_frequency(30 * 1000 * 1000);
     g_spi = &spi;
 
-    static Ssd1351Display left(spi, 128, 128, pins::left_cs,  pins::left_dc,  pins::left_res);
-    static Ssd1351Display right(spi,128, 128, pins::right_cs, pins::right_dc, pins::right_res);
-    if (!left.init() || !right.init()) return false;
+    using Oled = Ssd1351Display<Panel>;
+    static Oled left(spi,  pins::left_cs,  pins::left_dc,  pins::left_res);
+    static Oled right(spi, pins::right_cs, pins::right_dc, pins::right_res);
+    // Reset both panels together: the reset pulse, recovery and power-on settle are paid once rather
+    // than per panel, and the first frame renders while the panels settle.
+    left.begin_reset();
+    right.begin_reset();
+    hal::sleep_ms(Oled::kResetPulseMs);
+    left.end_reset();
+    right.end_reset();
+    hal::sleep_ms(Oled::kResetPulseMs);
+    if (!left.configure() || !right.configure()) return false;
+    absolute_time_t settled = make_timeout_time_ms(Oled::kPowerOnSettleMs);
+    uint64_t panels_us = time_us_64();
     g_left = &left;
     g_right = &right;
+    left.set_color_pipeline(&color_);
+    right.set_color_pipeline(&color_);
     left_ = g_left;
     right_ = g_right;
+#if PME_FRAME_CAPTURE
+    // Stream what the left panel is sent over the stdio UART (tools/capture_decode.py, docs/capture.md)
+    static FrameCapture capture(uart_default, PME_CAPTURE_BAUD);
+    if (capture.init()) {
+        left.set_capture(&capture, 0);
+        right.set_capture(&capture, 1);
+    }
+#endif
+
+    // Live control channel; the eyes still run if it is unavailable
+    static UartRxRing ctrl(uart1, pins::ctrl_uart_baud, pins::ctrl_uart_tx, pins::ctrl_uart_rx);
+    if (ctrl.init()) ctrl_ = &ctrl;
+    // Presence sensor for target tracking; without one the gaze stays procedural
+#if PME_FAKE_PRESENCE
+    static FakePresenceSensor presence;
+#else
+    static Amg8833Sensor presence(i2c0, pins::sensor_i2c_baud, pins::sensor_i2c_sda, pins::sensor_i2c_scl);
+#endif
+    if (presence.init()) presence_ = &presence;
+#if PME_ASSET_STREAMING
+    // Eye styles streamed from an asset pack on the SD card (tools/asset_pack.py, docs/asset_streaming.md);
+    // without a card only the built-in styles exist
+    static SdSpiBlockDevice sd(spi1, pins::sd_sck, pins::sd_mosi, pins::sd_miso, pins::sd_cs);
+    static BlockCache asset_cache(sd);
+    static AssetPack pack(asset_cache);
+    static StyleStream style_stream(pack, g_style_arena, sizeof g_style_arena);
+    if (sd.init() && pack.open()) {
+        asset_cache_ = &asset_cache;
+        style_stream_ = &style_stream;
+        printf("assets: %d streamed styles in pack (card %lu blocks)\n", pack.style_count(),
+               (unsigned long)sd.block_count());
+    }
+#endif
 
-    Rect full{0,0,kFrameW,kFrameH};
-    params_left_ = EyeRenderParams{};
-    params_right_ = EyeRenderParams{};
     // Mirror eyelids for LEFT eye so medial canthus (already on left side of mask) faces inward between displays.
-    params_left_.mirror_eyelids = true;
-    params_right_.mirror_eyelids = false;
-    init_emotion_shapes();
-    render_eye(frame_, params_left_);
-    left_->blit(frame_, full);
-    render_eye(frame_, params_right_);
-    right_->blit(frame_, full);
+    add_eye(left_, EyeMount{-kInterocularMm * 0.5f, -1}, true);
+    add_eye(right_, EyeMount{kInterocularMm * 0.5f, 0}, false);
+    apply_style(styles::default_eye());
+    // First frame: default-radius LUTs are in flash, so this is only the pixel work
+    for (int i = 0; i < eye_count_; ++i) eyes_[i].tick(anim_);
+    const auto& sprite = render_iris_sprite<Panel>(eyes_[0].params());
+    for (int i = 0; i < eye_count_; ++i) {
+        eyes_[i].render(frame_, sprite);
+        if (i == 0) sleep_until(settled);
+        eyes_[i].present(frame_);
+    }
+    uint64_t first_frame_us = time_us_64();
+    printf("boot: first frame %llu us after reset (panels configured at %llu us)\n",
+           (unsigned long long)first_frame_us, (unsigned long long)panels_us);
     return true;
 }
 
-void App::choose_new_target() {
-    // Constrain target so full iris stays on screen.
-    int minC = (int)params_left_.iris_radius;
-    int maxC = kFrameW - minC;
-    // Biased sampling: favor central region slightly.
-    auto sample_axis = [&](int minV, int maxV) {
-        float r = rand01();
-        // Smoothstep bias toward 0.5
-        float b = r*r*(3 - 2*r);
-        return (float)minV + b * (float)(maxV - minV);
-    };
-    gaze_sx_ = gaze_cx_;
-    gaze_sy_ = gaze_cy_;
-    gaze_tx_ = sample_axis(minC, maxC);
-    gaze_ty_ = sample_axis(minC, maxC);
-    // Saccade duration: small angle -> shorter jump.
-    float dx = gaze_tx_ - gaze_sx_;
-    float dy = gaze_ty_ - gaze_sy_;
-    float dist = std::sqrt(dx*dx + dy*dy);
-    saccade_duration_ = 0.04f + 0.06f * (dist / 24.f); // 40-100ms typical
-    if (saccade_duration_ > 0.12f) saccade_duration_ = 0.12f;
-    saccade_timer_ = 0.f;
+void App::add_eye(Display* display, const EyeMount& mount, bool mirror_eyelids) {
+    int slot = anim_.add_eye(mount);
+    if (slot < 0) return;
+    Eye<Panel>& eye = eyes_[eye_count_++];
+    eye.bind(display, slot);
+    EyeRenderParams& p = eye.params();
+    p = EyeRenderParams{};
+    // Assets are authored for 128x128; the style sets the panel-scaled iris size
+    p.iris_center_x = kFrameW / 2;
+    p.iris_center_y = kFrameH / 2;
+    p.spherical = true;
+    p.antialias = true;
+    p.sclera_parallax = 1.0f;
+    p.mirror_eyelids = mirror_eyelids;
+}
+
+void App::set_brightness(float level) {
+    color_base_.brightness = (uint8_t)std::lround(clamp_fallback(level, 0.f, 1.f) * 255.f);
+}
+
+void App::set_gamma(float gamma) {
+    color_base_.gamma_x256 = (uint16_t)std::lround(clamp_fallback(gamma, 0.25f, 4.f) * 256.f);
 }
 
 void App::advance_emotion() {
-    prev_emotion_ = emotion_;
     int idx = static_cast<int>(emotion_);
     idx = (idx + 1) % static_cast<int>(Emotion::COUNT);
-    emotion_ = static_cast<Emotion>(idx);
+    set_emotion(static_cast<Emotion>(idx));
+}
+
+void App::set_emotion(Emotion e) {
+    prev_emotion_ = emotion_;
+    emotion_ = e;
     emotion_timer_ = 0.f;
     emotion_fade_ = 0.f; // restart fade
 }
 
-void App::loop() {
-    Rect full{0,0,kFrameW,kFrameH};
-    while (true) {
-    // Real time delta using hardware timer
-    if (!last_time_us_) last_time_us_ = time_us_64();
-    uint64_t now_us = time_us_64();
-    float dt = (now_us - last_time_us_) * 1e-6f;
-        if (dt <= 0.f) dt = 0.0005f; // guard
-        t_ += dt;
-    last_time_us_ = now_us;
-        // Emotion cycling timer
-        emotion_timer_ += 0.02f;
-        if (emotion_timer_ >= emotion_cycle_len_) {
-            advance_emotion();
-        }
+bool App::set_style(const EyeStyle& style) {
+    if (style_switch_ != StyleSwitch::Idle || &style == eyes_[0].params().style) return false;
+    style_to_ = &style;
+    style_switch_ = StyleSwitch::Preparing;
+    return true;
+}
 
-        // Advance cross-fade
-        if (emotion_fade_ < 1.f) {
-            emotion_fade_ += 0.02f / emotion_fade_duration_;
-            if (emotion_fade_ > 1.f) emotion_fade_ = 1.f;
-        }
+bool App::set_streamed_style(int index) {
+    if (!style_stream_ || style_switch_ != StyleSwitch::Idle) return false;
+    const EyeStyle& slot = style_stream_->style();
+    if (eyes_[0].params().style == &slot) return false;
+    // The slot's previous style may still have LUTs cached under the same address
+    forget_eye_style<Panel>(slot);
+    if (!style_stream_->begin(index)) return false;
+    style_to_ = &slot;
+    style_load_start_us_ = time_us_32();
+    style_switch_ = StyleSwitch::Loading;
+    return true;
+}
 
-        // Emotion influences (modulate parameters heuristically) computed for both prev and current to blend:
-        // Sad: slower saccades, longer fixations, narrower pupil, half-lidded
-        // Fear: rapid small saccades, shorter fixations, dilated pupil, eyelids more open (wider)
-        // Anger: focused shorter fixations, medium-fast saccades, slight constrict, upper lid lowered
-        // Disgust: biased upward gaze, moderate speed, some constrict, slight upper lid raise and lower lid raise.
-        struct EmoParams { float fix_scale, sacc_scale, pupil_bias, eyelid_bias, gaze_bx, gaze_by; uint16_t tint_col; float tint_strength; int8_t* upper; int8_t* lower; bool tint_on; };
-        auto compute = [&](Emotion e){
-            EmoParams ep{1.f,1.f,0.f,0.f,0.f,0.f,0,0.f, upper_neutral, lower_neutral,false};
-            switch(e){
-                case Emotion::Sad:
-                    ep.fix_scale=1.6f; ep.sacc_scale=0.6f; ep.pupil_bias=-0.1f; ep.eyelid_bias=-0.25f; ep.gaze_by=4.f; ep.tint_on=true; ep.tint_col=0x4210; ep.tint_strength=0.15f; ep.upper=upper_sad; ep.lower=lower_sad; break;
-                case Emotion::Fear:
-                    ep.fix_scale=0.6f; ep.sacc_scale=1.4f; ep.pupil_bias=+0.18f; ep.eyelid_bias=+0.15f; ep.gaze_by=-3.f; ep.tint_on=true; ep.tint_col=0x57FF; ep.tint_strength=0.18f; ep.upper=upper_fear; ep.lower=lower_fear; break;
-                case Emotion::Anger:
-                    ep.fix_scale=0.8f; ep.sacc_scale=1.2f; ep.pupil_bias=-0.05f; ep.eyelid_bias=-0.10f; ep.gaze_bx=+2.f; ep.tint_on=true; ep.tint_col=0xF880; ep.tint_strength=0.22f; ep.upper=upper_anger; ep.lower=lower_anger; break;
-                case Emotion::Disgust:
-                    ep.fix_scale=1.1f; ep.sacc_scale=0.9f; ep.pupil_bias=-0.07f; ep.eyelid_bias=-0.05f; ep.gaze_by=-4.f; ep.tint_on=true; ep.tint_col=0x07E0; ep.tint_strength=0.20f; ep.upper=upper_disgust; ep.lower=lower_disgust; break;
-                case Emotion::Neutral: default:
-                    break;
-            }
-            return ep;
-        };
-        EmoParams prevp = compute(prev_emotion_);
-        EmoParams curp  = compute(emotion_);
-        // Apply smootherstep easing to emotion fade for more natural transitions
-        float f = emotion_fade_;
-        {
-            float x = f; // smootherstep (quintic) 6x^5 -15x^4 +10x^3
-            f = x * x * x * (x * (x * 6.f - 15.f) + 10.f);
+void App::apply_style(const EyeStyle& style) {
+    float r = style_iris_radius<Panel>(style);
+    for (int i = 0; i < eye_count_; ++i) {
+        eyes_[i].params().style = &style;
+        eyes_[i].params().iris_radius = r;
+        eyes_[i].params().pupil_shape = style.pupil_shape;
+    }
+    // Constrain gaze so the full iris stays on screen
+    anim_.set_gaze_margin((int)r);
+}
+
+void App::update_style_switch() {
+    if (style_switch_ == StyleSwitch::Loading) {
+        if (style_stream_->failed()) {
+            printf("assets: loading style %s failed (read errors %lu)\n", style_to_->name,
+                   (unsigned long)asset_cache_->device().errors());
+            style_switch_ = StyleSwitch::Idle;
+        } else if (!style_stream_->loading()) {
+            const BlockCache::Stats& st = asset_cache_->stats();
+            printf("assets: style %s, %lu bytes in %lu ms (cache hits %lu, misses %lu, read ahead %lu)\n",
+                   style_to_->name, (unsigned long)style_stream_->total_bytes(),
+                   (unsigned long)((time_us_32() - style_load_start_us_) / 1000), (unsigned long)st.hits,
+                   (unsigned long)st.misses, (unsigned long)st.prefetched);
+            asset_cache_->reset_stats();
+            style_switch_ = StyleSwitch::Preparing;
         }
-        auto lerp = [&](float a,float b){return a + (b-a)*f;};
-        float emotion_fixation_scale = lerp(prevp.fix_scale, curp.fix_scale);
-        float emotion_saccade_speed_scale = lerp(prevp.sacc_scale, curp.sacc_scale);
-        float emotion_pupil_bias = lerp(prevp.pupil_bias, curp.pupil_bias);
-        float eyelid_open_bias = lerp(prevp.eyelid_bias, curp.eyelid_bias);
-        float gaze_bias_x = lerp(prevp.gaze_bx, curp.gaze_bx);
-        float gaze_bias_y = lerp(prevp.gaze_by, curp.gaze_by);
-        // Blend tint: if either has tint, enable and blend color in RGB565 space component-wise.
-        if (prevp.tint_on || curp.tint_on) {
-            params_left_.tint_enabled = true; params_right_.tint_enabled = true;
-            // Extract components
-            int pr = (prevp.tint_col >> 11) & 0x1F; int pg = (prevp.tint_col >> 5) & 0x3F; int pb = prevp.tint_col & 0x1F;
-            int cr = (curp.tint_col >> 11) & 0x1F; int cg = (curp.tint_col >> 5) & 0x3F; int cb = curp.tint_col & 0x1F;
-            int r = (int)(pr + (cr - pr) * f + 0.5f);
-            int g = (int)(pg + (cg - pg) * f + 0.5f);
-            int b = (int)(pb + (cb - pb) * f + 0.5f);
-            if (r<0) r=0; if(r>31) r=31; if(g<0) g=0; if(g>63) g=63; if(b<0) b=0; if(b>31) b=31;
-            uint16_t blend_col = (uint16_t)((r<<11)|(g<<5)|b);
-            float blend_str = lerp(prevp.tint_strength, curp.tint_strength);
-            params_left_.tint_color = blend_col; params_right_.tint_color = blend_col;
-            params_left_.tint_strength = blend_str; params_right_.tint_strength = blend_str;
-        } else {
-            params_left_.tint_enabled = false; params_right_.tint_enabled = false; params_left_.tint_strength = 0.f; params_right_.tint_strength = 0.f;
+    } else if (style_switch_ == StyleSwitch::Preparing) {
+        EyeRenderParams p = eyes_[0].params();
+        p.style = style_to_;
+        p.iris_radius = style_iris_radius<Panel>(*style_to_);
+        bool ready;
+        { perf::Scope ps(perf::Section::StyleBuild); ready = prepare_eye_style<Panel>(p, kStyleBuildBudgetUs, time_us_32); }
+        if (ready) {
+            style_from_ = eyes_[0].params().style;
+            apply_style(*style_to_);
+            style_fade_ = 0.f;
+            style_switch_ = StyleSwitch::Fading;
         }
-        // Shape blend: create temp blended arrays (static to avoid stack) and point to them.
-        static int8_t upper_blend[128];
-        static int8_t lower_blend[128];
-        for (int y=0;y<128;++y){
-            float u = prevp.upper[y] + (curp.upper[y]-prevp.upper[y])*f;
-            float l = prevp.lower[y] + (curp.lower[y]-prevp.lower[y])*f;
-            if (u < -128.f) u = -128.f; if (u > 127.f) u = 127.f;
-            if (l < -128.f) l = -128.f; if (l > 127.f) l = 127.f;
-            upper_blend[y] = (int8_t) (int) std::lround(u);
-            lower_blend[y] = (int8_t) (int) std::lround(l);
+    } else if (style_switch_ == StyleSwitch::Fading) {
+        style_fade_ += 0.02f / kStyleFadeDuration;
+        if (style_fade_ >= 1.f) { style_fade_ = 1.f; style_switch_ = StyleSwitch::Idle; }
+    }
+}
+
+void App::poll_commands() {
+    if (!ctrl_) return;
+    // Drain whatever arrived since the last frame; the parser keeps partial frames between calls
+    uint8_t b; uint32_t stamp;
+    Command cmd;
+    while (ctrl_->read(b, stamp)) {
+        if (ctrl_parser_.feed(b, stamp, cmd)) apply_command(cmd);
+    }
+}
+
+void App::apply_command(const Command& cmd) {
+    switch (cmd.type) {
+        case CommandType::LookAt: {
+            float x = kFrameW * 0.5f + cmd.i16(0) * (1.f / 16.f) * kFrameW / kAssetRefW;
+            float y = kFrameH * 0.5f + cmd.i16(2) * (1.f / 16.f) * kFrameH / kAssetRefH;
+            look_at(x, y, (float)cmd.u16(4));
+            ctrl_look_ = true;
+        } break;
+        case CommandType::ReleaseLook:
+            release_look();
+            ctrl_look_ = false;
+            break;
+        case CommandType::Emotion:
+            if (cmd.payload[0] < static_cast<uint8_t>(Emotion::COUNT) && static_cast<Emotion>(cmd.payload[0]) != emotion_) {
+                set_emotion(static_cast<Emotion>(cmd.payload[0]));
+            }
+            break;
+        case CommandType::Blink:
+            anim_.request_blink();
+            break;
+        case CommandType::AudioCue:
+            if (on_audio_cue_) on_audio_cue_(cmd.payload[0], cmd.payload[1] * (1.f / 255.f));
+            break;
+        case CommandType::Style:
+            if (cmd.payload[0] < eye_style_count()) set_style(eye_style(cmd.payload[0]));
+            else set_streamed_style(cmd.payload[0] - eye_style_count());
+            break;
+        case CommandType::Glow:
+            set_iris_glow(cmd.u16(0), cmd.payload[2] * (1.f / 255.f), cmd.payload[3] * 0.1f);
+            break;
+    }
+    if (!ctrl_pending_) { ctrl_pending_ = true; ctrl_pending_us_ = cmd.received_us; }
+}
+
+void App::note_command_blitted() {
+    if (!ctrl_pending_) return;
+    ctrl_pending_ = false;
+    uint32_t lat = time_us_32() - ctrl_pending_us_;
+    ctrl_lat_sum_us_ += lat;
+    if (lat > ctrl_lat_max_us_) ctrl_lat_max_us_ = lat;
+    if (++ctrl_lat_count_ == 16) {
+        printf("ctrl: cmd->photon avg %lu max %lu us (parse errors %lu, rx overruns %lu)\n",
+               (unsigned long)(ctrl_lat_sum_us_ / ctrl_lat_count_), (unsigned long)ctrl_lat_max_us_,
+               (unsigned long)ctrl_parser_.errors(), (unsigned long)ctrl_->overruns());
+        ctrl_lat_count_ = 0; ctrl_lat_sum_us_ = 0; ctrl_lat_max_us_ = 0;
+    }
+}
+
+void App::poll_presence(uint32_t now_us, float dt) {
+    if (!presence_) return;
+    presence_->poll(now_us);
+    PresenceReading r;
+    if (presence_->take(r)) tracker_.add(r);
+    const GazeTracker::Action a = tracker_.step(dt, now_us);
+    if (timeline_gaze_ || ctrl_look_) { sensor_look_ = false; return; } // they own the gaze
+    if (a == GazeTracker::Action::Release) {
+        if (sensor_look_) release_look();
+        sensor_look_ = false;
+        return;
+    }
+    // Re-aim on a Look, or take the gaze back after a command or timeline let go of it
+    if (a == GazeTracker::Action::Look || (tracker_.tracking() && !sensor_look_)) {
+        look_at(tracker_.x(), tracker_.y(), tracker_.distance_mm());
+        sensor_look_ = true;
+        if (!sensor_pending_) { sensor_pending_ = true; sensor_pending_us_ = tracker_.reading_stamp_us(); }
+    }
+}
+
+void App::note_sensor_blitted() {
+    if (!sensor_pending_) return;
+    sensor_pending_ = false;
+    uint32_t lat = time_us_32() - sensor_pending_us_;
+    sensor_lat_sum_us_ += lat;
+    if (lat > sensor_lat_max_us_) sensor_lat_max_us_ = lat;
+    if (++sensor_lat_count_ == 16) {
+        printf("sensor: sample->gaze avg %lu max %lu us (sensor errors %lu)\n",
+               (unsigned long)(sensor_lat_sum_us_ / sensor_lat_count_), (unsigned long)sensor_lat_max_us_,
+               (unsigned long)presence_->errors());
+        sensor_lat_count_ = 0; sensor_lat_sum_us_ = 0; sensor_lat_max_us_ = 0;
+    }
+}
+
+uint64_t App::timeline_clock() const {
+    if (audio_) return audio_->samples_played();
+    // No audio output: derive the same sample timebase from the microsecond timer
+    return time_us_64() * timeline_.sample_rate() / 1000000u;
+}
+
+void App::set_audio(AudioOutput* audio, AudioCueHandler on_cue) {
+    if (audio_ && audio_ != audio) audio_->set_analyzer(nullptr);
+    audio_ = audio;
+    on_audio_cue_ = on_cue;
+    if (audio_) audio_->set_analyzer(&audio_env_);
+}
+
+void App::react_to_audio(uint64_t now_us, float dt, AnimInputs& in) {
+    if (!audio_) return;
+    AudioLevels lv;
+    const float env_before = audio_levels_.envelope;
+    const bool fresh = audio_env_.read(lv) && lv.blocks != audio_levels_.blocks;
+    if (fresh) { audio_levels_ = lv; audio_seen_us_ = now_us; }
+    const bool live = audio_levels_.blocks && now_us - audio_seen_us_ < kAudioStaleUs;
+    // Pupils: constrict with loudness; mid and high band sound counts half as much as a growl
+    if (live) {
+        const float rms = audio_levels_.rms ? audio_levels_.rms : 1.f;
+        const float low_share = clamp_fallback(audio_levels_.band[0] / rms, 0.f, 1.f);
+        const float level = clamp_fallback(audio_levels_.envelope / kAudioFullLevel, 0.f, 1.f);
+        in.pupil_bias -= kAudioPupilConstrict * level * (0.5f + 0.5f * low_share);
+    }
+    // Lids: flinch at an onset, then recover; no new flinch until mostly recovered
+    if (fresh && audio_flinch_ < 0.3f && lv.peak >= kAudioFlinchPeak && lv.peak > kAudioFlinchJump * env_before)
+        audio_flinch_ = 1.f;
+    if (audio_flinch_ > 0.f) {
+        in.eyelid_bias -= kAudioFlinchClose * audio_flinch_;
+        audio_flinch_ -= dt / kAudioFlinchS;
+        if (audio_flinch_ < 0.f) audio_flinch_ = 0.f;
+    }
+}
+
+void App::set_iris_glow(uint16_t color, float strength, float pulse_hz) {
+    glow_color_ = color;
+    glow_strength_ = std::clamp(strength, 0.f, 1.f);
+    glow_pulse_hz_ = std::max(pulse_hz, 0.f);
+}
+
+void App::update_glow(float dt) {
+    const EyeStyle& s = style();
+    uint32_t alpha = 0;
+    if (!s.iris_map && s.indexed && glow_strength_ > 0.f) {
+        glow_phase_ += dt * glow_pulse_hz_;
+        glow_phase_ -= std::floor(glow_phase_);
+        const float pulse = glow_pulse_hz_ > 0.f ? 0.5f - 0.5f * std::cos(2.f * 3.14159265f * glow_phase_) : 1.f;
+        alpha = (uint32_t)(glow_strength_ * pulse * 32.f + 0.5f);
+    }
+    // The whole recolour: kPaletteSize entries, not a pixel of the iris
+    if (alpha) glow_palette(glow_palette_, s.indexed->iris_palette, glow_color_, alpha);
+    glow_alpha_ = (uint8_t)alpha;
+    for (int i = 0; i < eye_count_; ++i) eyes_[i].params().iris_palette = alpha ? glow_palette_ : nullptr;
+}
+
+bool App::play_timeline(const uint8_t* data, size_t len) {
+    if (!timeline_.load(data, len)) return false;
+    timeline_.start(timeline_clock());
+    return true;
+}
+
+void App::stop_timeline() {
+    timeline_.stop();
+    if (timeline_gaze_) { timeline_gaze_ = false; release_look(); }
+}
+
+void App::render_eyes() {
+    // Style cross-fade: the outgoing style renders from its own cache slot with its own iris size
+    const bool style_fading = style_switch_ == StyleSwitch::Fading;
+    const float from_r = style_fading ? style_iris_radius<Panel>(*style_from_) : 0.f;
+    uint32_t from_alpha = 0;
+    if (style_fading) {
+        float x = style_fade_;
+        from_alpha = (uint32_t)((1.f - x * x * (3.f - 2.f * x)) * 32.f + 0.5f);
+    }
+    // One iris sprite per leader group (followers share the leader's pupil), rendered only where
+    // some eye of the group shows through its lids, then composited at each member's own position.
+    for (int l = 0; l < eye_count_; ++l) {
+        if (anim_.leader(eyes_[l].slot()) != eyes_[l].slot()) continue;
+        CulledEye<Panel> culled[EyeAnimator::kMaxEyes];
+        int member[EyeAnimator::kMaxEyes];
+        int n = 0;
+        for (int i = l; i < eye_count_; ++i) {
+            if (anim_.leader(eyes_[i].slot()) != eyes_[l].slot()) continue;
+            culled[n] = {&eyes_[i].params(), &eyes_[i].spans()};
+            member[n++] = i;
         }
-    params_left_.upper_shape_adjust = upper_blend; params_right_.upper_shape_adjust = upper_blend;
-    params_left_.lower_shape_adjust = lower_blend; params_right_.lower_shape_adjust = lower_blend;
-        // Gaze state machine: fixation -> saccade
-        if (saccade_duration_ <= 0.f && fixation_timer_ <= 0.f) {
-            // Initialize first fixation interval
-            fixation_timer_ = 0.f;
-            next_fixation_duration_ = 0.8f + rand01() * 1.4f; // 0.8 - 2.2s
-            choose_new_target(); // sets target & saccade params (not yet moving)
+        const IrisSprite<Panel>* iris;
+        { perf::Scope ps(perf::Section::IrisSprite); iris = &group_iris(eyes_[l].params(), culled, n); }
+        EyeRenderParams from_lead;
+        const IrisSprite<Panel>* iris_from = nullptr;
+        if (style_fading) {
+            from_lead = eyes_[l].params(); from_lead.style = style_from_; from_lead.iris_radius = from_r;
+            from_lead.pupil_shape = style_from_->pupil_shape;
+            from_lead.iris_palette = nullptr;   // the glow palette is the incoming style's
+            { perf::Scope ps(perf::Section::IrisSprite); iris_from = &render_iris_sprite<Panel>(from_lead); }
         }
-        if (saccade_duration_ > 0.f && saccade_timer_ < saccade_duration_) {
-            // In saccade (ballistic interpolation with ease-in/out to avoid stepping artifacts visually)
-            saccade_timer_ += 0.02f * emotion_saccade_speed_scale; // speed scale
-            float k = saccade_timer_ / saccade_duration_;
-            if (k > 1.f) k = 1.f;
-            // Fast accel/decel curve approximating main-sequence velocity profile
-            float ease = k * k * (3 - 2*k);
-            gaze_cx_ = gaze_sx_ + (gaze_tx_ - gaze_sx_) * ease;
-            gaze_cy_ = gaze_sy_ + (gaze_ty_ - gaze_sy_) * ease;
-            if (k >= 1.f) {
-                // Start fixation
-                fixation_timer_ = 0.f;
-                next_fixation_duration_ = (0.8f + rand01() * 1.4f) * emotion_fixation_scale;
-                // Choose new pupil dilation target proportional to upcoming fixation length
-                float lenNorm = (next_fixation_duration_ - 0.8f) / 1.4f; // 0..1
-                float base = 0.9f + lenNorm * 0.3f; // 0.9 .. 1.2
-                base *= (0.95f + rand01() * 0.10f); // +/-5%
-                if (base < 0.75f) base = 0.75f; else if (base > 1.25f) base = 1.25f;
-                pupil_scale_target_ = base + emotion_pupil_bias;
-                saccade_duration_ = 0.f;
-            }
-        } else {
-            // In fixation
-            fixation_timer_ += 0.02f;
-            // Small tremor / drift noise
-            float microX = (rand01() - 0.5f) * 0.6f; // +/-0.3 px
-            float microY = (rand01() - 0.5f) * 0.6f;
-            gaze_cx_ += (microX * 0.15f); // integrate tiny noise for subtle motion
-            gaze_cy_ += (microY * 0.15f);
-            // Clamp to valid region
-            int minC = (int)params_left_.iris_radius;
-            int maxC = kFrameW - minC;
-            if (gaze_cx_ < minC) gaze_cx_ = (float)minC; else if (gaze_cx_ > maxC) gaze_cx_ = (float)maxC;
-            if (gaze_cy_ < minC) gaze_cy_ = (float)minC; else if (gaze_cy_ > maxC) gaze_cy_ = (float)maxC;
-            if (fixation_timer_ >= next_fixation_duration_) {
-                choose_new_target(); // defines new target & saccade
+        for (int k = 0; k < n; ++k) {
+            Eye<Panel>& eye = eyes_[member[k]];
+            // The fade blends over every pixel of frame_, so it needs all rows in RAM
+            FrameRows<Panel>* rows = iris_from ? nullptr : &g_rows;
+            eye.render(frame_, *iris, rows);
+            if (iris_from) {
+                EyeRenderParams from = eye.params(); from.style = style_from_; from.iris_radius = from_r;
+                const perf::Section compose = from.spherical ? perf::Section::ComposeSphere : perf::Section::Compose;
+                { perf::Scope ps(compose); compose_eye<Panel>(g_fade_frame, *iris_from, from); }
+                { perf::Scope ps(perf::Section::Eyelids); apply_eyelids<Panel>(g_fade_frame, from); }
+                px::blend(frame_, g_fade_frame, from_alpha, Panel::kPixels);
             }
+            // A fade frame is sent whole, and the next one too: its covered rows held the old style
+            eye.present(frame_, rows, !iris_from && quality_.at_least(QualityTier::ReducedRegion));
+            if (iris_from) eye.invalidate();
+            note_command_blitted();
+            note_sensor_blitted();
         }
+    }
+}
 
-    // Pupil dilation update
-        if (saccade_duration_ <= 0.f || saccade_timer_ >= saccade_duration_) {
-            float diff = pupil_scale_target_ - pupil_scale_cur_;
-            pupil_scale_cur_ += diff * 0.05f; // approach target smoothly
-        }
-        pupil_breath_phase_ += 0.02f * 0.6f; // slow breathing phase
-        float breath = std::sin(pupil_breath_phase_) * 0.02f; // +/-2%
-    float pupil_final = pupil_scale_cur_ + breath + emotion_pupil_bias * 0.3f; // soften bias into final (cross-faded)
-        if (pupil_final < 0.6f) pupil_final = 0.6f; else if (pupil_final > 1.4f) pupil_final = 1.4f;
-
-    int iris_cx = (int)std::lround(gaze_cx_ + gaze_bias_x);
-    int iris_cy = (int)std::lround(gaze_cy_ + gaze_bias_y);
-        params_left_.iris_center_x = iris_cx; params_right_.iris_center_x = iris_cx;
-        params_left_.iris_center_y = iris_cy; params_right_.iris_center_y = iris_cy;
-        params_left_.pupil_scale = pupil_final; params_right_.pupil_scale = pupil_final;
-        params_left_.sclera_parallax = 1.0f; params_right_.sclera_parallax = 1.0f;
-
-        // Motion activity metric (EMA of gaze velocity)
-        float vx = (gaze_cx_ - prev_gaze_cx_); // px per frame (20ms)
-        float vy = (gaze_cy_ - prev_gaze_cy_);
-        float inst_speed = std::sqrt(vx*vx + vy*vy); // px / frame
-        prev_gaze_cx_ = gaze_cx_;
-        prev_gaze_cy_ = gaze_cy_;
-        // Convert to approx px/sec (frame dt=0.02)
-        float inst_speed_ps = inst_speed * 50.f;
-        // Normalize: assume 0..500 px/sec typical range, clamp
-        float norm = inst_speed_ps / 500.f;
-        if (norm > 1.f) norm = 1.f;
-        // Exponential moving average toward norm
-        activity_level_ += (norm - activity_level_) * 0.08f;
-
-        // Randomized blink scheduling state machine
-        float open;
-        if (t_ >= next_blink_time_ && blink_state_ == BlinkState::Idle) {
-            blink_state_ = BlinkState::Closing;
-            blink_timer_ = 0.f;
-        }
-        switch (blink_state_) {
-            case BlinkState::Idle:
-                open = 1.f; break;
-            case BlinkState::Closing: {
-                blink_timer_ += 0.02f;
-                float k = blink_timer_ / blink_close_dur_;
-                if (k > 1.f) { k = 1.f; blink_state_ = BlinkState::Hold; blink_timer_ = 0.f; }
-                k = k*k*(3-2*k);
-                open = 1.f - k;
-            } break;
-            case BlinkState::Hold: {
-                blink_timer_ += 0.02f;
-                open = 0.f;
-                if (blink_timer_ >= blink_hold_dur_) { blink_state_ = BlinkState::Opening; blink_timer_ = 0.f; }
-            } break;
-            case BlinkState::Opening: {
-                blink_timer_ += 0.02f;
-                float k = blink_timer_ / blink_open_dur_;
-                if (k > 1.f) { k = 1.f; blink_state_ = BlinkState::Idle; blink_timer_ = 0.f; 
-                    // Schedule next blink with jitter
-                    float interval = blink_period_base_ + rand01() * blink_period_jitter_;
-                    next_blink_time_ = t_ + interval; }
-                k = k*k*(3-2*k);
-                open = k;
-            } break;
+// The group's iris sprite. At QualityTier::CachedIris the last one is reused until the pupil has
+// moved kIrisCachePupilPx or anything else it depends on changes; it is then rendered whole (not
+// culled to this frame's lids), so later frames can show any part of it.
+const IrisSprite<Panel>& App::group_iris(const EyeRenderParams& lead, const CulledEye<Panel>* culled, int n) {
+    // The sprite lives in the style's cache slot, which every group's render overwrites: only one
+    // group may keep it
+    bool one_group = true;
+    for (int i = 1; i < eye_count_; ++i) one_group = one_group && anim_.leader(eyes_[i].slot()) == anim_.leader(eyes_[0].slot());
+    if (!quality_.at_least(QualityTier::CachedIris) || style_switch_ != StyleSwitch::Idle || !one_group) {
+        iris_key_.valid = false;
+        return render_iris_sprite<Panel>(lead, culled, n);
+    }
+    IrisKey key;
+    key.valid = true;
+    key.style = lead.style;
+    key.iris_r = lead.iris_radius;
+    key.pupil_r = lead.base_pupil_fraction * lead.iris_radius * std::clamp(lead.pupil_scale, 0.1f, 2.0f);
+    key.shape = lead.pupil_shape;
+    key.secondary = lead.highlight_secondary;
+    key.antialias = lead.antialias;
+    key.glow = glow_alpha_;
+    key.glow_color = glow_alpha_ ? glow_color_ : 0;
+    if (iris_key_.valid && key.style == iris_key_.style && key.iris_r == iris_key_.iris_r && key.shape == iris_key_.shape &&
+        key.secondary == iris_key_.secondary && key.antialias == iris_key_.antialias && key.glow == iris_key_.glow &&
+        key.glow_color == iris_key_.glow_color && std::fabs(key.pupil_r - iris_key_.pupil_r) < kIrisCachePupilPx) {
+        return *iris_cached_;
+    }
+    iris_key_ = key;
+    iris_cached_ = &render_iris_sprite<Panel>(lead);
+    return *iris_cached_;
+}
+
+void App::loop() {
+    // Cooperative tasks (src/scheduler.hpp). Commands and the sensor are polled between frames on
+    // their own periods, so neither waits for the other; idle time sleeps in WFE until the next release.
+    static PicoClock clock;
+    static Scheduler sched(clock);
+    sched_ = &sched;
+    // Added in priority order for equal deadlines: a command due with a frame lands in that frame
+    sched.add("ctrl", [](void* app, uint64_t) { static_cast<App*>(app)->poll_commands(); },
+              this, kCommandPeriodUs, kFramePeriodUs);
+    sensor_task_ = sched.add("sensor", [](void* app, uint64_t now) { static_cast<App*>(app)->sensor_task(now); },
+                             this, kSensorPeriodUs, kFramePeriodUs);
+    if (asset_cache_) {
+        asset_task_ = sched.add("assets", [](void* app, uint64_t) { static_cast<App*>(app)->asset_task(); },
+                                this, kAssetPeriodUs, kFramePeriodUs);
+    }
+    sched.add("frame", [](void* app, uint64_t now) { static_cast<App*>(app)->frame(now); }, this, kFramePeriodUs);
+    sched.add("stats", [](void* app, uint64_t) { static_cast<App*>(app)->report(); }, this, kSchedReportUs);
+    // A completed sensor read (DMA IRQ) wakes its task rather than waiting out the period
+    if (presence_) {
+        presence_->on_sample([](void* ctx) {
+            App* app = static_cast<App*>(ctx);
+            app->sched_->wake(app->sensor_task_);
+        }, this);
+    }
+    // Likewise a finished block transfer wakes the assets task to start the next one
+    if (asset_cache_) {
+        asset_cache_->device().on_transfer([](void* ctx) {
+            App* app = static_cast<App*>(ctx);
+            app->sched_->wake(app->asset_task_);
+        }, this);
+    }
+    while (true) sched.run_once();
+}
+
+void App::sensor_task(uint64_t now_us) {
+    float dt = last_sensor_us_ ? (now_us - last_sensor_us_) * 1e-6f : 0.f;
+    last_sensor_us_ = now_us;
+    poll_presence((uint32_t)now_us, dt);
+}
+
+void App::asset_task() {
+    asset_cache_->poll();
+    // The slot being loaded is never on screen, so it is filled here rather than in the frame
+    if (style_switch_ == StyleSwitch::Loading) style_stream_->step(kStyleLoadBudgetUs, time_us_32);
+}
+
+void App::frame(uint64_t now_us) {
+    // Real time delta using hardware timer
+    if (!last_time_us_) last_time_us_ = now_us;
+    float dt = (now_us - last_time_us_) * 1e-6f;
+    if (dt <= 0.f) dt = 0.0005f; // guard
+    last_time_us_ = now_us;
+    // Scripted timeline (sampled on the audio clock) overrides the procedural channels it has tracks for
+    TimelineFrame tl;
+    const bool scripted = timeline_.playing();
+    if (scripted) {
+        timeline_.evaluate(timeline_clock(), tl);
+        if (tl.has_emotion && tl.emotion < static_cast<uint8_t>(Emotion::COUNT) &&
+            static_cast<Emotion>(tl.emotion) != emotion_) {
+            set_emotion(static_cast<Emotion>(tl.emotion));
         }
-        if (blink_state_ == BlinkState::Idle && next_blink_time_ == 0.f) {
-            // Initialize first schedule
-            float interval = blink_period_base_ + rand01() * blink_period_jitter_;
-            next_blink_time_ = t_ + interval;
-            open = 1.f;
+        for (int i = 0; i < tl.cue_count; ++i) {
+            if (on_audio_cue_) on_audio_cue_(tl.cue_id[i], tl.cue_gain[i]);
         }
-    // Apply emotion eyelid bias and clamp (manual clamp; legacy std::clamp removed)
-        {
-            float eo = open + eyelid_open_bias;
-            if (eo < 0.f) eo = 0.f; else if (eo > 1.f) eo = 1.f;
-            params_left_.eyelid_open = eo; params_right_.eyelid_open = eo;
+        if (tl.has_gaze) { timeline_gaze_ = true; anim_.hold_gaze(); }
+        if (tl.finished) stop_timeline();
+    }
+    // Emotion cycling timer (paused while a timeline is playing)
+    if (!scripted) emotion_timer_ += 0.02f;
+    if (emotion_timer_ >= emotion_cycle_len_) {
+        advance_emotion();
+    }
+
+    // Style switch: a slice of the incoming style's LUT build, or the fade step
+    update_style_switch();
+    // Advance cross-fade
+    if (emotion_fade_ < 1.f) {
+        emotion_fade_ += 0.02f / emotion_fade_duration_;
+        if (emotion_fade_ > 1.f) emotion_fade_ = 1.f;
+    }
+
+    // Emotion influences (modulate parameters heuristically) computed for both prev and current to blend:
+    // Sad: slower saccades, longer fixations, narrower pupil, half-lidded
+    // Fear: rapid small saccades, shorter fixations, dilated pupil, eyelids more open (wider)
+    // Anger: focused shorter fixations, medium-fast saccades, slight constrict, upper lid lowered
+    // Disgust: biased upward gaze, moderate speed, some constrict, slight upper lid raise and lower lid raise.
+    struct EmoParams { float fix_scale, sacc_scale, pupil_bias, eyelid_bias, gaze_bx, gaze_by; uint16_t tint_col; float tint_strength; const int8_t* upper; const int8_t* lower; bool tint_on; };
+    auto compute = [&](Emotion e){
+        EmoParams ep{1.f,1.f,0.f,0.f,0.f,0.f,0,0.f, g_shapes.upper_neutral, g_shapes.lower_neutral,false};
+        switch(e){
+            case Emotion::Sad:
+                ep.fix_scale=1.6f; ep.sacc_scale=0.6f; ep.pupil_bias=-0.1f; ep.eyelid_bias=-0.25f; ep.gaze_by=4.f; ep.tint_on=true; ep.tint_col=0x4210; ep.tint_strength=0.15f; ep.upper=g_shapes.upper_sad; ep.lower=g_shapes.lower_sad; break;
+            case Emotion::Fear:
+                ep.fix_scale=0.6f; ep.sacc_scale=1.4f; ep.pupil_bias=+0.18f; ep.eyelid_bias=+0.15f; ep.gaze_by=-3.f; ep.tint_on=true; ep.tint_col=0x57FF; ep.tint_strength=0.18f; ep.upper=g_shapes.upper_fear; ep.lower=g_shapes.lower_fear; break;
+            case Emotion::Anger:
+                ep.fix_scale=0.8f; ep.sacc_scale=1.2f; ep.pupil_bias=-0.05f; ep.eyelid_bias=-0.10f; ep.gaze_bx=+2.f; ep.tint_on=true; ep.tint_col=0xF880; ep.tint_strength=0.22f; ep.upper=g_shapes.upper_anger; ep.lower=g_shapes.lower_anger; break;
+            case Emotion::Disgust:
+                ep.fix_scale=1.1f; ep.sacc_scale=0.9f; ep.pupil_bias=-0.07f; ep.eyelid_bias=-0.05f; ep.gaze_by=-4.f; ep.tint_on=true; ep.tint_col=0x07E0; ep.tint_strength=0.20f; ep.upper=g_shapes.upper_disgust; ep.lower=g_shapes.lower_disgust; break;
+            case Emotion::Neutral: default:
+                break;
         }
-        // Subtle hue/brightness modulation for lids
-    // Use fixed dark colours for eyelids (set once in init). No per-frame color modulation.
-    // Base render once (common iris/sclera); eyelids differ only by mirroring.
-    // Use left params (mirror flag ignored in base) then apply eyelids for each eye.
-    // Draw function (white)
-    // Overlay pixel draw (invert Y to match physical panel orientation)
-    // FPS overlay removed per request.
-    // Render base once into base_frame_ using left params (mirror flag ignored for base content)
-    render_eye_base(base_frame_, params_left_);
-    auto draw_overlays = [&](){ /* no-op */ };
-    // LEFT EYE: copy base, apply left eyelids, overlays, blit
-    std::memcpy(frame_, base_frame_, sizeof(frame_));
-    apply_eyelids(frame_, params_left_);
-    draw_overlays();
-    if (left_) left_->blit(frame_, full);
-    // RIGHT EYE: copy same base, apply right eyelids (mirrored), overlays, blit
-    std::memcpy(frame_, base_frame_, sizeof(frame_));
-    apply_eyelids(frame_, params_right_);
-    draw_overlays();
-    if (right_) right_->blit(frame_, full);
-        tight_loop_contents();
+        return ep;
+    };
+    EmoParams prevp = compute(prev_emotion_);
+    EmoParams curp  = compute(emotion_);
+    // Apply smootherstep easing to emotion fade for more natural transitions
+    float f = emotion_fade_;
+    {
+        float x = f; // smootherstep (quintic) 6x^5 -15x^4 +10x^3
+        f = x * x * x * (x * (x * 6.f - 15.f) + 10.f);
+    }
+    auto lerp = [&](float a,float b){return a + (b-a)*f;};
+    float emotion_fixation_scale = lerp(prevp.fix_scale, curp.fix_scale);
+    float emotion_saccade_speed_scale = lerp(prevp.sacc_scale, curp.sacc_scale);
+    float emotion_pupil_bias = lerp(prevp.pupil_bias, curp.pupil_bias);
+    float eyelid_open_bias = lerp(prevp.eyelid_bias, curp.eyelid_bias);
+    float gaze_bias_x = lerp(prevp.gaze_bx, curp.gaze_bx);
+    float gaze_bias_y = lerp(prevp.gaze_by, curp.gaze_by);
+    // Blend tint: if either has tint, blend color in RGB565 space component-wise. Applied to the
+    // whole frame by the transmit color stage; LUTs rebuild only when the quantised params change.
+    ColorParams cp = color_base_;
+    if (prevp.tint_on || curp.tint_on) {
+        // Extract components
+        int pr = (prevp.tint_col >> 11) & 0x1F; int pg = (prevp.tint_col >> 5) & 0x3F; int pb = prevp.tint_col & 0x1F;
+        int cr = (curp.tint_col >> 11) & 0x1F; int cg = (curp.tint_col >> 5) & 0x3F; int cb = curp.tint_col & 0x1F;
+        int r = (int)(pr + (cr - pr) * f + 0.5f);
+        int g = (int)(pg + (cg - pg) * f + 0.5f);
+        int b = (int)(pb + (cb - pb) * f + 0.5f);
+        if (r<0) r=0; if(r>31) r=31; if(g<0) g=0; if(g>63) g=63; if(b<0) b=0; if(b>31) b=31;
+        cp.tint_color = (uint16_t)((r<<11)|(g<<5)|b);
+        float blend_str = lerp(prevp.tint_strength, curp.tint_strength);
+        cp.tint_strength = (uint8_t)std::lround(clamp_fallback(blend_str, 0.f, 1.f) * 255.f);
+    }
+    // Rows the reduced-region blit skips hold lid color from earlier frames; black lids stay black
+    // under any tint, gamma or brightness, other lid colors must be sent again
+    if (color_.set(cp)) {
+        for (int i = 0; i < eye_count_; ++i)
+            if (eyes_[i].params().eyelid_color_top || eyes_[i].params().eyelid_color_bottom) eyes_[i].invalidate();
     }
+    // Quality tiers: lids (opening and emotion shapes) at half rate, secondary highlight off
+    const bool lids = !quality_.at_least(QualityTier::HalfRateLids) || !(frame_count_ & 1);
+    for (int i = 0; i < eye_count_; ++i)
+        eyes_[i].params().highlight_secondary = !quality_.at_least(QualityTier::NoSecondaryHighlight);
+    // Shape blend: create temp blended arrays (static to avoid stack) and point to them.
+    static int8_t upper_blend[kRows];
+    static int8_t lower_blend[kRows];
+    for (int y = 0; lids && y < kRows; ++y) {
+        float u = prevp.upper[y] + (curp.upper[y]-prevp.upper[y])*f;
+        float l = prevp.lower[y] + (curp.lower[y]-prevp.lower[y])*f;
+        if (u < -128.f) u = -128.f; if (u > 127.f) u = 127.f;
+        if (l < -128.f) l = -128.f; if (l > 127.f) l = 127.f;
+        upper_blend[y] = (int8_t) (int) std::lround(u);
+        lower_blend[y] = (int8_t) (int) std::lround(l);
+    }
+    for (int i = 0; i < eye_count_; ++i) {
+        eyes_[i].params().upper_shape_adjust = upper_blend;
+        eyes_[i].params().lower_shape_adjust = lower_blend;
+    }
+
+    // Procedural animation for every eye in one batch, with the emotion and timeline inputs
+    AnimInputs in;
+    in.dt = dt;
+    in.fixation_scale = emotion_fixation_scale;
+    in.saccade_speed_scale = emotion_saccade_speed_scale;
+    in.pupil_bias = emotion_pupil_bias;
+    in.eyelid_bias = eyelid_open_bias;
+    in.gaze_bias_x = gaze_bias_x;
+    in.gaze_bias_y = gaze_bias_y;
+    if (tl.has_gaze) {
+        // Timeline gaze is in reference (128px) units relative to the panel centre
+        in.has_gaze = true;
+        in.gaze_x = kFrameW * 0.5f + tl.gaze_x * kFrameW / kAssetRefW;
+        in.gaze_y = kFrameH * 0.5f + tl.gaze_y * kFrameH / kAssetRefH;
+    }
+    if (tl.has_pupil) { in.has_pupil = true; in.pupil_scale = tl.pupil_scale; }
+    if (tl.has_eyelid) { in.has_eyelid = true; in.eyelid_open = tl.eyelid_open; }
+    react_to_audio(now_us, dt, in);
+    anim_.step(in);
+    // Each eye pulls its animated state and computes what its lids leave visible
+    for (int i = 0; i < eye_count_; ++i) eyes_[i].tick(anim_, lids);
+    update_glow(dt);
+    render_eyes();
+    const uint32_t frame_us = (uint32_t)(time_us_64() - now_us);
+    perf::add(perf::Section::Frame, frame_us);
+    perf::end_frame();
+    update_quality(frame_us);
+}
+
+void App::update_quality(uint32_t frame_us) {
+    static_assert(kFramePeriodUs == QualityGovernorConfig{}.period_us, "an overrun is a frame longer than its period");
+    ++frame_count_;
+    if (quality_.update(frame_us)) {
+        printf("quality: tier %d (%s), average frame %lu us\n", (int)quality_.tier(),
+               quality_tier_name(quality_.tier()), (unsigned long)quality_.average_us());
+    }
+}
+
+void App::report() {
+    sched_->report();
+    const QualityGovernor::Stats& st = quality_.stats();
+    printf("quality: tier %d (%s), %lu frames, %lu overruns (worst %lu us), %lu down %lu up, frames per tier",
+           (int)quality_.tier(), quality_tier_name(quality_.tier()), (unsigned long)st.frames,
+           (unsigned long)st.overruns, (unsigned long)st.worst_us, (unsigned long)st.degrades,
+           (unsigned long)st.restores);
+    for (int t = 0; t < (int)QualityTier::COUNT; ++t) printf(" %lu", (unsigned long)st.frames_at[t]);
+    printf("\n");
+    quality_.reset_stats();
 }
 
 } // namespace eyes
@@ -1,49 +1,83 @@
 #pragma once
 
 #include <cstdint>
+#include "eye.hpp"
+#include "eye_animator.hpp"
 #include "eye_renderer.hpp" // EyeRenderParams
+#include "pico2_panel.hpp"    // ActivePanel
+#include "timeline.hpp"
+#include "audio_output.hpp"
+#include "command_protocol.hpp"
+#include "color_pipeline.hpp"
+#include "gaze_tracker.hpp"
+#include "presence_sensor.hpp"
+#include "quality_governor.hpp"
+#include "scheduler.hpp"
 
 namespace eyes {
 
+template <class Panel> class Ssd1351Display;
+class UartRxRing;
+class BlockCache;
+class StyleStream;
+
 class App {
 public:
     bool init();
     void loop();
+    // Hold gaze on a target (panel pixels, centre = kFrameW/2) at distance_mm from the face.
+    // Near targets converge the eyes; distance_mm <= 0 means "far" (parallel gaze).
+    void look_at(float x, float y, float distance_mm) { anim_.look_at(x, y, distance_mm); }
+    // Return gaze control to the random saccade generator (vergence relaxes to parallel).
+    void release_look() { anim_.release_look(); }
+    // Play a compiled timeline (tools/timeline_compile.py) read in place; data must stay valid.
+    // Tracks present in the timeline override the procedural animation until it finishes.
+    bool play_timeline(const uint8_t* data, size_t len);
+    void stop_timeline();
+    // Audio output whose sample clock timelines lock to (falls back to the us timer when null),
+    // and the handler that starts clips for timeline cue events. What it plays is analysed as it
+    // is written and the eyes react: pupils constrict with loudness, lids flinch at sudden onsets.
+    using AudioCueHandler = void (*)(uint8_t clip_id, float gain);
+    void set_audio(AudioOutput* audio, AudioCueHandler on_cue);
+    // Whole-frame output controls (applied on transmit together with the emotion tint).
+    void set_brightness(float level);   // 0..1
+    void set_gamma(float gamma);        // 1 = linear; >1 darkens midtones for the OLED response
+    // Spherical eyeball projection (default) vs the flat sliding-texture compose.
+    void set_spherical(bool on) { for (int i = 0; i < eye_count_; ++i) eyes_[i].params().spherical = on; }
+    // Switch eye style (registry in eye_style.hpp) without a visible stall: the new style's LUTs
+    // build a slice per frame, then old and new cross-fade. False while a switch is in progress.
+    bool set_style(const EyeStyle& style);
+    bool set_style(int index) { return set_style(eye_style(index)); }
+    // Switch to the index-th style of the asset pack (PME_ASSET_STREAMING): it is read into the RAM
+    // style slot over the following frames, then switched to as above. False without a pack, while
+    // a switch is in progress, or while the slot's current style is on screen (it holds one style).
+    bool set_streamed_style(int index);
+    const EyeStyle& style() const { return *eyes_[0].params().style; }
+    // Pupil shape of every eye (pupil_shape.hpp), until the next style switch sets the style's own
+    void set_pupil_shape(PupilShape shape) { for (int i = 0; i < eye_count_; ++i) eyes_[i].params().pupil_shape = shape; }
+    // Iris glow by palette animation (indexed_assets.hpp): each frame the style's iris palette is
+    // brightened toward color by strength (0 = off), pulsing at pulse_hz (0 = steady). Only styles
+    // with a palette-indexed iris map (PME_INDEXED_ASSETS) glow; others ignore it.
+    void set_iris_glow(uint16_t color, float strength, float pulse_hz);
 private:
     enum class Emotion { Neutral, Sad, Fear, Anger, Disgust, COUNT };
     // Framebuffer and render state
-    static constexpr int kFrameW = 128;
-    static constexpr int kFrameH = 128;
-    uint16_t frame_[kFrameW * kFrameH]{};
-    // Separate buffer for base (sclera/iris/highlights) so we can apply eyelids twice
-    uint16_t base_frame_[kFrameW * kFrameH]{};
+    using Panel = ActivePanel;
+    static constexpr int kFrameW = Panel::kWidth;
+    static constexpr int kFrameH = Panel::kHeight;
+    uint16_t* frame_ = nullptr;     // Panel::kPixels RGB565, in the framebuffer section (app.cpp)
+    // Transmit color stage shared by both panels; emotion tint is layered over color_base_
+    ColorPipeline color_;
+    ColorParams color_base_{};
     // Displays (constructed in init)
-    class Ssd1351Display* left_ = nullptr;
-    class Ssd1351Display* right_ = nullptr;
-    // Eye parameters (animated pupil)
-    EyeRenderParams params_left_{}; // left eye params
-    EyeRenderParams params_right_{}; // right eye params
-    float t_ = 0.f;
-    // Saccade / fixation state
-    float gaze_cx_ = kFrameW * 0.5f; // current (float for interpolation)
-    float gaze_cy_ = kFrameH * 0.5f;
-    float gaze_sx_ = gaze_cx_;       // saccade start position
-    float gaze_sy_ = gaze_cy_;
-    float gaze_tx_ = gaze_cx_;       // target position
-    float gaze_ty_ = gaze_cy_;
-    float fixation_timer_ = 0.f;
-    float next_fixation_duration_ = 1.0f; // seconds
-    float saccade_timer_ = 0.f;
-    float saccade_duration_ = 0.f;
-    uint32_t rng_state_ = 0x12345678u;
-    // Pupil dilation state (scaled multiplier applied to base_pupil_fraction)
-    float pupil_scale_cur_ = 1.0f;
-    float pupil_scale_target_ = 1.0f;
-    float pupil_breath_phase_ = 0.f; // low amplitude in-fixation fluctuation
-    // Motion activity & adaptive blink
-    float activity_level_ = 0.f;      // 0 calm .. 1 very active
-    float prev_gaze_cx_ = kFrameW * 0.5f;
-    float prev_gaze_cy_ = kFrameH * 0.5f;
+    Ssd1351Display<Panel>* left_ = nullptr;
+    Ssd1351Display<Panel>* right_ = nullptr;
+    // Eyes: procedural animation for all of them stepped as one batch, and one Eye per display.
+    // Eye 0 is the left panel; the right eye follows its gaze, pupil and blinks.
+    static constexpr float kInterocularMm = 70.f;       // distance between eye centres on the mask
+    EyeAnimator anim_{(float)kFrameW, (float)kFrameH};
+    Eye<Panel> eyes_[EyeAnimator::kMaxEyes];
+    int eye_count_ = 0;
     // Emotion system
     Emotion emotion_ = Emotion::Neutral;
     float emotion_timer_ = 0.f;           // elapsed time in current emotion
@@ -52,27 +86,124 @@ private:
     Emotion prev_emotion_ = Emotion::Neutral;
     float emotion_fade_ = 0.f;            // 0..1 blend (0=prev,1=current)
     float emotion_fade_duration_ = 1.2f;  // seconds for visual fade
-
-    // Blink state machine (slow natural blinks with slight random period jitter)
-    enum class BlinkState { Idle, Closing, Hold, Opening };
-    BlinkState blink_state_ = BlinkState::Idle;
-    float blink_timer_ = 0.f;          // time inside current blink phase
-    float next_blink_time_ = 0.f;      // absolute t_ when next blink should start
-    // Base durations (can be tuned per emotion later if desired)
-    float blink_close_dur_ = 0.12f;
-    float blink_hold_dur_  = 0.08f;
-    float blink_open_dur_  = 0.16f;
-    float blink_period_base_ = 5.5f;   // average seconds between blinks
-    float blink_period_jitter_ = 0.9f; // added *uniform*[0,1) * jitter
+    // Eye style switch: Loading waits for a streamed style to arrive in its RAM slot (the assets
+    // task copies it), Preparing builds the incoming style's LUTs within kStyleBuildBudgetUs per
+    // frame (old style keeps rendering), Fading renders both and blends old over new.
+    enum class StyleSwitch { Idle, Loading, Preparing, Fading };
+    static constexpr uint32_t kStyleBuildBudgetUs = 2000;
+    static constexpr float kStyleFadeDuration = 0.6f; // seconds
+    StyleSwitch style_switch_ = StyleSwitch::Idle;
+    const EyeStyle* style_from_ = nullptr;   // fading out
+    const EyeStyle* style_to_ = nullptr;     // being prepared / fading in
+    float style_fade_ = 0.f;                 // 0..1 (1 = new style only)
+    // Main loop tasks (loop()): the frame runs at 50 fps, the rate the animation and emotion steps
+    // assume; commands and the sensor are polled in between
+    static constexpr uint32_t kFramePeriodUs = 20000;
+    static constexpr uint32_t kCommandPeriodUs = 2000;
+    static constexpr uint32_t kSensorPeriodUs = 10000;
+    static constexpr uint32_t kSchedReportUs = 10000000;
+    static constexpr uint32_t kAssetPeriodUs = 1000;
+    Scheduler* sched_ = nullptr;
+    int sensor_task_ = -1;
+    // Frame-budget governor (src/quality_governor.hpp; its default config is for the 20 ms frame):
+    // each frame's run time picks the quality tier the next frames render at
+    QualityGovernor quality_;
+    uint32_t frame_count_ = 0;
+    // Iris sprite kept for QualityTier::CachedIris and what it was rendered for (valid false: none,
+    // or the last render was culled to one frame's lids and cannot be reused)
+    struct IrisKey {
+        bool valid = false;
+        const EyeStyle* style = nullptr;
+        float iris_r = 0.f;
+        float pupil_r = 0.f;
+        PupilShape shape = PupilShape::Circle;
+        bool secondary = false;
+        bool antialias = false;
+        uint8_t glow = 0;
+        uint16_t glow_color = 0;        // only meaningful with glow != 0
+    };
+    static constexpr float kIrisCachePupilPx = 0.25f;  // pupil radius change that re-renders it
+    IrisKey iris_key_;
+    const IrisSprite<Panel>* iris_cached_ = nullptr;
+    int asset_task_ = -1;
+    // Streamed assets (PME_ASSET_STREAMING): block cache on the SD card and the RAM style slot.
+    // The assets task moves blocks (woken by each completed transfer) and copies a loading style
+    // within kStyleLoadBudgetUs per run.
+    static constexpr uint32_t kStyleLoadBudgetUs = 300;
+    BlockCache* asset_cache_ = nullptr;
+    StyleStream* style_stream_ = nullptr;
+    uint32_t style_load_start_us_ = 0;
     // Time delta tracking
     uint64_t last_time_us_ = 0; // baseline for dt accumulation
+    uint64_t last_sensor_us_ = 0;
+    // Scripted playback
+    TimelinePlayer timeline_;
+    bool timeline_gaze_ = false;        // timeline currently holds the gaze (release on finish)
+    AudioOutput* audio_ = nullptr;
+    AudioCueHandler on_audio_cue_ = nullptr;
+    // Audio reaction: levels of the newest block written (AudioEnvelope snapshot), mapped to a
+    // pupil bias by the envelope (a growl, mostly low band, counts fully) and to a lid flinch when a
+    // block's peak jumps well above the envelope it arrives on. Levels older than kAudioStaleUs
+    // (output stopped or starved) count as silence.
+    static constexpr float kAudioFullLevel = 10000.f;       // envelope for the full reaction (about -10 dBFS)
+    static constexpr float kAudioPupilConstrict = 0.6f;     // pupil bias at the full reaction
+    static constexpr float kAudioFlinchPeak = 8000.f;       // onset peak: at least this ...
+    static constexpr float kAudioFlinchJump = 4.f;          // ... and this many times the envelope before it
+    static constexpr float kAudioFlinchClose = 0.45f;       // eyelid bias at the flinch
+    static constexpr float kAudioFlinchS = 0.3f;            // flinch recovery
+    static constexpr uint64_t kAudioStaleUs = 100000;
+    AudioEnvelope audio_env_;
+    AudioLevels audio_levels_;
+    uint64_t audio_seen_us_ = 0;
+    float audio_flinch_ = 0.f;          // 1 at a flinch, decays to 0
+    // Iris glow (set_iris_glow): the animated palette every eye's iris is drawn through, rewritten
+    // each frame from the style's at the pulse's current alpha
+    uint16_t glow_color_ = 0xFFFF;
+    float glow_strength_ = 0.f;
+    float glow_pulse_hz_ = 0.f;
+    float glow_phase_ = 0.f;            // 0..1 through the pulse
+    uint8_t glow_alpha_ = 0;            // this frame's (0..32; 0 = the style's palette)
+    uint16_t glow_palette_[kPaletteSize];
+    // Live control channel (UART1) and command-to-photon latency (receipt -> first blit showing it)
+    UartRxRing* ctrl_ = nullptr;
+    CommandParser ctrl_parser_;
+    bool ctrl_pending_ = false;         // a command was applied and has not been blitted yet
+    uint32_t ctrl_pending_us_ = 0;      // receipt time of the oldest unblitted command
+    uint32_t ctrl_lat_count_ = 0;
+    uint32_t ctrl_lat_sum_us_ = 0;
+    uint32_t ctrl_lat_max_us_ = 0;
+    bool ctrl_look_ = false;            // a LookAt command holds the gaze until ReleaseLook
+    // Presence sensor (optional) turned into look-at targets; live commands and timelines take priority.
+    // Sensor-to-gaze latency runs from the sample arriving to the first blit aimed at it.
+    PresenceSensor* presence_ = nullptr;
+    GazeTracker tracker_{(float)kFrameW, (float)kFrameH};
+    bool sensor_look_ = false;          // the tracker holds the gaze
+    bool sensor_pending_ = false;
+    uint32_t sensor_pending_us_ = 0;
+    uint32_t sensor_lat_count_ = 0;
+    uint32_t sensor_lat_sum_us_ = 0;
+    uint32_t sensor_lat_max_us_ = 0;
 
-    float rand01() {
-        rng_state_ = rng_state_ * 1664525u + 1013904223u; // LCG
-        return (rng_state_ >> 8) * (1.0f / 16777216.0f);  // 24-bit to [0,1)
-    }
-    void choose_new_target();
+    void add_eye(Display* display, const EyeMount& mount, bool mirror_eyelids);
+    void frame(uint64_t now_us);
+    void sensor_task(uint64_t now_us);
+    void asset_task();
+    void render_eyes();
     void advance_emotion();
+    void set_emotion(Emotion e);
+    void update_style_switch();
+    void update_quality(uint32_t frame_us);
+    const IrisSprite<Panel>& group_iris(const EyeRenderParams& lead, const CulledEye<Panel>* culled, int n);
+    void report();
+    void apply_style(const EyeStyle& style);
+    void poll_commands();
+    void apply_command(const Command& cmd);
+    void note_command_blitted();
+    void poll_presence(uint32_t now_us, float dt);
+    void react_to_audio(uint64_t now_us, float dt, AnimInputs& in);
+    void update_glow(float dt);
+    void note_sensor_blitted();
+    uint64_t timeline_clock() const;
 };
 
 } // namespace eyes
@@ -0,0 +1,44 @@
+#include "asset_pack.hpp"
+
+#include <cstring>
+
+namespace eyes {
+
+bool AssetPack::open() {
+    count_ = 0;
+    AssetPackHeader h;
+    if (!cache_.read(0, &h, sizeof h)) return false;
+    if (std::memcmp(h.magic, "PMEA", 4) != 0 || h.version != kAssetPackVersion) return false;
+    if (h.entry_count > kMaxEntries) return false;
+    if (!cache_.read(h.dir_offset, entries_, h.entry_count * sizeof(AssetPackEntry))) return false;
+    const uint64_t device_bytes = (uint64_t)cache_.device().block_count() * BlockCache::kBlockSize;
+    for (int i = 0; i < h.entry_count; ++i) {
+        AssetPackEntry &e = entries_[i];
+        e.name[sizeof e.name - 1] = '\0';
+        if (e.offset % BlockCache::kBlockSize || (uint64_t)e.offset + e.size > device_bytes) return false;
+    }
+    count_ = h.entry_count;
+    return true;
+}
+
+int AssetPack::find(const char *name) const {
+    for (int i = 0; i < count_; ++i)
+        if (std::strcmp(entries_[i].name, name) == 0) return i;
+    return -1;
+}
+
+int AssetPack::style_count() const {
+    int n = 0;
+    for (int i = 0; i < count_; ++i) n += entries_[i].type == (uint16_t)AssetType::Style;
+    return n;
+}
+
+int AssetPack::style_entry(int index) const {
+    for (int i = 0; i < count_; ++i) {
+        if (entries_[i].type != (uint16_t)AssetType::Style) continue;
+        if (index-- == 0) return i;
+    }
+    return -1;
+}
+
+} // namespace eyes
@@ -0,0 +1,62 @@
+// Packed assets on a block device (SD card, external flash): eye styles and sound clips that are
+// streamed into RAM when needed instead of being linked into the firmware image. The directory is
+// read once at open(); data comes through a BlockCache. See docs/asset_streaming.md and
+// tools/asset_pack.py.
+#pragma once
+
+#include <cstdint>
+#include "block_cache.hpp"
+
+namespace eyes {
+
+// ---- On-device format (little-endian; every entry starts on a block boundary) ----
+struct AssetPackHeader {
+    char magic[4];          // "PMEA"
+    uint16_t version;       // kAssetPackVersion
+    uint16_t entry_count;
+    uint32_t dir_offset;    // bytes from the start of the device to AssetPackEntry[entry_count]
+    uint32_t reserved;
+};
+
+struct AssetPackEntry {
+    char name[24];          // NUL-terminated; style parts are "<style>.sclera", ".iris", ".upper", ".lower"
+    uint32_t offset;        // bytes from the start of the device, a multiple of the block size
+    uint32_t size;          // bytes
+    uint16_t type;          // AssetType
+    uint16_t w;             // Style: iris diameter on the reference screen; Clip: sample rate
+    uint16_t h;             // Clip: clip id
+    uint16_t reserved;
+};
+
+static_assert(sizeof(AssetPackHeader) == 16, "asset pack header layout");
+static_assert(sizeof(AssetPackEntry) == 40, "asset pack entry layout");
+
+constexpr uint16_t kAssetPackVersion = 1;
+
+// Entry payloads: Style has none (its parts are found by name); Sclera and IrisMap are RGB565 with
+// w x h pixels; lid maps are w x h uint8 thresholds; Clip is mono signed 16-bit PCM.
+enum class AssetType : uint16_t { Style = 1, Sclera, IrisMap, UpperLid, LowerLid, Clip };
+
+class AssetPack {
+public:
+    static constexpr int kMaxEntries = 48;
+
+    explicit AssetPack(BlockCache &cache) : cache_(cache) {}
+
+    // Read and check the header and directory (blocking; boot time). False if there is no pack.
+    bool open();
+    BlockCache &cache() { return cache_; }
+    int count() const { return count_; }
+    const AssetPackEntry &entry(int i) const { return entries_[i]; }
+    int find(const char *name) const;   // -1 if absent
+    // Styles in directory order
+    int style_count() const;
+    int style_entry(int index) const;   // entry of the index-th style, -1 if out of range
+
+private:
+    BlockCache &cache_;
+    AssetPackEntry entries_[kMaxEntries]{};
+    int count_ = 0;
+};
+
+} // namespace eyes
@@ -0,0 +1,69 @@
+#include "audio_envelope.hpp"
+
+#include <cmath>
+
+namespace eyes {
+
+namespace {
+    uint16_t to_level(float v) { return (uint16_t)(v > 32767.f ? 32767.f : v + 0.5f); }
+
+    uint16_t rms_of(int64_t energy, size_t n) { return to_level(std::sqrt((float)energy / (float)n)); }
+}
+
+int AudioEnvelope::shift_for(float hz, uint32_t rate) {
+    // One-pole coefficient for a -3 dB corner at hz, rounded to the nearest power of two
+    const float alpha = 1.f - std::exp(-2.f * 3.14159265f * hz / (float)rate);
+    int shift = (int)std::lround(-std::log2(alpha));
+    if (shift < 0) shift = 0;
+    if (shift > 12) shift = 12;
+    return shift;
+}
+
+void AudioEnvelope::set_sample_rate(uint32_t hz) {
+    if (!hz) return;
+    cfg_.sample_rate_hz = hz;
+    low_shift_ = shift_for(cfg_.low_hz, hz);
+    high_shift_ = shift_for(cfg_.high_hz, hz);
+    attack_per_s_ = 1000.f / cfg_.attack_ms;
+    release_per_s_ = 1000.f / cfg_.release_ms;
+}
+
+void AudioEnvelope::analyze(const int16_t* samples, size_t count) {
+    if (!count) return;
+    // One pass, a handful of integer ops per sample: two filter updates, three band values, four
+    // multiply-accumulates and the peak
+    int32_t lo = lp_low_, hi = lp_high_;
+    const int ls = low_shift_, hs = high_shift_;
+    int64_t e_all = 0, e_low = 0, e_mid = 0, e_high = 0;
+    int32_t mx = 0, mn = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const int32_t x = samples[i];
+        lo += (x * 256 - lo) >> ls;
+        hi += (x * 256 - hi) >> hs;
+        const int32_t l = lo >> 8, m = (hi - lo) >> 8, h = x - (hi >> 8);
+        e_all += (int64_t)x * x;
+        e_low += (int64_t)l * l;
+        e_mid += (int64_t)m * m;
+        e_high += (int64_t)h * h;
+        mx = x > mx ? x : mx;
+        mn = x < mn ? x : mn;
+    }
+    lp_low_ = lo;
+    lp_high_ = hi;
+
+    cur_.rms = rms_of(e_all, count);
+    cur_.peak = to_level((float)(mx > -mn ? mx : -mn));
+    cur_.band[0] = rms_of(e_low, count);
+    cur_.band[1] = rms_of(e_mid, count);
+    cur_.band[2] = rms_of(e_high, count);
+    // Envelope follower stepped once per block by the block's duration
+    const float dt = (float)count / (float)cfg_.sample_rate_hz;
+    const float per_s = cur_.rms > env_ ? attack_per_s_ : release_per_s_;
+    env_ += (cur_.rms - env_) * (1.f - std::exp(-dt * per_s));
+    cur_.envelope = to_level(env_);
+    ++cur_.blocks;
+    cur_.end_sample += count;
+    levels_.publish(cur_);
+}
+
+} // namespace eyes
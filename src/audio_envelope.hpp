@@ -0,0 +1,63 @@
+// Block-level audio analysis for audio-reactive eyes: RMS, peak, an attack/release envelope and a
+// coarse three-band energy split of every block an AudioOutput accepts, published as a lock-free
+// snapshot the frame reads. Runs in place on the block being written, so it adds no latency. No
+// hardware dependencies (host benchmark: tools/audio_envelope_bench.cpp).
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "seqlock.hpp"
+
+namespace eyes {
+
+struct AudioEnvelopeConfig {
+    uint32_t sample_rate_hz = 22050;    // replaced by the output's rate (AudioOutput::set_analyzer)
+    float low_hz = 250.f;               // low band below this (growls, rumble)
+    float high_hz = 2000.f;             // high band above this (hiss, clatter); mid in between
+    float attack_ms = 8.f;              // envelope time constants
+    float release_ms = 180.f;
+};
+
+// Levels of the newest block. Amplitudes in sample units (full scale 32767).
+struct AudioLevels {
+    static constexpr int kBands = 3;    // low, mid, high
+    uint16_t rms = 0;
+    uint16_t peak = 0;                  // largest |sample|
+    uint16_t envelope = 0;              // RMS through the attack/release follower
+    uint16_t band[kBands] = {};         // RMS of each band
+    uint32_t blocks = 0;                // blocks analysed so far
+    uint64_t end_sample = 0;            // samples analysed so far (the written sample index past this block)
+};
+
+class AudioEnvelope {
+public:
+    explicit AudioEnvelope(const AudioEnvelopeConfig& cfg = {}) : cfg_(cfg) { set_sample_rate(cfg.sample_rate_hz); }
+
+    // Filter shifts and envelope coefficients for this rate
+    void set_sample_rate(uint32_t hz);
+    // Writer side: analyse one block and publish its levels. Called by the output for every block
+    // it accepts, in the writer's context (never from two contexts at once).
+    void analyze(const int16_t* samples, size_t count);
+    // Reader side, any context: the newest levels; false if none could be read (keep the last)
+    bool read(AudioLevels& out) const { return levels_.read(out); }
+
+    const AudioEnvelopeConfig& config() const { return cfg_; }
+
+private:
+    // Band split by one-pole low-passes with power-of-two coefficients: lp += (x - lp) >> shift.
+    // State in Q8 so quiet signals keep their low bits.
+    static int shift_for(float hz, uint32_t rate);
+
+    AudioEnvelopeConfig cfg_;
+    int low_shift_ = 4;
+    int high_shift_ = 1;
+    int32_t lp_low_ = 0;                // Q8
+    int32_t lp_high_ = 0;               // Q8
+    float attack_per_s_ = 0.f;          // 1 / time constant
+    float release_per_s_ = 0.f;
+    float env_ = 0.f;
+    AudioLevels cur_{};                 // writer's copy
+    Seqlock<AudioLevels> levels_;
+};
+
+} // namespace eyes
@@ -0,0 +1,116 @@
+#include "block_cache.hpp"
+
+#include <cstring>
+
+namespace eyes {
+
+int BlockCache::find(uint32_t lba) const {
+    for (int i = 0; i < kSlots; ++i)
+        if (slots_[i].state != SlotState::Free && slots_[i].lba == lba) return i;
+    return -1;
+}
+
+// A free slot, else the least recently used valid one
+int BlockCache::victim() const {
+    int v = -1;
+    for (int i = 0; i < kSlots; ++i) {
+        const Slot &s = slots_[i];
+        if (s.state == SlotState::Free) return i;
+        if (s.state == SlotState::Valid && (v < 0 || s.use_tick < slots_[v].use_tick)) v = i;
+    }
+    return v;
+}
+
+const uint8_t *BlockCache::try_block(uint32_t lba) {
+    const int i = find(lba);
+    if (i >= 0 && slots_[i].state == SlotState::Valid) {
+        Slot &s = slots_[i];
+        s.use_tick = ++tick_;
+        ++stats_.hits;
+        if (s.prefetched) { s.prefetched = false; ++stats_.prefetch_used; }
+        return data_[i];
+    }
+    // Already on its way (read ahead, or asked for before) or not: only a new request is a miss
+    if (i < 0 && !(demand_pending_ && demand_lba_ == lba)) {
+        demand_pending_ = true;
+        demand_lba_ = lba;
+        ++stats_.misses;
+    }
+    return nullptr;
+}
+
+const uint8_t *BlockCache::block(uint32_t lba) {
+    failed_ = false;
+    for (;;) {
+        if (const uint8_t *p = try_block(lba)) return p;
+        if (failed_ && failed_lba_ == lba) return nullptr;
+        poll();
+    }
+}
+
+bool BlockCache::read(uint32_t offset, void *dst, uint32_t len) {
+    uint8_t *out = static_cast<uint8_t *>(dst);
+    while (len) {
+        const uint8_t *b = block(offset / kBlockSize);
+        if (!b) return false;
+        const uint32_t at = offset % kBlockSize;
+        const uint32_t n = len < kBlockSize - at ? len : kBlockSize - at;
+        std::memcpy(out, b + at, n);
+        out += n; offset += n; len -= n;
+    }
+    return true;
+}
+
+void BlockCache::prefetch(uint32_t lba, uint32_t count) {
+    if (!read_ahead_) return;
+    if (count > (uint32_t)kMaxReadAhead) count = kMaxReadAhead;
+    ahead_next_ = lba;
+    ahead_end_ = lba + count;
+}
+
+void BlockCache::start(uint32_t lba, bool prefetched) {
+    const int v = victim();
+    if (v < 0) return;
+    Slot &s = slots_[v];
+    s = Slot{lba, ++tick_, SlotState::Loading, prefetched};
+    if (!dev_.start_read(lba, 1, data_[v])) {
+        s.state = SlotState::Free;
+        ++stats_.errors;
+        failed_ = true;
+        failed_lba_ = lba;
+        return;
+    }
+    loading_ = v;
+    if (prefetched) ++stats_.prefetched;
+    dev_.poll(); // the data may be there already
+}
+
+void BlockCache::poll() {
+    dev_.poll();
+    if (loading_ >= 0 && !dev_.busy()) {
+        Slot &s = slots_[loading_];
+        loading_ = -1;
+        if (dev_.ok()) {
+            s.state = SlotState::Valid;
+            s.use_tick = ++tick_;
+        } else {
+            s.state = SlotState::Free;
+            ++stats_.errors;
+            failed_ = true;
+            failed_lba_ = s.lba;
+            if (s.prefetched) ahead_next_ = ahead_end_; // don't keep reading into a bad range
+        }
+    }
+    if (loading_ >= 0) return;
+    // Demand first, then the next read-ahead block not cached yet
+    if (demand_pending_) {
+        demand_pending_ = false;
+        if (find(demand_lba_) < 0) { start(demand_lba_, false); return; }
+    }
+    while (ahead_next_ != ahead_end_) {
+        const uint32_t lba = ahead_next_++;
+        if (find(lba) < 0) { start(lba, true); return; }
+    }
+}
+
+} // namespace eyes
@@ -0,0 +1,77 @@
+// LRU cache of BlockDevice blocks in SRAM with asynchronous read-ahead. One read is in flight at a
+// time: a block somebody asked for and did not find comes first, then the read-ahead range the
+// consumer last hinted with prefetch() (what it will need next, in order). Everything runs from
+// poll(), called by the task that owns the device, so neither the renderer nor the loader ever waits
+// on the bus. No hardware dependencies (tools/asset_stream_bench.cpp runs it on a file).
+#pragma once
+#include <cstdint>
+#include "block_device.hpp"
+
+namespace eyes {
+
+class BlockCache {
+public:
+    static constexpr int kSlots = 32;              // 16 KB
+    static constexpr int kMaxReadAhead = kSlots / 2; // blocks read ahead of the consumer at most
+    static constexpr uint32_t kBlockSize = BlockDevice::kBlockSize;
+
+    struct Stats {
+        uint32_t hits = 0;
+        uint32_t misses = 0;          // blocks that had to be read on demand
+        uint32_t prefetched = 0;      // blocks read ahead
+        uint32_t prefetch_used = 0;   // read-ahead blocks that were asked for before eviction
+        uint32_t errors = 0;
+    };
+
+    explicit BlockCache(BlockDevice &dev) : dev_(dev) {}
+
+    BlockDevice &device() { return dev_; }
+    // Block lba if it is cached; otherwise nullptr and the block is read next (ahead of read-ahead).
+    // The data stays put until the next poll().
+    const uint8_t *try_block(uint32_t lba);
+    // As try_block, polling the device until the block is in (boot-time and host use); nullptr if
+    // the read failed
+    const uint8_t *block(uint32_t lba);
+    // Blocking copy of len bytes from byte offset on the device
+    bool read(uint32_t offset, void *dst, uint32_t len);
+    // Read blocks [lba, lba + count) ahead, in order (at most kMaxReadAhead of them), replacing the
+    // previous hint; count 0 cancels read-ahead
+    void prefetch(uint32_t lba, uint32_t count);
+    // Read-ahead on (default) or off, where prefetch() hints are ignored (for A/B measurements)
+    void set_read_ahead(bool on) { read_ahead_ = on; if (!on) ahead_next_ = ahead_end_; }
+    // Finish the read in flight and start the next one
+    void poll();
+    // No read in flight and none wanted
+    bool idle() const { return loading_ < 0 && !demand_pending_ && ahead_next_ == ahead_end_; }
+    const Stats &stats() const { return stats_; }
+    void reset_stats() { stats_ = Stats{}; }
+
+private:
+    enum class SlotState : uint8_t { Free, Loading, Valid };
+    struct Slot {
+        uint32_t lba;
+        uint32_t use_tick;    // last hit or load, for LRU eviction
+        SlotState state;
+        bool prefetched;      // read ahead and not asked for yet
+    };
+
+    int find(uint32_t lba) const;
+    int victim() const;
+    void start(uint32_t lba, bool prefetched);
+
+    BlockDevice &dev_;
+    alignas(4) uint8_t data_[kSlots][kBlockSize]{};
+    Slot slots_[kSlots]{};
+    uint32_t tick_ = 0;
+    int loading_ = -1;                // slot of the read in flight
+    bool demand_pending_ = false;
+    uint32_t demand_lba_ = 0;
+    bool failed_ = false;             // a read failed since block() started waiting
+    uint32_t failed_lba_ = 0;
+    uint32_t ahead_next_ = 0;         // read-ahead range still to go
+    uint32_t ahead_end_ = 0;
+    bool read_ahead_ = true;
+    Stats stats_;
+};
+
+} // namespace eyes
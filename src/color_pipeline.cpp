@@ -0,0 +1,40 @@
+#include "color_pipeline.hpp"
+
+#include <cmath>
+
+namespace eyes {
+
+namespace {
+    // One channel: filter -> gamma -> brightness, evaluated per input level (max = 31 or 63).
+    void build_channel(uint16_t* lut, int max, int shift, int tint_level, const ColorParams& p) {
+        float s = p.tint_strength / 255.f;
+        float filter = 1.f - s + s * ((float)tint_level / max);
+        float gain = p.brightness / 255.f;
+        float gamma = p.gamma_x256 / 256.f;
+        for (int v = 0; v <= max; ++v) {
+            float c = (float)v / max * filter;
+            if (p.gamma_x256 != 256) c = std::pow(c, gamma);
+            int out = (int)(c * gain * max + 0.5f);
+            if (out > max) out = max;
+            lut[v] = (uint16_t)(out << shift);
+        }
+    }
+}
+
+bool ColorPipeline::set(const ColorParams& p) {
+    if (p == params_) return false;
+    params_ = p;
+    rebuild();
+    return true;
+}
+
+void ColorPipeline::rebuild() {
+    const ColorParams& p = params_;
+    identity_ = p.tint_strength == 0 && p.brightness == 255 && p.gamma_x256 == 256;
+    build_channel(lut_r_, 31, 11, (p.tint_color >> 11) & 0x1F, p);
+    build_channel(lut_g_, 63, 5, (p.tint_color >> 5) & 0x3F, p);
+    build_channel(lut_b_, 31, 0, p.tint_color & 0x1F, p);
+    ++rebuilds_;
+}
+
+} // namespace eyes
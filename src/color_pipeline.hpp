@@ -0,0 +1,59 @@
+// Whole-frame color post-processing (tint, gamma, brightness) fused into the panel transmit pass.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "pixel_kernels.hpp"
+
+namespace eyes {
+
+struct ColorParams {
+    uint16_t tint_color = 0xFFFF;   // RGB565 filter color
+    uint8_t tint_strength = 0;      // 0 = no tint .. 255 = full filter
+    uint8_t brightness = 255;       // 0 = black .. 255 = unchanged
+    uint16_t gamma_x256 = 256;      // output = input^(gamma_x256/256); 256 = linear
+    bool operator==(const ColorParams& o) const {
+        return tint_color == o.tint_color && tint_strength == o.tint_strength &&
+               brightness == o.brightness && gamma_x256 == o.gamma_x256;
+    }
+    bool operator!=(const ColorParams& o) const { return !(*this == o); }
+};
+
+// Per-channel LUTs (32/64/32 entries) that map an RGB565 channel to its final value, already shifted
+// into place. A pixel then costs three loads and two ORs. Pixels go to the panel as 16-bit SPI frames,
+// so no byte swap is needed and an identity pipeline lets the display stream its source untouched. Tint is a color filter (c * lerp(1, tint, s)), so
+// black stays black and white becomes the tint color at full strength.
+class ColorPipeline {
+public:
+    ColorPipeline() { rebuild(); }
+
+    // Rebuilds the LUTs only when params differ from the current ones. Returns true if rebuilt.
+    bool set(const ColorParams& p);
+    const ColorParams& params() const { return params_; }
+    bool identity() const { return identity_; }
+    uint32_t rebuilds() const { return rebuilds_; }
+
+    // dst[i] = processed src[i] (dst may alias src).
+    void convert(const uint16_t* src, uint16_t* dst, size_t n) const {
+        if (identity_) {
+            if (dst != src) px::copy(dst, src, n);
+            return;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            uint16_t px = src[i];
+            dst[i] = (uint16_t)(lut_r_[px >> 11] | lut_g_[(px >> 5) & 0x3F] | lut_b_[px & 0x1F]);
+        }
+    }
+
+private:
+    void rebuild();
+
+    ColorParams params_{};
+    bool identity_ = true;
+    uint32_t rebuilds_ = 0;
+    uint16_t lut_r_[32];
+    uint16_t lut_g_[64];
+    uint16_t lut_b_[32];
+};
+
+} // namespace eyes
@@ -0,0 +1,60 @@
+#include "command_protocol.hpp"
+
+namespace eyes {
+
+uint8_t CommandParser::crc8(uint8_t crc, uint8_t byte) {
+    // CRC-8/SMBUS (poly 0x07), bitwise: frames are a few bytes, no table needed
+    crc ^= byte;
+    for (int i = 0; i < 8; ++i) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    return crc;
+}
+
+bool CommandParser::payload_len_ok(CommandType t, uint8_t len) {
+    switch (t) {
+        case CommandType::LookAt:      return len == 6;
+        case CommandType::ReleaseLook: return len == 0;
+        case CommandType::Emotion:     return len == 1;
+        case CommandType::Blink:       return len == 0;
+        case CommandType::AudioCue:    return len == 2;
+        case CommandType::Style:       return len == 1;
+        case CommandType::Glow:        return len == 4;
+    }
+    return false;
+}
+
+bool CommandParser::feed(uint8_t byte, uint32_t stamp_us, Command& out) {
+    switch (state_) {
+        case State::Sync0:
+            if (byte == kSync0) state_ = State::Sync1;
+            return false;
+        case State::Sync1:
+            state_ = byte == kSync1 ? State::Type : (byte == kSync0 ? State::Sync1 : State::Sync0);
+            return false;
+        case State::Type:
+            cur_.type = static_cast<CommandType>(byte);
+            crc_ = crc8(0, byte);
+            state_ = State::Len;
+            return false;
+        case State::Len:
+            if (!payload_len_ok(cur_.type, byte)) { ++errors_; state_ = State::Sync0; return false; }
+            cur_.len = byte;
+            crc_ = crc8(crc_, byte);
+            pos_ = 0;
+            state_ = byte ? State::Payload : State::Crc;
+            return false;
+        case State::Payload:
+            cur_.payload[pos_++] = byte;
+            crc_ = crc8(crc_, byte);
+            if (pos_ == cur_.len) state_ = State::Crc;
+            return false;
+        case State::Crc:
+            state_ = State::Sync0;
+            if (byte != crc_) { ++errors_; return false; }
+            cur_.received_us = stamp_us;
+            out = cur_;
+            return true;
+    }
+    return false;
+}
+
+} // namespace eyes
@@ -0,0 +1,55 @@
+// Binary control protocol for live gaze/emotion/blink/audio commands (see docs/control.md).
+#pragma once
+
+#include <cstdint>
+
+namespace eyes {
+
+// Frame: 0xA5 0x5A | type | len | payload[len] | crc8(type, len, payload)
+// Multi-byte payload fields are little-endian.
+enum class CommandType : uint8_t {
+    LookAt      = 0x01, // int16 x, int16 y (1/16 px from centre, 128x128 reference), uint16 distance_mm (0 = far)
+    ReleaseLook = 0x02, // no payload: back to random saccades
+    Emotion     = 0x03, // uint8 emotion index (App::Emotion order)
+    Blink       = 0x04, // no payload
+    AudioCue    = 0x05, // uint8 clip id, uint8 gain (255 = 1.0)
+    Style       = 0x06, // uint8 eye style index (eye_style.hpp registry order)
+    Glow        = 0x07, // uint16 RGB565 colour, uint8 strength (255 = 1.0, 0 = off), uint8 pulse rate (0.1 Hz, 0 = steady)
+};
+
+struct Command {
+    static constexpr int kMaxPayload = 16;
+    CommandType type;
+    uint8_t len;
+    uint8_t payload[kMaxPayload];
+    uint32_t received_us; // arrival time of the frame's last byte (time_us_32 domain)
+
+    int16_t i16(int off) const { return (int16_t)(payload[off] | (payload[off + 1] << 8)); }
+    uint16_t u16(int off) const { return (uint16_t)(payload[off] | (payload[off + 1] << 8)); }
+};
+
+// Incremental frame parser: feed bytes as they arrive (any split), get whole validated commands.
+// Bad CRC, oversize or unknown frames are dropped and the parser resynchronises on the next sync.
+class CommandParser {
+public:
+    static constexpr uint8_t kSync0 = 0xA5;
+    static constexpr uint8_t kSync1 = 0x5A;
+
+    // Returns true when byte completed a valid command (written to out).
+    bool feed(uint8_t byte, uint32_t stamp_us, Command& out);
+    uint32_t errors() const { return errors_; }
+
+    static uint8_t crc8(uint8_t crc, uint8_t byte);
+
+private:
+    enum class State : uint8_t { Sync0, Sync1, Type, Len, Payload, Crc };
+    static bool payload_len_ok(CommandType t, uint8_t len);
+
+    State state_ = State::Sync0;
+    Command cur_{};
+    uint8_t pos_ = 0;
+    uint8_t crc_ = 0;
+    uint32_t errors_ = 0;
+};
+
+} // namespace eyes
@@ -0,0 +1,227 @@
+#include "eye_animator.hpp"
+
+#include <cmath>
+
+namespace eyes {
+
+int EyeAnimator::add_eye(const EyeMount& mount) {
+    if (count_ == kMaxEyes) return -1;
+    const int i = count_;
+    const bool follows = mount.leader >= 0 && mount.leader < i;
+    leader_[i] = (int8_t)(follows ? leader_[mount.leader] : i);
+    mount_x_mm_[i] = mount.x_mm;
+    // Eye 0 keeps the original single-eye-pair seed; others get distinct sequences
+    rng_[i] = 0x12345678u + (uint32_t)i * 0x9E3779B9u;
+    gaze_x_[i] = start_x_[i] = target_x_[i] = prev_x_[i] = frame_w_ * 0.5f;
+    gaze_y_[i] = start_y_[i] = target_y_[i] = prev_y_[i] = frame_h_ * 0.5f;
+    fixation_timer_[i] = 0.f; fixation_len_[i] = 1.0f;
+    saccade_timer_[i] = 0.f; saccade_len_[i] = 0.f;
+    activity_[i] = 0.f;
+    pupil_cur_[i] = pupil_target_[i] = 1.f; breath_phase_[i] = 0.f;
+    blink_state_[i] = kBlinkIdle; blink_timer_[i] = 0.f; next_blink_[i] = 0.f; open_[i] = 1.f;
+    vergence_[i] = vergence_target_[i] = 0.f;
+    out_x_[i] = frame_w_ * 0.5f; out_y_[i] = frame_h_ * 0.5f;
+    out_pupil_[i] = 1.f; out_open_[i] = 1.f;
+    count_ = i + 1;
+    return i;
+}
+
+float EyeAnimator::clamp_x(float x) const {
+    const float lo = (float)margin_, hi = (float)((int)frame_w_ - margin_);
+    return x < lo ? lo : (x > hi ? hi : x);
+}
+
+float EyeAnimator::clamp_y(float y) const {
+    const float lo = (float)margin_, hi = (float)((int)frame_h_ - margin_);
+    return y < lo ? lo : (y > hi ? hi : y);
+}
+
+void EyeAnimator::choose_target(int i) {
+    // Biased sampling inside the margins: favor central region slightly.
+    auto sample_axis = [&](int minV, int maxV) {
+        float r = rand01(i);
+        // Smoothstep bias toward 0.5
+        float b = r*r*(3 - 2*r);
+        return (float)minV + b * (float)(maxV - minV);
+    };
+    float tx = sample_axis(margin_, (int)frame_w_ - margin_);
+    float ty = sample_axis(margin_, (int)frame_h_ - margin_);
+    start_saccade(i, tx, ty);
+}
+
+void EyeAnimator::start_saccade(int i, float tx, float ty) {
+    start_x_[i] = gaze_x_[i];
+    start_y_[i] = gaze_y_[i];
+    target_x_[i] = tx;
+    target_y_[i] = ty;
+    // Saccade duration: small angle -> shorter jump.
+    float dx = tx - start_x_[i];
+    float dy = ty - start_y_[i];
+    float dist = std::sqrt(dx*dx + dy*dy);
+    float len = 0.04f + 0.06f * (dist / 24.f); // 40-100ms typical
+    saccade_len_[i] = len > 0.12f ? 0.12f : len;
+    saccade_timer_[i] = 0.f;
+}
+
+void EyeAnimator::look_at(float x, float y, float distance_mm) {
+    x = clamp_x(x);
+    y = clamp_y(y);
+    look_hold_ = true;
+    for (int i = 0; i < count_; ++i) {
+        if (leader_[i] == i) start_saccade(i, x, y);
+        // Each eye rotates toward the target by atan(offset from the prop centre / distance)
+        float v = 0.f;
+        if (distance_mm > 0.f) v = std::atan(-mount_x_mm_[i] / distance_mm) * kIrisPixelsPerRadian;
+        vergence_target_[i] = v > kMaxVergencePx ? kMaxVergencePx : (v < -kMaxVergencePx ? -kMaxVergencePx : v);
+    }
+}
+
+void EyeAnimator::release_look() {
+    look_hold_ = false;
+    for (int i = 0; i < count_; ++i) vergence_target_[i] = 0.f;
+}
+
+void EyeAnimator::request_blink() {
+    for (int i = 0; i < count_; ++i) {
+        if (leader_[i] != i || blink_state_[i] != kBlinkIdle) continue;
+        blink_state_[i] = kBlinkClosing;
+        blink_timer_[i] = 0.f;
+    }
+}
+
+void EyeAnimator::step_gaze(int i, const AnimInputs& in) {
+    // Gaze state machine: fixation -> saccade
+    if (saccade_len_[i] <= 0.f && fixation_timer_[i] <= 0.f && !look_hold_) {
+        // Initialize first fixation interval (a held look keeps its target)
+        fixation_timer_[i] = 0.f;
+        fixation_len_[i] = 0.8f + rand01(i) * 1.4f; // 0.8 - 2.2s
+        choose_target(i); // sets target & saccade params (not yet moving)
+    }
+    if (saccade_len_[i] > 0.f && saccade_timer_[i] < saccade_len_[i]) {
+        // In saccade (ballistic interpolation with ease-in/out to avoid stepping artifacts visually)
+        saccade_timer_[i] += kStep * in.saccade_speed_scale;
+        float k = saccade_timer_[i] / saccade_len_[i];
+        if (k > 1.f) k = 1.f;
+        // Fast accel/decel curve approximating main-sequence velocity profile
+        float ease = k * k * (3 - 2*k);
+        gaze_x_[i] = start_x_[i] + (target_x_[i] - start_x_[i]) * ease;
+        gaze_y_[i] = start_y_[i] + (target_y_[i] - start_y_[i]) * ease;
+        if (k >= 1.f) {
+            // Start fixation
+            fixation_timer_[i] = 0.f;
+            fixation_len_[i] = (0.8f + rand01(i) * 1.4f) * in.fixation_scale;
+            // Choose new pupil dilation target proportional to upcoming fixation length
+            float lenNorm = (fixation_len_[i] - 0.8f) / 1.4f; // 0..1
+            float base = 0.9f + lenNorm * 0.3f; // 0.9 .. 1.2
+            base *= (0.95f + rand01(i) * 0.10f); // +/-5%
+            if (base < 0.75f) base = 0.75f; else if (base > 1.25f) base = 1.25f;
+            pupil_target_[i] = base + in.pupil_bias;
+            saccade_len_[i] = 0.f;
+        }
+    } else {
+        // In fixation
+        fixation_timer_[i] += kStep;
+        // Small tremor / drift noise
+        float microX = (rand01(i) - 0.5f) * 0.6f; // +/-0.3 px
+        float microY = (rand01(i) - 0.5f) * 0.6f;
+        gaze_x_[i] = clamp_x(gaze_x_[i] + microX * 0.15f); // integrate tiny noise for subtle motion
+        gaze_y_[i] = clamp_y(gaze_y_[i] + microY * 0.15f);
+        if (fixation_timer_[i] >= fixation_len_[i] && !look_hold_) {
+            choose_target(i); // defines new target & saccade
+        }
+    }
+    if (in.has_gaze) {
+        gaze_x_[i] = clamp_x(in.gaze_x);
+        gaze_y_[i] = clamp_y(in.gaze_y);
+    }
+    // Motion activity metric (EMA of gaze velocity)
+    float vx = gaze_x_[i] - prev_x_[i]; // px per frame (20ms)
+    float vy = gaze_y_[i] - prev_y_[i];
+    prev_x_[i] = gaze_x_[i];
+    prev_y_[i] = gaze_y_[i];
+    // Normalize: assume 0..500 px/sec typical range, clamp
+    float norm = std::sqrt(vx*vx + vy*vy) * (1.f / kStep) / 500.f;
+    if (norm > 1.f) norm = 1.f;
+    activity_[i] += (norm - activity_[i]) * 0.08f;
+}
+
+void EyeAnimator::step_pupil(int i, const AnimInputs& in) {
+    if (saccade_len_[i] <= 0.f || saccade_timer_[i] >= saccade_len_[i]) {
+        pupil_cur_[i] += (pupil_target_[i] - pupil_cur_[i]) * 0.05f; // approach target smoothly
+    }
+    breath_phase_[i] += kStep * 0.6f; // slow breathing phase
+    float breath = std::sin(breath_phase_[i]) * 0.02f; // +/-2%
+    float p = pupil_cur_[i] + breath + in.pupil_bias * 0.3f; // soften bias into final (cross-faded)
+    if (in.has_pupil) p = in.pupil_scale;
+    out_pupil_[i] = p < 0.6f ? 0.6f : (p > 1.4f ? 1.4f : p);
+}
+
+void EyeAnimator::step_blink(int i, const AnimInputs& in) {
+    // Randomized blink scheduling state machine
+    float open = 1.f;
+    if (t_ >= next_blink_[i] && blink_state_[i] == kBlinkIdle) {
+        blink_state_[i] = kBlinkClosing;
+        blink_timer_[i] = 0.f;
+    }
+    switch (blink_state_[i]) {
+        case kBlinkIdle:
+            break;
+        case kBlinkClosing: {
+            blink_timer_[i] += kStep;
+            float k = blink_timer_[i] / kBlinkCloseDur;
+            if (k > 1.f) { k = 1.f; blink_state_[i] = kBlinkHold; blink_timer_[i] = 0.f; }
+            k = k*k*(3-2*k);
+            open = 1.f - k;
+        } break;
+        case kBlinkHold:
+            blink_timer_[i] += kStep;
+            open = 0.f;
+            if (blink_timer_[i] >= kBlinkHoldDur) { blink_state_[i] = kBlinkOpening; blink_timer_[i] = 0.f; }
+            break;
+        case kBlinkOpening: {
+            blink_timer_[i] += kStep;
+            float k = blink_timer_[i] / kBlinkOpenDur;
+            if (k > 1.f) {
+                k = 1.f; blink_state_[i] = kBlinkIdle; blink_timer_[i] = 0.f;
+                // Schedule next blink with jitter
+                next_blink_[i] = t_ + kBlinkPeriodBase + rand01(i) * kBlinkPeriodJitter;
+            }
+            k = k*k*(3-2*k);
+            open = k;
+        } break;
+    }
+    if (blink_state_[i] == kBlinkIdle && next_blink_[i] == 0.f) {
+        // Initialize first schedule
+        next_blink_[i] = t_ + kBlinkPeriodBase + rand01(i) * kBlinkPeriodJitter;
+        open = 1.f;
+    }
+    if (in.has_eyelid) open = in.eyelid_open;
+    open_[i] = open;
+}
+
+void EyeAnimator::step(const AnimInputs& in) {
+    t_ += in.dt;
+    // Leaders run the state machines; followers only read their leader's results below
+    for (int i = 0; i < count_; ++i) {
+        if (leader_[i] != i) continue;
+        step_gaze(i, in);
+        step_pupil(i, in);
+        step_blink(i, in);
+    }
+    // Per-eye outputs: leader gaze + shared bias + own vergence, leader pupil, biased lids
+    for (int i = 0; i < count_; ++i) {
+        const int l = leader_[i];
+        vergence_[i] += (vergence_target_[i] - vergence_[i]) * 0.15f;
+        // Kept fractional: the renderer places the eye to a sub-pixel phase, so drift and tremor
+        // move smoothly instead of in whole-pixel steps
+        float x = gaze_x_[l] + in.gaze_bias_x + vergence_[i];
+        const float x_min = (float)margin_, x_max = frame_w_ - (float)margin_;
+        out_x_[i] = x < x_min ? x_min : (x > x_max ? x_max : x);
+        out_y_[i] = gaze_y_[l] + in.gaze_bias_y;
+        out_pupil_[i] = out_pupil_[l];
+        float eo = open_[l] + in.eyelid_bias;
+        out_open_[i] = eo < 0.f ? 0.f : (eo > 1.f ? 1.f : eo);
+    }
+}
+
+} // namespace eyes
@@ -0,0 +1,124 @@
+// Procedural eye animation (saccades and fixation, pupil, blinks, vergence) for up to kMaxEyes eyes.
+// Per-eye state is stored structure-of-arrays and stepped as one batch with shared inputs (emotion
+// modulation, timeline overrides), so a multi-eyed prop costs a few short loops per frame rather
+// than one object update per eye. No hardware dependencies: builds on the host for benchmarking
+// (tools/bench_animator.cpp).
+#pragma once
+
+#include <cstdint>
+
+namespace eyes {
+
+// Where an eye sits on the prop and whom it follows
+struct EyeMount {
+    float x_mm = 0.f;   // horizontal position from the prop centre (negative = left); drives vergence
+    int leader = -1;    // eye whose gaze, pupil and blinks this one shares; -1 = animates itself
+};
+
+// Shared inputs for one step: emotion modulation (already cross-faded) and timeline overrides
+struct AnimInputs {
+    float dt = 0.02f;                   // real seconds since the last step (blink schedule clock)
+    float fixation_scale = 1.f;
+    float saccade_speed_scale = 1.f;
+    float pupil_bias = 0.f;
+    float eyelid_bias = 0.f;
+    float gaze_bias_x = 0.f;            // panel px added to every eye's iris position
+    float gaze_bias_y = 0.f;
+    bool has_gaze = false;              // timeline gaze, absolute panel px
+    float gaze_x = 0.f;
+    float gaze_y = 0.f;
+    bool has_pupil = false;
+    float pupil_scale = 1.f;
+    bool has_eyelid = false;
+    float eyelid_open = 1.f;
+};
+
+class EyeAnimator {
+public:
+    static constexpr int kMaxEyes = 8;
+
+    EyeAnimator(float frame_w, float frame_h) : frame_w_(frame_w), frame_h_(frame_h) {}
+
+    // Returns the new eye's index, or -1 when full. A leader must be added before its followers.
+    int add_eye(const EyeMount& mount);
+    int count() const { return count_; }
+    int leader(int i) const { return leader_[i]; }
+
+    // Gaze centres stay >= margin px from every panel edge (the iris radius keeps it on screen)
+    void set_gaze_margin(int margin) { margin_ = margin; }
+
+    // Hold gaze on a target (panel px) at distance_mm; near targets converge the eyes by mount
+    // position. distance_mm <= 0 means far (parallel).
+    void look_at(float x, float y, float distance_mm);
+    void hold_gaze() { look_hold_ = true; }   // keep the current gaze (timeline drives it)
+    void release_look();
+    void request_blink();
+
+    // Advance every eye by one frame
+    void step(const AnimInputs& in);
+
+    // Per-eye results of the last step
+    float iris_x(int i) const { return out_x_[i]; }   // panel px, fractional
+    float iris_y(int i) const { return out_y_[i]; }
+    float pupil_scale(int i) const { return out_pupil_[i]; }
+    float eyelid_open(int i) const { return out_open_[i]; }
+    float activity(int i) const { return activity_[leader_[i]]; }
+
+private:
+    // Procedural state machines advance one nominal 50 Hz frame per step
+    static constexpr float kStep = 0.02f;
+    static constexpr float kIrisPixelsPerRadian = 48.f; // iris travel per radian of eye rotation
+    static constexpr float kMaxVergencePx = 12.f;
+    enum BlinkState : uint8_t { kBlinkIdle, kBlinkClosing, kBlinkHold, kBlinkOpening };
+    static constexpr float kBlinkCloseDur = 0.12f;
+    static constexpr float kBlinkHoldDur = 0.08f;
+    static constexpr float kBlinkOpenDur = 0.16f;
+    static constexpr float kBlinkPeriodBase = 5.5f;   // average seconds between blinks
+    static constexpr float kBlinkPeriodJitter = 0.9f; // added uniform[0,1) * jitter
+
+    float rand01(int i) {
+        rng_[i] = rng_[i] * 1664525u + 1013904223u; // LCG
+        return (rng_[i] >> 8) * (1.0f / 16777216.0f); // 24-bit to [0,1)
+    }
+    void choose_target(int i);
+    void start_saccade(int i, float tx, float ty);
+    void step_gaze(int i, const AnimInputs& in);
+    void step_pupil(int i, const AnimInputs& in);
+    void step_blink(int i, const AnimInputs& in);
+    float clamp_x(float x) const;
+    float clamp_y(float y) const;
+
+    float frame_w_, frame_h_;
+    int margin_ = 0;
+    int count_ = 0;
+    float t_ = 0.f;
+    bool look_hold_ = false;
+
+    // Structure of arrays, indexed by eye. Gaze, pupil and blink state is only stepped for leaders.
+    int8_t leader_[kMaxEyes];
+    float mount_x_mm_[kMaxEyes];
+    uint32_t rng_[kMaxEyes];
+    // Gaze: current, saccade start and target (panel px)
+    float gaze_x_[kMaxEyes], gaze_y_[kMaxEyes];
+    float start_x_[kMaxEyes], start_y_[kMaxEyes];
+    float target_x_[kMaxEyes], target_y_[kMaxEyes];
+    float fixation_timer_[kMaxEyes], fixation_len_[kMaxEyes];
+    float saccade_timer_[kMaxEyes], saccade_len_[kMaxEyes];
+    // Motion activity (EMA of gaze speed, 0 calm .. 1 very active)
+    float activity_[kMaxEyes];
+    float prev_x_[kMaxEyes], prev_y_[kMaxEyes];
+    // Pupil dilation multiplier and its slow "breathing"
+    float pupil_cur_[kMaxEyes], pupil_target_[kMaxEyes], breath_phase_[kMaxEyes];
+    // Blinks
+    uint8_t blink_state_[kMaxEyes];
+    float blink_timer_[kMaxEyes];
+    float next_blink_[kMaxEyes];        // absolute t_ of the next spontaneous blink (0 = unscheduled)
+    float open_[kMaxEyes];              // lid opening before the emotion bias
+    // Vergence: per-eye horizontal iris offset toward the target (eased)
+    float vergence_[kMaxEyes], vergence_target_[kMaxEyes];
+    // Outputs
+    float out_x_[kMaxEyes], out_y_[kMaxEyes];
+    float out_pupil_[kMaxEyes], out_open_[kMaxEyes];
+};
+
+} // namespace eyes
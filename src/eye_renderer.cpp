@@ -1,7 +1,13 @@
 // Eye rendering implementation
 #include "eye_renderer.hpp"
+#include "pico2_panel.hpp"
+#include "pixel_kernels.hpp"
+#include "procedural_sclera.hpp"
+#include "mem_placement.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <initializer_list>
 
 namespace eyes {
 
@@ -9,161 +15,601 @@ static inline float fast_clamp(float v, float lo, float hi) {
     return v < lo ? lo : (v > hi ? hi : v);
 }
 
-// Internal helpers forward
-static void render_eye_base_impl(uint16_t *frame, const EyeRenderParams &p);
-static void apply_eyelids_impl(uint16_t *frame, const EyeRenderParams &p);
+// Precomputed LUT containers (persist across frames)
+namespace {
+    // Highlight falloff LUT (0..1 distance fraction -> blend factor) 256 entries, value scaled 0..255
+    struct HighlightFalloff {
+        uint8_t primary[256];
+        uint8_t secondary[256];
+    };
+    constexpr HighlightFalloff make_highlight_falloff() {
+        HighlightFalloff f{};
+        for (int i=0;i<256;++i) {
+            float t = (float)i / 255.f; // t = distance fraction (0 center ->1 edge)
+            float fall = 1.f - t;
+            if (fall < 0.f) fall = 0.f; else if (fall > 1.f) fall = 1.f;
+            float sm = fall*fall*(3-2*fall); // smoothstep-ish
+            float sm2 = fall*fall; // sharper for secondary
+            f.primary[i] = (uint8_t)(sm * 255.f + 0.5f);
+            f.secondary[i] = (uint8_t)(sm2 * 255.f + 0.5f);
+        }
+        return f;
+    }
+    constexpr HighlightFalloff g_highlight_falloff = make_highlight_falloff();
 
-void render_eye_base(uint16_t *frame, const EyeRenderParams &p) { render_eye_base_impl(frame,p); }
-void apply_eyelids(uint16_t *frame, const EyeRenderParams &p) { apply_eyelids_impl(frame,p); }
+    // Longest anti-aliased lid edge ramp, in map units (steeper lid slopes are cut off there)
+    constexpr int kLidEdgeMax = 8;
 
-void render_eye(uint16_t *frame, const EyeRenderParams &p) {
-    render_eye_base_impl(frame,p);
-    apply_eyelids_impl(frame,p);
+    // Radius-dependent LUTs and the shared iris sprite for one style, kStyleCacheSlots per panel
+    // instantiation. Everything is zero-initialised (validity flags instead of -1 sentinels) so it
+    // stays in .bss. The table pointers select either the compile-time default tables (flash) or the
+    // RAM copies built for any other radius or iris map size.
+    template <class Panel>
+    struct RenderCache {
+        static constexpr int kR = Panel::kMaxIrisR;
+        static constexpr int kLattice = kR * 2 + 1;
+        const EyeStyle *style;   // nullptr = free slot
+        uint32_t use_tick;       // last render/prepare, for LRU eviction
+        // rsq -> row index
+        bool radius_valid;
+        float last_iris_r;
+        int last_r_int;
+        const uint8_t *rsq_to_row;
+        uint8_t rsq_to_row_ram[(kR+1)*(kR+1)+1];
+        // Angle: we quantize atan2 to the style's iris map columns.
+        // We'll build a dy* (2R+1) table for current radius to avoid atan2 inside loop.
+        bool angle_valid;
+        float angle_last_r;
+        float angle_build_r;     // radius of a partially built RAM lattice (prepare_eye_style)
+        int angle_rows_done;
+        const uint16_t *angle_col; // centre of the lattice; row stride angle_stride
+        int angle_stride;
+        uint16_t angle_col_ram[kLattice * kLattice]; // store column index or 0xFFFF if outside circle
+        // Distance^2 -> primary/secondary blend (0..255) for current radii (avoids per-pixel sqrt)
+        bool highlight_valid;
+        float last_hR;
+        float last_sR;
+        int hR_int_sq; // last primary radius int squared
+        int sR_int_sq; // last secondary radius int squared
+        const uint8_t *highlight_primary_rsq;
+        const uint8_t *highlight_secondary_rsq;
+        uint8_t highlight_primary_rsq_ram[(kR+1)*(kR+1)+1];
+        uint8_t highlight_secondary_rsq_ram[(kR+1)*(kR+1)+1];
+        // Per panel row: max over the row of min(upper, lower) lid thresholds. A row cutoff at or
+        // above it covers the whole row, so shut rows cost one compare in compute_eyelid_spans; the
+        // min is the same for rows with no lid pixel at all.
+        bool lid_rows_valid;
+        uint8_t lid_row_max[Panel::kHeight];
+        uint8_t lid_row_min[Panel::kHeight];
+        // Anti-aliased lid edge: a pixel t = 1..lid_edge_n map units outside the lid gets coverage
+        // lid_edge_alpha[t - 1] (0..32), from the maps' mean slope in units per panel row
+        uint8_t lid_edge_n;
+        uint8_t lid_edge_alpha[kLidEdgeMax];
+        // Shared sprite buffer returned by render_iris_sprite
+        IrisSprite<Panel> sprite;
+    };
+    template <class Panel> RenderCache<Panel> g_cache[kStyleCacheSlots];
+    uint32_t g_style_tick;
+
+    // Compile-time sqrt/atan2 (double) for the default LUTs; results are rounded to float and then
+    // quantised exactly like the runtime builders below.
+    constexpr double cx_sqrt(double v) {
+        if (v <= 0.0) return 0.0;
+        double x = v > 1.0 ? v : 1.0;
+        for (int i = 0; i < 64; ++i) {
+            double nx = 0.5 * (x + v / x);
+            if (nx == x) break;
+            x = nx;
+        }
+        return x;
+    }
+    constexpr double kPi = 3.14159265358979323846;
+    constexpr double cx_atan_unit(double z) { // |z| <= 1
+        // Two half-angle reductions bring |z| under tan(pi/16), then a short odd series
+        z = z / (1.0 + cx_sqrt(1.0 + z * z));
+        z = z / (1.0 + cx_sqrt(1.0 + z * z));
+        double z2 = z * z, term = z, sum = 0.0;
+        for (int k = 0; k < 24; ++k) {
+            sum += term / (2 * k + 1);
+            term *= -z2;
+        }
+        return 4.0 * sum;
+    }
+    constexpr double cx_atan2(double y, double x) {
+        if (x == 0.0 && y == 0.0) return 0.0;
+        double ax = x < 0 ? -x : x, ay = y < 0 ? -y : y;
+        double a = ay <= ax ? cx_atan_unit(ay / ax) : kPi / 2 - cx_atan_unit(ax / ay);
+        if (x < 0) a = kPi - a;
+        return y < 0 ? -a : a;
+    }
+
+    // Quantisers shared by the runtime and compile-time builders
+    constexpr uint8_t radius_row(float r, int map_h) {
+        if (r>1.f) r=1.f;
+        int row = (int)(r * (map_h - 1) + 0.5f);
+        if (row<0) row=0; else if (row>map_h-1) row = map_h-1;
+        return (uint8_t)row;
+    }
+    constexpr uint16_t angle_column(float ang, int map_w) {
+        float ang_norm = (ang + 3.14159265358979323846f) * (1.f / (2.f * 3.14159265358979323846f));
+        int col = (int)(ang_norm * (map_w - 1) + 0.5f);
+        if (col<0) col=0; else if (col>map_w-1) col=map_w-1;
+        return (uint16_t)col;
+    }
+    constexpr uint8_t highlight_level(const uint8_t *falloff, float d) {
+        d = std::clamp(d, 0.f, 1.f);
+        return falloff[(int)(d * 255.f + 0.5f)];
+    }
+
+    // LUTs for the panel's default iris/highlight radii and default iris map size, generated at
+    // compile time into flash so the first frame after boot needs no sqrt/atan2 table builds. Any
+    // style with the same iris size and map dimensions shares them.
+    constexpr EyeRenderParams kDefaultParams{};
+    template <class Panel>
+    struct DefaultIrisLuts {
+        static constexpr float kIrisR = kDefaultIrisRadius<Panel>;
+        static constexpr int kR = (int)(kIrisR + 0.5f);
+        static_assert(kR <= Panel::kMaxIrisR, "default iris must fit the panel's LUTs");
+        static constexpr int kLattice = kR * 2 + 1;
+        static constexpr float kHR = kDefaultParams.highlight_radius_frac * kIrisR;
+        static constexpr float kSR = kDefaultParams.highlight2_radius_frac * kIrisR;
+        static constexpr int kHRi = (int)(kHR + 0.5f);
+        static constexpr int kSRi = (int)(kSR + 0.5f);
+        uint8_t rsq_to_row[kR*kR+1];
+        uint16_t angle_col[kLattice * kLattice];
+        uint8_t highlight_primary_rsq[kHRi*kHRi+1];
+        uint8_t highlight_secondary_rsq[kSRi*kSRi+1];
+    };
+    template <class Panel>
+    constexpr DefaultIrisLuts<Panel> make_default_luts() {
+        using D = DefaultIrisLuts<Panel>;
+        DefaultIrisLuts<Panel> d{};
+        constexpr float inv_r = 1.f / D::kIrisR;
+        for (int rsq = 0; rsq <= D::kR*D::kR; ++rsq)
+            d.rsq_to_row[rsq] = radius_row((float)cx_sqrt(rsq) * inv_r, PME_IRIS_MAP_HEIGHT);
+        for (int y = -D::kR; y <= D::kR; ++y) {
+            for (int x = -D::kR; x <= D::kR; ++x) {
+                int idx = (y + D::kR) * D::kLattice + (x + D::kR);
+                d.angle_col[idx] = x*x + y*y > D::kR*D::kR ? 0xFFFF : angle_column((float)cx_atan2(y, x), PME_IRIS_MAP_WIDTH);
+            }
+        }
+        for (int rsq = 0; rsq <= D::kHRi*D::kHRi; ++rsq)
+            d.highlight_primary_rsq[rsq] = highlight_level(g_highlight_falloff.primary, (float)cx_sqrt(rsq) * (1.f / D::kHR));
+        for (int rsq = 0; rsq <= D::kSRi*D::kSRi; ++rsq)
+            d.highlight_secondary_rsq[rsq] = highlight_level(g_highlight_falloff.secondary, (float)cx_sqrt(rsq) * (1.f / D::kSR));
+        return d;
+    }
+    template <class Panel>
+    constexpr DefaultIrisLuts<Panel> g_default_luts = make_default_luts<Panel>();
+
+    // Panel pixel -> reference asset pixel (nearest). Identity (and skipped) for 128x128 panels.
+    template <int N>
+    struct IndexMap { uint8_t idx[N]; };
+    template <int N, int Ref>
+    constexpr IndexMap<N> make_index_map() {
+        IndexMap<N> m{};
+        for (int i = 0; i < N; ++i) m.idx[i] = (uint8_t)((i * Ref) / N);
+        return m;
+    }
+    template <class Panel>
+    struct AssetMap {
+        static constexpr bool kIdentity = Panel::kWidth == kAssetRefW && Panel::kHeight == kAssetRefH;
+        static constexpr IndexMap<Panel::kWidth> col = make_index_map<Panel::kWidth, kAssetRefW>();
+        static constexpr IndexMap<Panel::kHeight> row = make_index_map<Panel::kHeight, kAssetRefH>();
+    };
+
+    // Spherical projection: screen pixel -> flat eye-texture pixel displacement for an eyeball of
+    // radius kSphereR (panel px) seen head-on. A point at screen distance d from the centre shows
+    // the texture at arc length R*asin(d/R), so the texture compresses toward the rim and the iris
+    // foreshortens as it turns away. Radially symmetric, so one quadrant is stored (flash) and the
+    // other three are sign flips. Indexed by |2x-(W-1)|/2, i.e. pixel-centre distance from the middle.
+    template <class Panel>
+    struct SphereMap {
+        static constexpr int kQW = (Panel::kWidth + 1) / 2;
+        static constexpr int kQH = (Panel::kHeight + 1) / 2;
+        // Sphere slightly larger than the panel's half-diagonal so every pixel (corners too) maps
+        static constexpr float kSphereR = 0.75f * (Panel::kWidth > Panel::kHeight ? Panel::kWidth : Panel::kHeight);
+        int8_t dx[kQH][kQW];
+        int8_t dy[kQH][kQW];
+    };
+    template <class Panel>
+    constexpr SphereMap<Panel> make_sphere_map() {
+        using S = SphereMap<Panel>;
+        SphereMap<Panel> m{};
+        constexpr double R = S::kSphereR;
+        for (int ay = 0; ay < S::kQH; ++ay) {
+            double v = ay + ((Panel::kHeight & 1) ? 0.0 : 0.5);
+            for (int ax = 0; ax < S::kQW; ++ax) {
+                double u = ax + ((Panel::kWidth & 1) ? 0.0 : 0.5);
+                double d = cx_sqrt(u * u + v * v);
+                double k = 0.0;
+                if (d > 0.0) {
+                    double t = d / R;
+                    double arc = R * cx_atan2(t, cx_sqrt(1.0 - t * t)); // R * asin(t)
+                    k = arc / d - 1.0;
+                }
+                double ox = u * k, oy = v * k;
+                m.dx[ay][ax] = (int8_t)(ox + 0.5);
+                m.dy[ay][ax] = (int8_t)(oy + 0.5);
+            }
+        }
+        return m;
+    }
+    template <class Panel>
+    constexpr SphereMap<Panel> g_sphere_map = make_sphere_map<Panel>();
+    // Largest |displacement| in the map: a visible pixel samples at most this far from itself
+    template <class Panel>
+    constexpr int sphere_max_shift() {
+        using S = SphereMap<Panel>;
+        int m = 0;
+        for (int ay = 0; ay < S::kQH; ++ay)
+            for (int ax = 0; ax < S::kQW; ++ax) {
+                const int a = g_sphere_map<Panel>.dx[ay][ax], b = g_sphere_map<Panel>.dy[ay][ax];
+                m = std::max({m, a < 0 ? -a : a, b < 0 ? -b : b});
+            }
+        return m;
+    }
+    template <class Panel>
+    constexpr int kSphereMaxShift = sphere_max_shift<Panel>();
 }
 
-// Precomputed LUT containers (persist across frames)
-namespace {
-    // Max supported iris radius (fits inside 128x128) safeguard
-    constexpr int kMaxIrisR = 64; // since PME_IRIS_WIDTH=80 we only need ~40, keep some headroom
-    // rsq -> row index
-    static uint8_t g_rsq_to_row[(kMaxIrisR+1)*(kMaxIrisR+1)+1];
-    static float   g_last_iris_r = -1.f;
-    static int     g_last_r_int = -1;
-    // Angle: we quantize atan2 to PME_IRIS_MAP_WIDTH columns using octant symmetry.
-    // We'll build a dy* (2R+1) table for current radius to avoid atan2 inside loop.
-    static uint16_t g_angle_col[ (kMaxIrisR*2+1) * (kMaxIrisR*2+1) ]; // store column index or 0xFFFF if outside circle
-    static float g_angle_last_r = -1.f;
-    // Highlight falloff LUT (0..1 distance fraction -> blend factor) 256 entries
-    static bool g_highlight_lut_init = false;
-    static uint8_t g_highlight_primary_lut[256]; // value scaled 0..255
-    static uint8_t g_highlight_secondary_lut[256];
-    // Distance^2 -> primary/secondary blend (0..255) for current radii (avoids per-pixel sqrt)
-    static float g_last_hR = -1.f;
-    static float g_last_sR = -1.f;
-    static int g_hR_int_sq = 0; // last primary radius int squared
-    static int g_sR_int_sq = 0; // last secondary radius int squared
-    static uint8_t g_highlight_primary_rsq[(kMaxIrisR+1)*(kMaxIrisR+1)+1];
-    static uint8_t g_highlight_secondary_rsq[(kMaxIrisR+1)*(kMaxIrisR+1)+1];
-}
-
-static inline void ensure_highlight_luts() {
-    if (g_highlight_lut_init) return;
-    g_highlight_lut_init = true;
-    for (int i=0;i<256;++i) {
-        float t = (float)i / 255.f; // t = distance fraction (0 center ->1 edge)
-        float fall = 1.f - t;
-        if (fall < 0.f) fall = 0.f; else if (fall > 1.f) fall = 1.f;
-        float sm = fall*fall*(3-2*fall); // smoothstep-ish
-        float sm2 = fall*fall; // sharper for secondary
-        g_highlight_primary_lut[i] = (uint8_t)(sm * 255.f + 0.5f);
-        g_highlight_secondary_lut[i] = (uint8_t)(sm2 * 255.f + 0.5f);
-    }
-}
-
-static inline void build_radius_lut(float iris_r) {
+static inline const EyeStyle &style_of(const EyeRenderParams &p) {
+    return p.style ? *p.style : styles::default_eye();
+}
+
+// Time budget for incremental LUT builds; nullptr budget = build to completion
+struct BuildBudget {
+    uint32_t (*now_us)();
+    uint32_t deadline;
+    bool expired() const { return (int32_t)(now_us() - deadline) >= 0; }
+};
+
+// Cache slot for a style: its own slot if it has one, else the least recently used slot, rebound
+template <class Panel>
+static RenderCache<Panel> &cache_for(const EyeStyle &s) {
+    RenderCache<Panel> *slot = &g_cache<Panel>[0];
+    for (RenderCache<Panel> &c : g_cache<Panel>) {
+        if (c.style == &s) { slot = &c; break; }
+        if (c.use_tick < slot->use_tick) slot = &c;
+    }
+    if (slot->style != &s) {
+        slot->style = &s;
+        slot->radius_valid = slot->angle_valid = slot->lid_rows_valid = false;
+        slot->angle_rows_done = 0;
+        slot->angle_build_r = -1.f;
+    }
+    slot->use_tick = ++g_style_tick;
+    return *slot;
+}
+
+template <class Panel>
+static inline void build_radius_lut(RenderCache<Panel> &c, float iris_r) {
+    const EyeStyle &s = *c.style;
     int r_int = (int)(iris_r + 0.5f);
-    if (r_int > kMaxIrisR) r_int = kMaxIrisR;
-    if (iris_r == g_last_iris_r) return;
-    g_last_iris_r = iris_r; g_last_r_int = r_int;
-    float inv_r = 1.f / iris_r;
-    for (int rsq=0; rsq <= r_int*r_int; ++rsq) {
-        float r = std::sqrt((float)rsq) * inv_r;
-        if (r>1.f) r=1.f;
-        int row = (int)(r * (PME_IRIS_MAP_HEIGHT - 1) + 0.5f);
-        if (row<0) row=0; else if (row>PME_IRIS_MAP_HEIGHT-1) row = PME_IRIS_MAP_HEIGHT-1;
-        g_rsq_to_row[rsq] = (uint8_t)row;
+    if (r_int > Panel::kMaxIrisR) r_int = Panel::kMaxIrisR;
+    if (c.radius_valid && iris_r == c.last_iris_r) return;
+    c.radius_valid = true;
+    c.last_iris_r = iris_r; c.last_r_int = r_int;
+    if (iris_r == DefaultIrisLuts<Panel>::kIrisR && s.iris_map_h == PME_IRIS_MAP_HEIGHT) {
+        c.rsq_to_row = g_default_luts<Panel>.rsq_to_row;
+        return;
     }
+    float inv_r = 1.f / iris_r;
+    for (int rsq=0; rsq <= r_int*r_int; ++rsq)
+        c.rsq_to_row_ram[rsq] = radius_row(std::sqrt((float)rsq) * inv_r, s.iris_map_h);
+    c.rsq_to_row = c.rsq_to_row_ram;
 }
 
-static inline void build_angle_lut(float iris_r) {
-    if (iris_r == g_angle_last_r) return;
-    g_angle_last_r = iris_r;
-    int r_int = (int)(iris_r + 0.5f); if (r_int > kMaxIrisR) r_int = kMaxIrisR;
-    int dim = r_int*2 + 1;
-    for (int y=-r_int; y<=r_int; ++y) {
+// Returns false if the budget ran out first; the next call resumes at the next lattice row.
+template <class Panel>
+static inline bool build_angle_lut(RenderCache<Panel> &c, float iris_r, const BuildBudget *budget = nullptr) {
+    constexpr int kLattice = RenderCache<Panel>::kLattice;
+    const EyeStyle &s = *c.style;
+    if (c.angle_valid && iris_r == c.angle_last_r) return true;
+    if (iris_r == DefaultIrisLuts<Panel>::kIrisR && s.iris_map_w == PME_IRIS_MAP_WIDTH) {
+        c.angle_valid = true;
+        c.angle_last_r = iris_r;
+        c.angle_col = g_default_luts<Panel>.angle_col;
+        c.angle_stride = DefaultIrisLuts<Panel>::kLattice;
+        return true;
+    }
+    // The RAM lattice may be in use by the current radius while a new one is built; nothing reads
+    // it until angle_valid is set again, and a partial build restarts if the radius changes.
+    c.angle_valid = false;
+    if (c.angle_build_r != iris_r) { c.angle_build_r = iris_r; c.angle_rows_done = 0; }
+    int r_int = (int)(iris_r + 0.5f); if (r_int > Panel::kMaxIrisR) r_int = Panel::kMaxIrisR;
+    for (int y=-r_int + c.angle_rows_done; y<=r_int; ++y) {
         for (int x=-r_int; x<=r_int; ++x) {
-            int idx = (y + r_int) * (kMaxIrisR*2+1) + (x + r_int);
+            int idx = (y + r_int) * kLattice + (x + r_int);
             int rsq = x*x + y*y;
-            if (rsq > r_int*r_int) { g_angle_col[idx] = 0xFFFF; continue; }
-            float ang = std::atan2((float)y,(float)x); // executed once per lattice build (rare)
-            float ang_norm = (ang + 3.14159265358979323846f) * (1.f / (2.f * 3.14159265358979323846f));
-            int col = (int)(ang_norm * (PME_IRIS_MAP_WIDTH - 1) + 0.5f);
-            if (col<0) col=0; else if (col>PME_IRIS_MAP_WIDTH-1) col=PME_IRIS_MAP_WIDTH-1;
-            g_angle_col[idx] = (uint16_t)col;
+            if (rsq > r_int*r_int) { c.angle_col_ram[idx] = 0xFFFF; continue; }
+            c.angle_col_ram[idx] = angle_column(std::atan2((float)y,(float)x), s.iris_map_w); // once per lattice build (rare)
         }
+        ++c.angle_rows_done;
+        if (budget && y < r_int && budget->expired()) return false;
     }
+    c.angle_valid = true;
+    c.angle_last_r = iris_r;
+    c.angle_build_r = -1.f;
+    c.angle_col = c.angle_col_ram;
+    c.angle_stride = kLattice;
+    return true;
 }
 
-static inline void build_highlight_rsq_luts(float hR, float sR) {
+template <class Panel>
+static inline void build_highlight_rsq_luts(RenderCache<Panel> &c, float hR, float sR) {
+    using D = DefaultIrisLuts<Panel>;
+    constexpr float kMaxR = (float)Panel::kMaxIrisR;
     // Clamp radii into supported range
     if (hR < 0.f) hR = 0.f; if (sR < 0.f) sR = 0.f;
-    if (hR > kMaxIrisR) hR = kMaxIrisR; if (sR > kMaxIrisR) sR = kMaxIrisR;
-    if (hR == g_last_hR && sR == g_last_sR) return;
-    g_last_hR = hR; g_last_sR = sR;
+    if (hR > kMaxR) hR = kMaxR; if (sR > kMaxR) sR = kMaxR;
+    if (c.highlight_valid && hR == c.last_hR && sR == c.last_sR) return;
+    c.highlight_valid = true;
+    c.last_hR = hR; c.last_sR = sR;
     int hRi = (int)(hR + 0.5f);
     int sRi = (int)(sR + 0.5f);
-    g_hR_int_sq = hRi * hRi;
-    g_sR_int_sq = sRi * sRi;
+    c.hR_int_sq = hRi * hRi;
+    c.sR_int_sq = sRi * sRi;
+    if (hR == D::kHR && sR == D::kSR) {
+        c.highlight_primary_rsq = g_default_luts<Panel>.highlight_primary_rsq;
+        c.highlight_secondary_rsq = g_default_luts<Panel>.highlight_secondary_rsq;
+        return;
+    }
     if (hRi > 0) {
         float inv_hR = hR > 0.f ? (1.f / hR) : 0.f;
-        for (int rsq = 0; rsq <= g_hR_int_sq; ++rsq) {
-            float d = std::sqrt((float)rsq) * inv_hR; if (d>1.f) d=1.f; if (d<0.f) d=0.f;
-            int li = (int)(d * 255.f + 0.5f); if (li>255) li=255; if (li<0) li=0;
-            g_highlight_primary_rsq[rsq] = g_highlight_primary_lut[li];
-        }
+        for (int rsq = 0; rsq <= c.hR_int_sq; ++rsq)
+            c.highlight_primary_rsq_ram[rsq] = highlight_level(g_highlight_falloff.primary, std::sqrt((float)rsq) * inv_hR);
     }
     if (sRi > 0) {
         float inv_sR = sR > 0.f ? (1.f / sR) : 0.f;
-        for (int rsq = 0; rsq <= g_sR_int_sq; ++rsq) {
-            float d = std::sqrt((float)rsq) * inv_sR; if (d>1.f) d=1.f; if (d<0.f) d=0.f;
-            int li = (int)(d * 255.f + 0.5f); if (li>255) li=255; if (li<0) li=0;
-            g_highlight_secondary_rsq[rsq] = g_highlight_secondary_lut[li];
-        }
+        for (int rsq = 0; rsq <= c.sR_int_sq; ++rsq)
+            c.highlight_secondary_rsq_ram[rsq] = highlight_level(g_highlight_falloff.secondary, std::sqrt((float)rsq) * inv_sR);
     }
+    c.highlight_primary_rsq = c.highlight_primary_rsq_ram;
+    c.highlight_secondary_rsq = c.highlight_secondary_rsq_ram;
 }
 
-static void render_eye_base_impl(uint16_t *frame, const EyeRenderParams &p) {
-    auto &sclera = get_sclera();
+// Sub-pixel placement: the eye is composed at its integer position, then each output pixel moves a
+// phase/4 of the way toward its left and upper neighbours (O(x) = C(x) + (C(x-1) - C(x)) * phase / 4),
+// one separable integer pass per axis. Only with a rigid sclera (parallax 1) is the whole composite
+// the thing that moves.
+static_assert(kSubpixelPhases == 4, "subpixel_shift uses px::quarter_lerp565x2");
+static inline bool subpixel_active(const EyeRenderParams &p) {
+    return (p.iris_phase_x | p.iris_phase_y) && p.sclera_parallax >= 1.f;
+}
+
+// Top-left of the visible sclera window (reference asset pixels) for this eye's parallax offset
+template <class Panel>
+static inline void sclera_origin(const EyeRenderParams &p, const EyeStyle &s, int &x0, int &y0) {
+    constexpr int W = Panel::kWidth;
+    constexpr int H = Panel::kHeight;
     // Sclera parallax: ensure sclera texture tracks WITH iris motion (rigid eyeball feel).
-    const int marginX = (PME_SCLERA_WIDTH - p.frame_w) / 2; // e.g. 36
-    const int marginY = (PME_SCLERA_HEIGHT - p.frame_h) / 2; // e.g. 36
-    int relX = p.iris_center_x - (p.frame_w / 2); // positive when iris right
-    int relY = p.iris_center_y - (p.frame_h / 2);
+    // The visible window is one reference screen (128x128 sclera pixels) whatever the panel size.
+    const int marginX = (s.sclera_w - kAssetRefW) / 2; // e.g. 36
+    const int marginY = (s.sclera_h - kAssetRefH) / 2; // e.g. 36
+    int relX = p.iris_center_x - (W / 2); // positive when iris right
+    int relY = p.iris_center_y - (H / 2);
     float parallax = p.sclera_parallax;
     if (parallax < 0.f) parallax = 0.f; else if (parallax > 1.f) parallax = 1.f;
     // Move sclera in opposite direction to iris movement for natural eyeball rotation illusion (uncomment next line to move same direction)
     // parallax = -parallax;
     // Previous implementation moved in the opposite perceived direction; invert sign so texture tracks iris.
-    float offXf = -(float)relX * parallax;
-    float offYf = -(float)relY * parallax;
-    int x0 = marginX + (int)std::lround(offXf);
-    int y0 = marginY + (int)std::lround(offYf);
+    float offXf = -(float)relX * parallax * ((float)kAssetRefW / W);
+    float offYf = -(float)relY * parallax * ((float)kAssetRefH / H);
+    x0 = marginX + (int)std::lround(offXf);
+    y0 = marginY + (int)std::lround(offYf);
     if (x0 < 0) x0 = 0; else if (x0 > marginX * 2) x0 = marginX * 2;
     if (y0 < 0) y0 = 0; else if (y0 > marginY * 2) y0 = marginY * 2;
-    for (int y = 0; y < p.frame_h; ++y) {
-        const uint16_t *srcRow = &sclera[y0 + y][x0];
-        uint16_t *dst = frame + y * p.frame_w;
-        for (int x = 0; x < p.frame_w; ++x) dst[x] = srcRow[x];
+}
+
+template <class Panel>
+static void compose_eye_impl(uint16_t *frame, const IrisSprite<Panel> &sprite, const EyeRenderParams &p,
+                             const EyelidSpans<Panel> *spans, FrameRows<Panel> *rows) {
+    constexpr int W = Panel::kWidth;
+    constexpr int H = Panel::kHeight;
+    using Map = AssetMap<Panel>;
+    const EyeStyle &s = style_of(p);
+    const uint16_t *sclera = s.sclera; // nullptr: rows are expanded from s.indexed or synthesised by s.sclera_gen
+    const uint8_t *sclera_idx = !sclera && s.indexed ? s.indexed->sclera : nullptr;
+    const uint16_t *palette = sclera_idx ? s.indexed->sclera_palette : nullptr;
+    int x0, y0;
+    sclera_origin<Panel>(p, s, x0, y0);
+    // Rows the sprite paste below touches
+    const int iy0 = p.iris_center_y - sprite.r, iy1 = p.iris_center_y + sprite.r;
+    if (rows) rows->flash_rows = 0;
+    for (int y = 0; y < H; ++y) {
+        uint16_t *dst = frame + y * W;
+        if (rows) {
+            rows->row[y] = dst;
+            if constexpr (Map::kIdentity) {
+                if (sclera && spans && spans->clear[y] && (y < iy0 || y > iy1) && !subpixel_active(p)) {
+                    rows->row[y] = sclera + (y0 + y) * s.sclera_w + x0;
+                    ++rows->flash_rows;
+                    continue;
+                }
+            }
+        }
+        int xa = 0, xb = W - 1;
+        if (spans) { xa = spans->x0[y]; xb = spans->x1[y]; if (xb < xa) continue; }
+        if constexpr (Map::kIdentity) {
+            const int off = (y0 + y) * s.sclera_w + x0 + xa;
+            if (sclera) px::copy(dst + xa, sclera + off, (size_t)(xb - xa + 1));
+            else if (sclera_idx) px::expand_indexed(dst + xa, sclera_idx + off, palette, (size_t)(xb - xa + 1));
+            else s.sclera_gen->row(dst + xa, x0 + xa, y0 + y, xb - xa + 1);
+        } else if (sclera) {
+            const uint16_t *srcRow = sclera + (y0 + Map::row.idx[y]) * s.sclera_w + x0;
+            for (int x = xa; x <= xb; ++x) dst[x] = srcRow[Map::col.idx[x]];
+        } else if (sclera_idx) {
+            const uint8_t *srcRow = sclera_idx + (y0 + Map::row.idx[y]) * s.sclera_w + x0;
+            for (int x = xa; x <= xb; ++x) dst[x] = palette[srcRow[Map::col.idx[x]]];
+        } else {
+            for (int x = xa; x <= xb; ++x) dst[x] = s.sclera_gen->pixel(x0 + Map::col.idx[x], y0 + Map::row.idx[y]);
+        }
+    }
+
+    // Paste the shared iris disc centred on this eye's iris position (clipped to the frame)
+    const int r = sprite.r;
+    for (int sy = 0; sy <= 2 * r; ++sy) {
+        int fy = p.iris_center_y + sy - r; if ((unsigned)fy >= (unsigned)H) continue;
+        int half = sprite.half_w[sy];
+        int sx0 = r - half, sx1 = r + half;
+        int lo = 0, hi = W - 1;
+        if (spans) { lo = spans->x0[fy]; hi = spans->x1[fy]; }
+        int fx0 = p.iris_center_x + sx0 - r;
+        if (fx0 < lo) { sx0 += lo - fx0; fx0 = lo; }
+        int fx1 = p.iris_center_x + sx1 - r;
+        if (fx1 > hi) sx1 -= fx1 - hi;
+        if (sx1 < sx0) continue;
+        const uint16_t *src = &sprite.px[sy * IrisSprite<Panel>::kStride];
+        uint16_t *d = frame + fy * W + fx0 - sx0; // d[sx] is the frame pixel under sprite column sx
+        const int rim = sprite.rim_w[sy];
+        if (!rim) {
+            std::memcpy(d + sx0, src + sx0, (size_t)(sx1 - sx0 + 1) * sizeof(uint16_t));
+            continue;
+        }
+        // Anti-aliased: copy the interior, blend the rim pixels at either end over the sclera
+        const int dy = sy - r;
+        auto blend_rim = [&](int a, int b) {
+            for (int sx = a; sx <= b; ++sx)
+                d[sx] = px::blend565(d[sx], src[sx], sprite.rim_alpha[(sx - r) * (sx - r) + dy * dy - sprite.rim_lo - 1]);
+        };
+        const int in0 = r - half + rim, in1 = r + half - rim;
+        const int left_end = std::min(sx1, in0 - 1);
+        blend_rim(sx0, left_end);
+        const int a = std::max(sx0, in0), b = std::min(sx1, in1);
+        if (a <= b) std::memcpy(d + a, src + a, (size_t)(b - a + 1) * sizeof(uint16_t));
+        blend_rim(std::max({sx0, in1 + 1, left_end + 1}), sx1);
+    }
+}
+
+// Spherical variant of compose_eye_impl: every screen pixel samples the flat composite (sclera
+// window + iris disc) at its displaced position, using integer lookups only.
+template <class Panel>
+static void compose_eye_spherical_impl(uint16_t *frame, const IrisSprite<Panel> &sprite, const EyeRenderParams &p,
+                                       const EyelidSpans<Panel> *spans) {
+    constexpr int W = Panel::kWidth;
+    constexpr int H = Panel::kHeight;
+    constexpr int kStride = IrisSprite<Panel>::kStride;
+    using Map = AssetMap<Panel>;
+    const SphereMap<Panel> &sm = g_sphere_map<Panel>;
+    const EyeStyle &s = style_of(p);
+    const uint16_t *sclera = s.sclera;
+    const uint8_t *sclera_idx = !sclera && s.indexed ? s.indexed->sclera : nullptr;
+    const uint16_t *palette = sclera_idx ? s.indexed->sclera_palette : nullptr;
+    const int sw = s.sclera_w, sh = s.sclera_h;
+    int x0, y0;
+    sclera_origin<Panel>(p, s, x0, y0);
+    const int r = sprite.r;
+    const int icx = p.iris_center_x, icy = p.iris_center_y;
+    for (int y = 0; y < H; ++y) {
+        uint16_t *dst = frame + y * W;
+        int xa = 0, xb = W - 1;
+        if (spans) { xa = spans->x0[y]; xb = spans->x1[y]; if (xb < xa) continue; }
+        int qy = 2 * y - (H - 1);
+        const int sgn_y = qy < 0 ? -1 : 1;
+        const int8_t *rdx = sm.dx[(qy < 0 ? -qy : qy) >> 1];
+        const int8_t *rdy = sm.dy[(qy < 0 ? -qy : qy) >> 1];
+        auto sclera_at = [&](int wx, int wy) -> uint16_t {
+            int tx, ty;
+            if constexpr (Map::kIdentity) { tx = x0 + wx; ty = y0 + wy; }
+            else { tx = x0 + wx * kAssetRefW / W; ty = y0 + wy * kAssetRefH / H; }
+            // Rim pixels can look past the texture at extreme gaze; hold its edge
+            if (tx < 0) tx = 0; else if (tx > sw - 1) tx = sw - 1;
+            if (ty < 0) ty = 0; else if (ty > sh - 1) ty = sh - 1;
+            if (sclera) return sclera[ty * sw + tx];
+            return sclera_idx ? palette[sclera_idx[ty * sw + tx]] : s.sclera_gen->pixel(tx, ty);
+        };
+        auto sample = [&](int x, int ax, int sgn_x) -> uint16_t {
+            int wx = x + sgn_x * rdx[ax];
+            int wy = y + sgn_y * rdy[ax];
+            int sy = wy - icy + r;
+            if ((unsigned)sy <= (unsigned)(2 * r)) {
+                int sx = wx - icx;
+                int half = sprite.half_w[sy];
+                if (sx >= -half && sx <= half) {
+                    uint16_t c = sprite.px[sy * kStride + sx + r];
+                    int adx = sx < 0 ? -sx : sx;
+                    if (adx <= half - sprite.rim_w[sy]) return c;
+                    int dy = sy - r;
+                    return px::blend565(sclera_at(wx, wy), c, sprite.rim_alpha[sx * sx + dy * dy - sprite.rim_lo - 1]);
+                }
+            }
+            return sclera_at(wx, wy);
+        };
+        // Left half mirrors the quadrant table (sign flip), right half uses it directly
+        const int xm = W / 2;
+        for (int x = xa; x < xm && x <= xb; ++x) dst[x] = sample(x, ((W - 1) - 2 * x) >> 1, -1);
+        for (int x = xa > xm ? xa : xm; x <= xb; ++x) dst[x] = sample(x, (2 * x - (W - 1)) >> 1, 1);
+    }
+}
+
+// Sprite columns [lo, hi] (relative to the disc centre) that some eye shows on sprite row dy;
+// lo > hi = none. A spherical eye samples up to kSphereMaxShift px away from each visible pixel,
+// so it keeps whole sprite rows within that distance of its visible rows.
+template <class Panel>
+static inline void sprite_row_need(const CulledEye<Panel> *eyes, int count, int r, int dy, int &lo, int &hi) {
+    constexpr int H = Panel::kHeight;
+    lo = r + 1; hi = -r - 1;
+    for (int i = 0; i < count; ++i) {
+        const EyeRenderParams &q = *eyes[i].params;
+        const EyelidSpans<Panel> &s = *eyes[i].spans;
+        int fy = q.iris_center_y + dy;
+        if (q.spherical) {
+            if (fy >= s.y0 - kSphereMaxShift<Panel> && fy <= s.y1 + kSphereMaxShift<Panel>) { lo = -r; hi = r; }
+            continue;
+        }
+        if ((unsigned)fy >= (unsigned)H || s.x1[fy] < s.x0[fy]) continue;
+        int a = s.x0[fy] - q.iris_center_x, b = s.x1[fy] - q.iris_center_x;
+        if (a < lo) lo = a;
+        if (b > hi) hi = b;
     }
+}
+
+// Largest dx >= 0 with dx * dx <= limit (-1 when limit < 0)
+static inline int widest_in_disc(int limit) {
+    if (limit < 0) return -1;
+    int w = (int)std::sqrt((float)limit);
+    while ((w + 1) * (w + 1) <= limit) ++w;
+    while (w * w > limit) --w;
+    return w;
+}
+
+// Coverage (0..32, a px::blend565 alpha) of the pixel at rsq from the centre by a disc of radius
+// edge_r: a linear ramp from half a pixel inside the edge to half a pixel outside
+static inline uint8_t disc_coverage(int rsq, float edge_r) {
+    float cover = edge_r + 0.5f - std::sqrt((float)rsq);
+    return (uint8_t)(fast_clamp(cover, 0.f, 1.f) * 32.f + 0.5f);
+}
+
+// Iris map texels by map offset: RGB565 read straight from the map, or an index through a palette.
+// The sprite renderer is instantiated for each, so neither pays for the other in its loops.
+struct DirectTexels {
+    const uint16_t *map;
+    uint16_t operator[](int i) const { return map[i]; }
+};
+struct PaletteTexels {
+    const uint8_t *map;
+    const uint16_t *palette;
+    uint16_t operator[](int i) const { return palette[map[i]]; }
+};
 
-    // Iris + pupil + highlights + optional tint (integrated)
-    auto &irisMap = get_iris_map();
+template <class Panel, class Texels>
+static void render_iris_sprite_impl(RenderCache<Panel> &c, IrisSprite<Panel> &sprite, const EyeRenderParams &p,
+                                    const Texels irisMap, const CulledEye<Panel> *eyes, int eye_count) {
+    constexpr int kStride = IrisSprite<Panel>::kStride;
+    // Iris + pupil + highlights, in sprite-local coordinates
+    const int map_w = c.style->iris_map_w;
     const float iris_r = p.iris_radius;
-    build_radius_lut(iris_r);
-    build_angle_lut(iris_r);
-    ensure_highlight_luts();
+    build_radius_lut(c, iris_r);
+    build_angle_lut(c, iris_r);
     float pupil_r = p.base_pupil_fraction * iris_r * fast_clamp(p.pupil_scale, 0.1f, 2.0f);
     if (pupil_r < 0.f) pupil_r = 0.f;
     float pupil_r_sq = pupil_r * pupil_r;
-    int r_int = g_last_r_int;
-    float ts = (p.tint_enabled && p.tint_strength > 0.f) ? fast_clamp(p.tint_strength, 0.f, 1.f) : 0.f;
-    int tr5 = (p.tint_color >> 11) & 0x1F;
-    int tg6 = (p.tint_color >> 5) & 0x3F;
-    int tb5 = p.tint_color & 0x1F;
+    int r_int = c.last_r_int;
     // Precompute highlight rsq LUTs once per radius change
     float hR = p.highlight_radius_frac * iris_r;
     float sR = p.highlight2_radius_frac * iris_r;
-    build_highlight_rsq_luts(hR, sR);
+    build_highlight_rsq_luts(c, hR, sR);
     float hR2 = hR*hR;
     float sR2 = sR*sR;
     float hx = p.highlight_offset_x_frac * iris_r;
@@ -172,105 +618,525 @@ static void render_eye_base_impl(uint16_t *frame, const EyeRenderParams &p) {
     float sy = p.highlight_offset_y_frac * p.highlight2_offset_scale * iris_r;
     bool do_highlight = p.highlight_enabled && (p.highlight_strength > 0.f);
     bool do_secondary = do_highlight && p.highlight_secondary;
-    int hr5 = (p.highlight_color >> 11) & 0x1F;
-    int hg6 = (p.highlight_color >> 5) & 0x3F;
-    int hb5 = p.highlight_color & 0x1F;
 
+    // Anti-aliasing: only the rsq band within half a pixel of the pupil edge gets a coverage value,
+    // from a table built here over that band (a few dozen sqrt). Inside it is pupil, outside iris.
+    int pupil_in_sq = INT32_MAX, pupil_out_sq = INT32_MAX;
+    uint8_t pupil_alpha[2 * Panel::kMaxIrisR + 4];
+    if (p.antialias && pupil_r < (float)Panel::kMaxIrisR) {
+        pupil_in_sq = pupil_r > 0.5f ? (int)((pupil_r - 0.5f) * (pupil_r - 0.5f)) : -1;
+        pupil_out_sq = (int)std::ceil((pupil_r + 0.5f) * (pupil_r + 0.5f));
+        for (int rsq = pupil_in_sq + 1; rsq < pupil_out_sq; ++rsq)
+            pupil_alpha[rsq - pupil_in_sq - 1] = disc_coverage(rsq, pupil_r);
+    }
+    // Other shapes: a half-width per row from the shape tables; anti-aliased edge pixels take their
+    // coverage across the row (edge + 1/2 - |dx|)
+    const bool shaped = p.pupil_shape != PupilShape::Circle && p.pupil_shape < PupilShape::COUNT;
+    PupilShapeTables::Spans shape;
+    if (shaped) shape = kPupilShapes.spans(p.pupil_shape, pupil_r, PupilShapeTables::dilation(p.pupil_scale));
+    // Rim band: the disc edge ramps out over its last pixel (edge at r_int - 1/4, so the outermost
+    // disc pixels keep a quarter of their weight); compose blends those pixels over the sclera
+    sprite.rim_lo = INT32_MAX;
+    if (p.antialias) {
+        const float rim_r = r_int - 0.25f;
+        sprite.rim_lo = r_int > 1 ? (int)((rim_r - 0.5f) * (rim_r - 0.5f)) : 0;
+        for (int rsq = sprite.rim_lo + 1; rsq <= r_int * r_int; ++rsq)
+            sprite.rim_alpha[rsq - sprite.rim_lo - 1] = disc_coverage(rsq, rim_r);
+    }
+
+    sprite.r = r_int;
     for (int dy=-r_int; dy<=r_int; ++dy) {
-        int fy = p.iris_center_y + dy; if ((unsigned)fy >= (unsigned)p.frame_h) continue;
-        for (int dx=-r_int; dx<=r_int; ++dx) {
-            int fx = p.iris_center_x + dx; if ((unsigned)fx >= (unsigned)p.frame_w) continue;
-            int rsq = dx*dx + dy*dy; if (rsq > r_int*r_int) continue;
-            bool inPupil = (float)rsq <= pupil_r_sq;
-            uint16_t color;
-            if (inPupil) {
-                color = 0x0000;
+        // Row span inside the disc (rsq <= r_int^2)
+        int half = 0;
+        while ((half+1)*(half+1) + dy*dy <= r_int*r_int) ++half;
+        sprite.half_w[dy + r_int] = (uint8_t)half;
+        int rim = 0;
+        while (rim <= half && (half - rim) * (half - rim) + dy * dy > sprite.rim_lo) ++rim;
+        sprite.rim_w[dy + r_int] = (uint8_t)rim;
+        uint16_t *row = &sprite.px[(dy + r_int) * kStride + r_int];
+        int dx0 = -half, dx1 = half;
+        if (eyes) {
+            int lo, hi;
+            sprite_row_need<Panel>(eyes, eye_count, r_int, dy, lo, hi);
+            if (lo > dx0) dx0 = lo;
+            if (hi < dx1) dx1 = hi;
+        }
+        if (dx1 < dx0) continue;
+        // The pupil on this row as spans: |dx| <= core is solid pupil, core < |dx| <= edge are edge
+        // pixels (anti-aliased only), anything further out is iris
+        int core, edge;
+        float shape_w = 0.f;
+        const int dy2 = dy * dy;
+        if (shaped) {
+            shape_w = shape.half_width(dy);
+            if (shape_w <= 0.f) {
+                core = edge = -1;
+            } else if (p.antialias) {
+                core = (int)std::floor(shape_w - 0.5f);
+                edge = (int)std::ceil(shape_w + 0.5f) - 1;
             } else {
-                int iris_row = g_rsq_to_row[rsq];
-                int aidx = (dy + r_int) * (kMaxIrisR*2+1) + (dx + r_int);
-                uint16_t colIdx = g_angle_col[aidx];
-                if (colIdx == 0xFFFF) continue; // outside
-                color = irisMap[iris_row][colIdx];
+                core = edge = (int)shape_w;
+            }
+        } else if (pupil_in_sq != INT32_MAX) {
+            core = widest_in_disc(pupil_in_sq - dy2);
+            edge = widest_in_disc(pupil_out_sq - 1 - dy2);
+        } else {
+            // Exactly the pixels with (float)rsq <= pupil_r_sq
+            core = pupil_r_sq >= (float)dy2 ? (int)std::sqrt(pupil_r_sq - (float)dy2) : -1;
+            while ((float)((core + 1) * (core + 1) + dy2) <= pupil_r_sq) ++core;
+            while (core >= 0 && (float)(core * core + dy2) > pupil_r_sq) --core;
+            edge = core;
+        }
+        // Pupil coverage of an edge pixel, 0..32
+        auto edge_cover = [&](int dx) -> uint32_t {
+            if (!shaped) return pupil_alpha[dx * dx + dy2 - pupil_in_sq - 1];
+            const float cover = shape_w + 0.5f - (float)(dx < 0 ? -dx : dx);
+            return (uint32_t)(fast_clamp(cover, 0.f, 1.f) * 32.f + 0.5f);
+        };
+        auto iris_px = [&](int dx) -> uint16_t {
+            int iris_row = c.rsq_to_row[dx * dx + dy2];
+            int aidx = (dy + r_int) * c.angle_stride + (dx + r_int);
+            return irisMap[iris_row * map_w + c.angle_col[aidx]];
+        };
+        auto edge_px = [&](int dx) {
+            const uint32_t a = edge_cover(dx);
+            row[dx] = a >= 32 ? 0x0000 : (a ? px::blend565(iris_px(dx), 0x0000, a) : iris_px(dx));
+        };
+        // Iris, edge, solid pupil (a span fill), edge, iris
+        const int c0 = std::max(dx0, -core), c1 = std::min(dx1, core);
+        for (int dx = dx0; dx <= std::min(dx1, -edge - 1); ++dx) row[dx] = iris_px(dx);
+        for (int dx = std::max(dx0, -edge); dx <= std::min(dx1, -core - 1); ++dx) edge_px(dx);
+        if (c0 <= c1) std::fill(row + c0, row + c1 + 1, (uint16_t)0x0000);
+        for (int dx = std::max(dx0, core + 1); dx <= std::min(dx1, edge); ++dx) edge_px(dx);
+        for (int dx = std::max(dx0, edge + 1); dx <= dx1; ++dx) row[dx] = iris_px(dx);
+
+        // Highlights, over the columns either glint can reach on this row
+        if (!do_highlight) continue;
+        int hx0 = INT32_MAX, hx1 = INT32_MIN;
+        auto glint_cols = [&](float cx, float cy, float rr2) {
+            const float ddy = dy - cy, w2 = rr2 - ddy * ddy;
+            if (w2 <= 0.f) return;
+            const float w = std::sqrt(w2);
+            hx0 = std::min(hx0, (int)std::floor(cx - w) - 1);
+            hx1 = std::max(hx1, (int)std::ceil(cx + w) + 1);
+        };
+        glint_cols(hx, hy, hR2);
+        if (do_secondary) glint_cols(sx, sy, sR2);
+        hx0 = std::max(hx0, dx0);
+        hx1 = std::min(hx1, dx1);
+        for (int dx = hx0; dx <= hx1; ++dx) {
+            const int adx = dx < 0 ? -dx : dx;
+            const bool inPupil = adx <= core || (adx <= edge && edge_cover(dx) >= 16);
+            if (!p.highlight_over_pupil && inPupil) continue;
+            float hdx = dx - hx; float hdy = dy - hy;
+            float distP2 = hdx*hdx + hdy*hdy; float blend = 0.f;
+            if (distP2 < hR2 && hR2 > 0.f) {
+                int rsqi = (int)(distP2 + 0.5f); if (rsqi < 0) rsqi = 0; if (rsqi > c.hR_int_sq) rsqi = c.hR_int_sq;
+                blend = (c.highlight_primary_rsq[rsqi] / 255.f) * p.highlight_strength;
             }
-            // Highlights
-            if (do_highlight && (p.highlight_over_pupil || !inPupil)) {
-                float hdx = dx - hx; float hdy = dy - hy;
-                float distP2 = hdx*hdx + hdy*hdy; float blend = 0.f;
-                if (distP2 < hR2 && hR2 > 0.f) {
-                    int rsqi = (int)(distP2 + 0.5f); if (rsqi < 0) rsqi = 0; if (rsqi > g_hR_int_sq) rsqi = g_hR_int_sq;
-                    blend = (g_highlight_primary_rsq[rsqi] / 255.f) * p.highlight_strength;
+            if (do_secondary) {
+                float sdx = dx - sx; float sdy = dy - sy; float distS2 = sdx*sdx + sdy*sdy;
+                if (distS2 < sR2 && sR2 > 0.f) {
+                    int rsqi = (int)(distS2 + 0.5f); if (rsqi < 0) rsqi = 0; if (rsqi > c.sR_int_sq) rsqi = c.sR_int_sq;
+                    float b2 = (c.highlight_secondary_rsq[rsqi] / 255.f) * p.highlight_strength;
+                    if (b2 > blend) blend = b2;
                 }
-                if (do_secondary) {
-                    float sdx = dx - sx; float sdy = dy - sy; float distS2 = sdx*sdx + sdy*sdy;
-                    if (distS2 < sR2 && sR2 > 0.f) {
-                        int rsqi = (int)(distS2 + 0.5f); if (rsqi < 0) rsqi = 0; if (rsqi > g_sR_int_sq) rsqi = g_sR_int_sq;
-                        float b2 = (g_highlight_secondary_rsq[rsqi] / 255.f) * p.highlight_strength;
-                        if (b2 > blend) blend = b2;
+            }
+            if (blend > 0.f) row[dx] = px::blend565(row[dx], p.highlight_color, (uint32_t)(blend * 32.f + 0.5f));
+        }
+    }
+}
+
+// The sprite renderer for the style's iris map format (an indexed map through params' palette, if set)
+template <class Panel>
+static void render_iris_sprite_impl(RenderCache<Panel> &c, IrisSprite<Panel> &sprite, const EyeRenderParams &p,
+                                    const CulledEye<Panel> *eyes = nullptr, int eye_count = 0) {
+    const EyeStyle &s = *c.style;
+    if (s.iris_map) {
+        render_iris_sprite_impl(c, sprite, p, DirectTexels{s.iris_map}, eyes, eye_count);
+    } else {
+        const uint16_t *palette = p.iris_palette ? p.iris_palette : s.indexed->iris_palette;
+        render_iris_sprite_impl(c, sprite, p, PaletteTexels{s.indexed->iris_map, palette}, eyes, eye_count);
+    }
+}
+
+// Lid edge ramp for one row: alpha[t - 1] for map values cut + t, t = 1..n (n = 0: aliased)
+struct LidEdge {
+    const uint8_t *alpha;
+    uint32_t n;
+};
+
+// One pixel against both lid thresholds. Covered by both -> bottom colour; an uncovered pixel just
+// past a lid edge is blended toward that lid's colour (the nearer lid when both are close).
+static inline void eyelid_pixel(uint16_t &dst, uint32_t u, uint32_t l, uint32_t cut, uint16_t topColor,
+                                uint16_t botColor, const LidEdge &edge) {
+    if (l <= cut) { dst = botColor; return; }
+    if (u <= cut) { dst = topColor; return; }
+    const uint32_t tu = u - cut, tl = l - cut;
+    const uint32_t au = tu <= edge.n ? edge.alpha[tu - 1] : 0;
+    const uint32_t al = tl <= edge.n ? edge.alpha[tl - 1] : 0;
+    if (al >= au) { if (al) dst = px::blend565(dst, botColor, al); }
+    else dst = px::blend565(dst, topColor, au);
+}
+
+// One eyelid row; Mirror is a template flag so both variants stay tight, fully specialised loops.
+template <class Panel, bool Mirror>
+static inline void apply_eyelid_row(uint16_t *row, const uint8_t *upperRow, const uint8_t *lowerRow,
+                                    float row_cutoff, uint16_t topColor, uint16_t botColor, const LidEdge &edge) {
+    constexpr int W = Panel::kWidth;
+    using Map = AssetMap<Panel>;
+    // u <= row_cutoff (float, >= 0) is u <= floor(row_cutoff) for integer u
+    const uint32_t cut = (uint32_t)row_cutoff;
+    if constexpr (Map::kIdentity && W % 4 == 0) {
+        // Four thresholds per word; most groups of an open eye are uncovered and skip in one test.
+        // Anti-aliased, groups with a pixel on an edge ramp (within cut_edge) go pixel by pixel.
+        const uint32_t cut_edge = cut + edge.n > 255 ? 255 : cut + edge.n;
+        for (int x = 0; x < W; x += 4) {
+            const int sx = Mirror ? W - 4 - x : x;
+            const uint32_t ub = px::load32(upperRow + sx), lb = px::load32(lowerRow + sx);
+            uint32_t top, bot;
+            if (edge.n) {
+                // The wide compare first: groups clear of both lids and their edges still skip in one test
+                const uint32_t near = px::le_mask4(ub, cut_edge) | px::le_mask4(lb, cut_edge);
+                if (near == 0) continue;
+                top = px::le_mask4(ub, cut);
+                bot = px::le_mask4(lb, cut);
+                if (near & ~(top | bot)) {
+                    for (int i = 0; i < 4; ++i) {
+                        const int b = 8 * (Mirror ? 3 - i : i);
+                        eyelid_pixel(row[x + i], (ub >> b) & 0xFFu, (lb >> b) & 0xFFu, cut, topColor, botColor, edge);
                     }
+                    continue;
                 }
-                if (blend > 0.f) {
-                    int r5 = (color >> 11) & 0x1F;
-                    int g6 = (color >> 5) & 0x3F;
-                    int b5 = color & 0x1F;
-                    r5 = (int)(r5 + (hr5 - r5) * blend + 0.5f);
-                    g6 = (int)(g6 + (hg6 - g6) * blend + 0.5f);
-                    b5 = (int)(b5 + (hb5 - b5) * blend + 0.5f);
-                    color = (uint16_t)((r5<<11)|(g6<<5)|b5);
-                }
+            } else {
+                top = px::le_mask4(ub, cut);
+                bot = px::le_mask4(lb, cut);
+                if ((top | bot) == 0) continue;
             }
-            // Tint
-            if (ts > 0.f) {
-                int r5 = (color >> 11) & 0x1F; int g6 = (color >> 5) & 0x3F; int b5 = color & 0x1F;
-                r5 = (int)(r5 + (tr5 - r5) * ts + 0.5f);
-                g6 = (int)(g6 + (tg6 - g6) * ts + 0.5f);
-                b5 = (int)(b5 + (tb5 - b5) * ts + 0.5f);
-                color = (uint16_t)((r5<<11)|(g6<<5)|b5);
+            if (Mirror) { top = px::reverse4(top); bot = px::reverse4(bot); }
+            for (int i = 0; i < 4; ++i, top >>= 8, bot >>= 8) {
+                // Both covered -> bottom colour, as in the scalar path
+                if (bot & 1) row[x + i] = botColor;
+                else if (top & 1) row[x + i] = topColor;
             }
-            frame[fy * p.frame_w + fx] = color;
         }
+        return;
+    }
+    for (int x = 0; x < W; ++x) {
+        int sx = Mirror ? W - 1 - x : x;
+        if constexpr (!Map::kIdentity) sx = Map::col.idx[sx];
+        eyelid_pixel(row[x], upperRow[sx], lowerRow[sx], cut, topColor, botColor, edge);
     }
 }
 
-static void apply_eyelids_impl(uint16_t *frame, const EyeRenderParams &p) {
+// Eyelid threshold for the whole eye, then per row with the emotion shape adjustment (0..255);
+// a map value <= the row cutoff is covered.
+static inline float eyelid_cutoff(const EyeRenderParams &p) {
     float open = fast_clamp(p.eyelid_open, 0.f, 1.f);
-    auto &upperMap = get_upper_eyelid();
-    auto &lowerMap = get_lower_eyelid();
     float base_edge = (float)p.eyelid_edge_base;
-    float cutoff = base_edge + (1.f - open) * (255.f - base_edge);
-    uint16_t topColor = p.eyelid_color_top;
-    uint16_t botColor = p.eyelid_color_bottom;
-    for (int y = 0; y < p.frame_h; ++y) {
-        uint16_t *row = frame + y * p.frame_w;
-        float row_adjust = 0.f;
-        if (p.upper_shape_adjust || p.lower_shape_adjust) {
-            if (p.upper_shape_adjust) row_adjust = (float)p.upper_shape_adjust[y];
-            if (p.lower_shape_adjust) row_adjust += (float)p.lower_shape_adjust[y];
+    return base_edge + (1.f - open) * (255.f - base_edge);
+}
+static inline float eyelid_row_cutoff(const EyeRenderParams &p, float cutoff, int y) {
+    float row_adjust = 0.f;
+    if (p.upper_shape_adjust || p.lower_shape_adjust) {
+        if (p.upper_shape_adjust) row_adjust = (float)p.upper_shape_adjust[y];
+        if (p.lower_shape_adjust) row_adjust += (float)p.lower_shape_adjust[y];
+    }
+    float row_cutoff = cutoff + row_adjust;
+    if (row_cutoff < 0.f) row_cutoff = 0.f; else if (row_cutoff > 255.f) row_cutoff = 255.f;
+    return row_cutoff;
+}
+
+// Grow each row's span to what the shift samples: the row's own and the next row's spans (next
+// output row reads this one), plus one column to the left. The extra pixels are all under the lids.
+template <class Panel>
+static void widen_spans_for_shift(EyelidSpans<Panel> &s) {
+    constexpr int H = Panel::kHeight;
+    s.shifted = true;
+    if (s.y1 < s.y0) return;
+    for (int y = s.y0 - 1 < 0 ? 0 : s.y0 - 1; y <= s.y1; ++y) {
+        int lo = Panel::kWidth, hi = -1;
+        if (s.x1[y] >= s.x0[y]) { lo = s.x0[y]; hi = s.x1[y]; }
+        if (y + 1 < H && s.x1[y + 1] >= s.x0[y + 1]) {
+            if (s.x0[y + 1] < lo) lo = s.x0[y + 1];
+            if (s.x1[y + 1] > hi) hi = s.x1[y + 1];
         }
-        float row_cutoff = cutoff + row_adjust;
-        if (row_cutoff < 0.f) row_cutoff = 0.f; else if (row_cutoff > 255.f) row_cutoff = 255.f;
-        if (!p.mirror_eyelids) {
-            for (int x = 0; x < p.frame_w; ++x) {
-                uint8_t u = upperMap[y][x];
-                uint8_t l = lowerMap[y][x];
-                bool coverTop = u <= row_cutoff;
-                bool coverBottom = l <= row_cutoff;
-                if (coverTop || coverBottom) {
-                    row[x] = (coverTop && coverBottom) ? botColor : (coverTop ? topColor : botColor);
-                }
+        s.x0[y] = (int16_t)(lo > 0 ? lo - 1 : 0);
+        s.x1[y] = (int16_t)hi;
+    }
+    if (s.y0 > 0) --s.y0;
+}
+
+// Shift the composed eye right/down by its phase, in place (bottom-up, right-to-left, so every read
+// is of a not yet shifted pixel), two pixels per word. Frame edges keep the edge pixel.
+template <class Panel>
+static void subpixel_shift(uint16_t *frame, const EyeRenderParams &p, const EyelidSpans<Panel> *spans) {
+    constexpr int W = Panel::kWidth;
+    constexpr int H = Panel::kHeight;
+    const unsigned phx = p.iris_phase_x, phy = p.iris_phase_y;
+    int ya = 0, yb = H - 1;
+    if (spans) { ya = spans->y0; yb = spans->y1; }
+    if (phx) {
+        for (int y = yb; y >= ya; --y) {
+            uint16_t *row = frame + y * W;
+            int xa = 0, xb = W - 1;
+            if (spans) { xa = spans->x0[y]; xb = spans->x1[y]; }
+            int x = xb;
+            for (; x - 1 > xa; x -= 2)  // pixels x-1, x from x-2 .. x
+                px::store32(row + x - 1, px::quarter_lerp565x2(px::load32(row + x - 1), px::load32(row + x - 2), phx));
+            if (x > xa) row[x] = (uint16_t)px::quarter_lerp565x2(row[x], row[x - 1], phx);
+        }
+    }
+    if (phy) {
+        for (int y = yb; y > ya; --y) {
+            uint16_t *row = frame + y * W;
+            const uint16_t *up = row - W;
+            int xa = 0, xb = W - 1;
+            if (spans) { xa = spans->x0[y]; xb = spans->x1[y]; }
+            int x = xa;
+            for (; x + 1 <= xb; x += 2)
+                px::store32(row + x, px::quarter_lerp565x2(px::load32(row + x), px::load32(up + x), phy));
+            if (x <= xb) row[x] = (uint16_t)px::quarter_lerp565x2(row[x], up[x], phy);
+        }
+    }
+}
+
+// Per-style lid tables: row extremes for compute_eyelid_spans and the anti-aliased edge ramp
+template <class Panel>
+static void build_lid_rows(RenderCache<Panel> &c) {
+    constexpr int H = Panel::kHeight;
+    using Map = AssetMap<Panel>;
+    if (c.lid_rows_valid) return;
+    const EyeStyle &s = *c.style;
+    for (int y = 0; y < H; ++y) {
+        const int my = Map::kIdentity ? y : Map::row.idx[y];
+        const uint8_t *u = s.upper + my * kAssetRefW;
+        const uint8_t *l = s.lower + my * kAssetRefW;
+        uint8_t m = 0, n = 255;
+        for (int x = 0; x < kAssetRefW; ++x) {
+            m = std::max(m, std::min(u[x], l[x]));
+            n = std::min(n, std::min(u[x], l[x]));
+        }
+        c.lid_row_max[y] = m;
+        c.lid_row_min[y] = n;
+    }
+    // Mean vertical slope of both maps where they ramp (saturated 0/255 areas left out). The edge lies
+    // half a unit past the cutoff, so a pixel t units past it is (t - 1/2) / slope rows outside.
+    uint32_t sum = 0, count = 0;
+    for (const uint8_t *map : {s.upper, s.lower}) {
+        for (int y = 0; y + 1 < kAssetRefH; ++y) {
+            const uint8_t *a = map + y * kAssetRefW, *b = a + kAssetRefW;
+            for (int x = 0; x < kAssetRefW; ++x) {
+                if (a[x] == 0 || a[x] == 255 || b[x] == 0 || b[x] == 255) continue;
+                sum += a[x] > b[x] ? a[x] - b[x] : b[x] - a[x];
+                ++count;
             }
-        } else {
-            for (int x = 0; x < p.frame_w; ++x) {
-                int mx = p.frame_w - 1 - x;
-                uint8_t u = upperMap[y][mx];
-                uint8_t l = lowerMap[y][mx];
-                bool coverTop = u <= row_cutoff;
-                bool coverBottom = l <= row_cutoff;
-                if (coverTop || coverBottom) {
-                    row[x] = (coverTop && coverBottom) ? botColor : (coverTop ? topColor : botColor);
+        }
+    }
+    const float slope = count ? (float)sum / count * kAssetRefH / H : 0.f;
+    c.lid_edge_n = 0;
+    for (int t = 1; t <= kLidEdgeMax && slope > 0.f; ++t) {
+        float cover = 0.5f - (t - 0.5f) / slope;
+        int a = (int)(cover * 32.f + 0.5f);
+        if (a <= 0) break;
+        c.lid_edge_alpha[t - 1] = (uint8_t)a;
+        c.lid_edge_n = (uint8_t)t;
+    }
+    c.lid_rows_valid = true;
+}
+
+template <class Panel>
+static void compute_eyelid_spans_impl(const EyeRenderParams &p, EyelidSpans<Panel> &out) {
+    constexpr int W = Panel::kWidth;
+    constexpr int H = Panel::kHeight;
+    using Map = AssetMap<Panel>;
+    const EyeStyle &s = style_of(p);
+    RenderCache<Panel> &c = cache_for<Panel>(s);
+    build_lid_rows(c);
+    // Anti-aliased edges reach past the lid: a row is clear only if none of its pixels gets blended
+    const int edge_n = p.antialias ? c.lid_edge_n : 0;
+    const float cutoff = eyelid_cutoff(p);
+    out.y0 = H; out.y1 = -1;
+    out.shifted = false;
+    for (int y = 0; y < H; ++y) {
+        const int my = Map::kIdentity ? y : Map::row.idx[y];
+        const uint8_t *u = s.upper + my * kAssetRefW;
+        const uint8_t *l = s.lower + my * kAssetRefW;
+        const float row_cutoff = eyelid_row_cutoff(p, cutoff, y);
+        int first = -1, last = -1; // in map columns (identity) or frame columns
+        out.clear[y] = 0;
+        if (c.lid_row_max[y] <= row_cutoff) { out.x0[y] = 0; out.x1[y] = -1; continue; }
+        if (c.lid_row_min[y] > row_cutoff) {
+            out.clear[y] = c.lid_row_min[y] > row_cutoff + edge_n;
+            out.x0[y] = 0; out.x1[y] = (int16_t)(W - 1);
+            if (out.y0 > y) out.y0 = y;
+            out.y1 = y;
+            continue;
+        }
+        if constexpr (Map::kIdentity && W % 4 == 0) {
+            // Same word test as apply_eyelid_row, scanning in from both ends
+            const uint32_t cut = (uint32_t)row_cutoff;
+            for (int sx = 0; sx < W; sx += 4) {
+                uint32_t vis = ~(px::le_mask4(px::load32(u + sx), cut) | px::le_mask4(px::load32(l + sx), cut));
+                if (vis) { first = sx + (__builtin_ctz(vis) >> 3); break; }
+            }
+            if (first >= 0) {
+                for (int sx = W - 4; sx >= 0; sx -= 4) {
+                    uint32_t vis = ~(px::le_mask4(px::load32(u + sx), cut) | px::le_mask4(px::load32(l + sx), cut));
+                    if (vis) { last = sx + 3 - (__builtin_clz(vis) >> 3); break; }
                 }
+                if (p.mirror_eyelids) { int f = W - 1 - last; last = W - 1 - first; first = f; }
             }
+        } else {
+            auto visible = [&](int x) {
+                int sx = p.mirror_eyelids ? W - 1 - x : x;
+                if constexpr (!Map::kIdentity) sx = Map::col.idx[sx];
+                return u[sx] > row_cutoff && l[sx] > row_cutoff;
+            };
+            for (int x = 0; x < W; ++x) if (visible(x)) { first = x; break; }
+            if (first >= 0) for (int x = W - 1; x >= first; --x) if (visible(x)) { last = x; break; }
+        }
+        if (first < 0) { out.x0[y] = 0; out.x1[y] = -1; continue; }
+        out.x0[y] = (int16_t)first; out.x1[y] = (int16_t)last;
+        if (out.y0 > y) out.y0 = y;
+        out.y1 = y;
+    }
+    if (subpixel_active(p)) widen_spans_for_shift(out);
+}
+
+template <class Panel>
+static void apply_eyelids_impl(uint16_t *frame, const EyeRenderParams &p) {
+    constexpr int W = Panel::kWidth;
+    constexpr int H = Panel::kHeight;
+    using Map = AssetMap<Panel>;
+    const EyeStyle &s = style_of(p);
+    const uint8_t *upperMap = s.upper;
+    const uint8_t *lowerMap = s.lower;
+    const float cutoff = eyelid_cutoff(p);
+    uint16_t topColor = p.eyelid_color_top;
+    uint16_t botColor = p.eyelid_color_bottom;
+    LidEdge edge{nullptr, 0};
+    if (p.antialias) {
+        RenderCache<Panel> &c = cache_for<Panel>(s);
+        build_lid_rows(c);
+        edge = LidEdge{c.lid_edge_alpha, c.lid_edge_n};
+    }
+    for (int y = 0; y < H; ++y) {
+        uint16_t *row = frame + y * W;
+        const int my = Map::kIdentity ? y : Map::row.idx[y];
+        float row_cutoff = eyelid_row_cutoff(p, cutoff, y);
+        if (!p.mirror_eyelids) {
+            apply_eyelid_row<Panel, false>(row, upperMap + my * kAssetRefW, lowerMap + my * kAssetRefW, row_cutoff, topColor, botColor, edge);
+        } else {
+            apply_eyelid_row<Panel, true>(row, upperMap + my * kAssetRefW, lowerMap + my * kAssetRefW, row_cutoff, topColor, botColor, edge);
+        }
+    }
+}
+
+template <class Panel>
+const IrisSprite<Panel>& render_iris_sprite(const EyeRenderParams &p) {
+    RenderCache<Panel> &c = cache_for<Panel>(style_of(p));
+    render_iris_sprite_impl(c, c.sprite, p);
+    return c.sprite;
+}
+
+template <class Panel>
+const IrisSprite<Panel>& render_iris_sprite(const EyeRenderParams &p, const CulledEye<Panel> *eyes, int count) {
+    RenderCache<Panel> &c = cache_for<Panel>(style_of(p));
+    render_iris_sprite_impl(c, c.sprite, p, eyes, count);
+    return c.sprite;
+}
+
+template <class Panel>
+void compute_eyelid_spans(const EyeRenderParams &p, EyelidSpans<Panel> &out) {
+    compute_eyelid_spans_impl<Panel>(p, out);
+}
+
+template <class Panel>
+void widen_eyelid_spans(const EyeRenderParams &p, EyelidSpans<Panel> &spans) {
+    if (subpixel_active(p) && !spans.shifted) widen_spans_for_shift(spans);
+}
+
+template <class Panel>
+bool prepare_eye_style(const EyeRenderParams &p, uint32_t budget_us, uint32_t (*now_us)()) {
+    const BuildBudget budget{now_us, now_us() + budget_us};
+    RenderCache<Panel> &c = cache_for<Panel>(style_of(p));
+    // The radius and highlight tables are a few thousand sqrt each; only the lattice is split
+    build_radius_lut(c, p.iris_radius);
+    if (!build_angle_lut(c, p.iris_radius, &budget)) return false;
+    if (budget.expired()) return false;
+    build_highlight_rsq_luts(c, p.highlight_radius_frac * p.iris_radius, p.highlight2_radius_frac * p.iris_radius);
+    return true;
+}
+
+template <class Panel>
+void forget_eye_style(const EyeStyle &s) {
+    for (RenderCache<Panel> &c : g_cache<Panel>) {
+        if (c.style != &s) continue;
+        c.style = nullptr; // rebound (and its LUTs invalidated) by the next cache_for
+        c.use_tick = 0;
+    }
+}
+
+template <class Panel>
+void compose_eye(uint16_t *frame, const IrisSprite<Panel> &sprite, const EyeRenderParams &p, const EyelidSpans<Panel> *spans,
+                 FrameRows<Panel> *rows) {
+    if (p.spherical) {
+        // Every row is warped, so every row comes from the frame
+        compose_eye_spherical_impl(frame, sprite, p, spans);
+        if (rows) {
+            for (int y = 0; y < Panel::kHeight; ++y) rows->row[y] = frame + y * Panel::kWidth;
+            rows->flash_rows = 0;
         }
+    } else {
+        compose_eye_impl(frame, sprite, p, spans, rows);
     }
+    if (subpixel_active(p)) subpixel_shift<Panel>(frame, p, spans);
 }
 
+template <class Panel>
+void render_eye_base(uint16_t *frame, const EyeRenderParams &p) {
+    compose_eye<Panel>(frame, render_iris_sprite<Panel>(p), p);
+}
+
+template <class Panel>
+void apply_eyelids(uint16_t *frame, const EyeRenderParams &p) {
+    apply_eyelids_impl<Panel>(frame, p);
+}
+
+template <class Panel>
+void render_eye(uint16_t *frame, const EyeRenderParams &p) {
+    // Lids first, so only what they leave visible is rendered
+    EyelidSpans<Panel> spans;
+    compute_eyelid_spans_impl<Panel>(p, spans);
+    const CulledEye<Panel> eye{&p, &spans};
+    compose_eye<Panel>(frame, render_iris_sprite<Panel>(p, &eye, 1), p, &spans);
+    apply_eyelids_impl<Panel>(frame, p);
+}
+
+// Explicit instantiations: one block per supported panel geometry. Only instantiated panels get
+// LUT/sprite storage, so unused geometries cost nothing. The cache is specialised first so it lands
+// in the named LUT section (section attributes are ignored on the variable template itself).
+#define PME_INSTANTIATE_EYE_RENDERER(P) \
+    namespace { template <> PME_LUT_RAM RenderCache<P> g_cache<P>[kStyleCacheSlots]{}; } \
+    template void render_eye<P>(uint16_t*, const EyeRenderParams&); \
+    template void render_eye_base<P>(uint16_t*, const EyeRenderParams&); \
+    template const IrisSprite<P>& render_iris_sprite<P>(const EyeRenderParams&); \
+    template const IrisSprite<P>& render_iris_sprite<P>(const EyeRenderParams&, const CulledEye<P>*, int); \
+    template void compute_eyelid_spans<P>(const EyeRenderParams&, EyelidSpans<P>&); \
+    template void widen_eyelid_spans<P>(const EyeRenderParams&, EyelidSpans<P>&); \
+    template bool prepare_eye_style<P>(const EyeRenderParams&, uint32_t, uint32_t (*)()); \
+    template void forget_eye_style<P>(const EyeStyle&); \
+    template void compose_eye<P>(uint16_t*, const IrisSprite<P>&, const EyeRenderParams&, const EyelidSpans<P>*, FrameRows<P>*); \
+    template void apply_eyelids<P>(uint16_t*, const EyeRenderParams&);
+
+PME_INSTANTIATE_EYE_RENDERER(ActivePanel)
+#if PME_HOST_BUILD
+// Host builds also instantiate a 240x240 panel, so a second geometry keeps compiling
+// (tools/render_bench.cpp renders at it)
+PME_INSTANTIATE_EYE_RENDERER(Panel240x240)
+#endif
+
+#undef PME_INSTANTIATE_EYE_RENDERER
+
 } // namespace eyes
@@ -2,20 +2,50 @@
 #pragma once
 #include <cstdint>
 #include "default_eye.hpp"
+#include "eye_style.hpp"
+#include "panel_geometry.hpp"
+#include "pupil_shape.hpp"
 
 namespace eyes {
 
+// Eye assets (sclera window, eyelid maps, iris size) are authored for a 128x128 reference screen;
+// other panel sizes sample them through compile-time index tables.
+constexpr int kAssetRefW = PME_EYELID_WIDTH;
+constexpr int kAssetRefH = PME_EYELID_HEIGHT;
+
+// Default iris radius on a panel (asset iris scaled to the panel width). Its radius/angle/highlight
+// LUTs are generated at compile time; other radii build RAM tables on first use.
+template <class Panel>
+constexpr float kDefaultIrisRadius = PME_IRIS_WIDTH * 0.5f * Panel::kWidth / kAssetRefW;
+
+// Iris radius of a style on a panel (equals kDefaultIrisRadius for the default style)
+template <class Panel>
+inline float style_iris_radius(const EyeStyle &s) { return s.iris_w * 0.5f * Panel::kWidth / kAssetRefW; }
+
+// Styles whose LUTs + sprite are cached at once: the active one and one being switched to.
+// A third style evicts the least recently rendered slot.
+constexpr int kStyleCacheSlots = 2;
+
+// Sub-pixel iris placement: positions are quantised to 1/kSubpixelPhases px (see set_iris_position)
+constexpr int kSubpixelPhases = 4;
+
 struct EyeRenderParams {
-    int frame_w = 128;
-    int frame_h = 128;
     int iris_center_x = 64;
     int iris_center_y = 64;
+    // Fraction of a pixel (in 1/kSubpixelPhases) the eye sits right of / below iris_center_x/y. The
+    // composed eye (iris and sclera together) is shifted by it, so only with sclera_parallax = 1.
+    uint8_t iris_phase_x = 0;
+    uint8_t iris_phase_y = 0;
+    const EyeStyle *style = nullptr;             // asset set; nullptr = styles::default_eye()
     float iris_radius = PME_IRIS_WIDTH * 0.5f;   // pixels
     float base_pupil_fraction = 0.30f;           // baseline fraction of iris radius
     float pupil_scale = 1.0f;                    // dynamic multiplier (animation/dilation)
+    PupilShape pupil_shape = PupilShape::Circle; // span-table shapes scale with the radius above and dilate with pupil_scale
     float eyelid_open = 1.0f;                    // 1 = fully open, 0 = fully closed
     uint8_t eyelid_edge_base = 2;                // thinner baseline eyelid edge when fully open
     float sclera_parallax = 0.0f;                // locked (no sclera motion)
+    bool spherical = false;                      // warp sclera+iris onto a sphere (compile-time displacement map)
+    bool antialias = false;                      // blend pupil, iris rim and eyelid edge pixels by coverage
     // Eyelid colors (RGB565). Both black per request.
     uint16_t eyelid_color_top = 0x0000;           // black
     uint16_t eyelid_color_bottom = 0x0000;        // black
@@ -30,26 +60,125 @@ struct EyeRenderParams {
     uint16_t highlight_color = 0xFFFF;           // RGB565 white
     float highlight2_radius_frac = 0.06f;        // secondary highlight radius fraction
     float highlight2_offset_scale = 0.55f;       // secondary placed closer to center
-    // Emotion / style tint (applied to sclera+iris before eyelids). strength 0..1
-    bool tint_enabled = false;
-    uint16_t tint_color = 0;                     // RGB565
-    float tint_strength = 0.0f;                  // 0=no tint
+    // Emotion tint is a whole-frame color stage applied on transmit (see color_pipeline.hpp)
+    // Iris palette for a palette-indexed style, e.g. an animated copy of the style's (see
+    // indexed_assets.hpp); nullptr = the style's own. Ignored for an RGB565 iris map.
+    const uint16_t *iris_palette = nullptr;
     // Per-row eyelid shape adjustment (signed additive to cutoff). nullptr if unused.
-    const int8_t* upper_shape_adjust = nullptr;  // length frame_h
-    const int8_t* lower_shape_adjust = nullptr;  // length frame_h
+    const int8_t* upper_shape_adjust = nullptr;  // length Panel::kHeight
+    const int8_t* lower_shape_adjust = nullptr;  // length Panel::kHeight
     // Horizontal mirroring of eyelid masks (use for right eye so medial canthus faces center).
     bool mirror_eyelids = false;
 };
 
-// Renders sclera + iris + pupil (dilated) into frame (RGB565). frame length = frame_w*frame_h.
+// Place the iris at a fractional panel position: nearest 1/kSubpixelPhases px, split into the integer
+// centre and phase (positions are >= 0, the gaze margin keeps them on screen)
+inline void set_iris_position(EyeRenderParams &p, float x, float y) {
+    int qx = (int)(x * kSubpixelPhases + 0.5f), qy = (int)(y * kSubpixelPhases + 0.5f);
+    p.iris_center_x = qx / kSubpixelPhases; p.iris_phase_x = (uint8_t)(qx % kSubpixelPhases);
+    p.iris_center_y = qy / kSubpixelPhases; p.iris_phase_y = (uint8_t)(qy % kSubpixelPhases);
+}
+
+// Iris disc (iris map, pupil, highlights) rendered once and pasted at a per-eye position.
+// Everything inside the disc is position independent, so both eyes can share one sprite and
+// converge/diverge at the cost of a span copy each.
+template <class Panel>
+struct IrisSprite {
+    static constexpr int kStride = Panel::kMaxIrisR * 2 + 1;
+    int r = 0;                          // integer radius; rows 0..2r are valid, centre at (r, r)
+    uint8_t half_w[kStride]{};          // per-row half span: columns r-half_w .. r+half_w are inside the disc
+    uint16_t px[kStride * kStride]{};   // RGB565, row stride kStride
+    // Anti-aliased rim: the outer rim_w pixels at each end of a row are blended over the sclera with
+    // coverage rim_alpha[rsq - rim_lo - 1] (0..32); rim_w is all 0 for an aliased sprite.
+    uint8_t rim_w[kStride]{};
+    int rim_lo = 0;
+    uint8_t rim_alpha[kStride]{};
+};
+
+// Eyelid occlusion: the columns of each row that the lids leave visible for one eye's eyelid state.
+// The span runs from the first to the last uncovered pixel (lid maps leave one gap per row), so
+// everything outside it is overwritten by apply_eyelids and need not be rendered. For a sub-pixel
+// placed eye the spans also take in the neighbours (one left, one up) the shift samples.
+template <class Panel>
+struct EyelidSpans {
+    int16_t x0[Panel::kHeight];   // first visible column
+    int16_t x1[Panel::kHeight];   // last visible column; x1 < x0 = row fully covered
+    uint8_t clear[Panel::kHeight];// 1 = no lid pixel anywhere on the row
+    int y0 = 0, y1 = -1;          // first/last row with a visible pixel; y1 < y0 = eye shut
+    bool shifted = false;         // widened for the sub-pixel shift (see widen_eyelid_spans)
+};
+
+// Where the display reads each row of a composed eye: the frame row, or for a row that is nothing
+// but the untouched sclera window (no iris, no lid; flat compose of a table sclera on an unscaled
+// panel only) the sclera asset row itself, which the display streams from flash without it passing
+// through RAM.
+template <class Panel>
+struct FrameRows {
+    const uint16_t *row[Panel::kHeight];
+    int flash_rows = 0;           // rows pointing into the sclera asset
+};
+
+// One eye that will show a shared sprite: its params (iris position) and visible spans
+template <class Panel>
+struct CulledEye {
+    const EyeRenderParams *params;
+    const EyelidSpans<Panel> *spans;
+};
+
+// All entry points take a frame of Panel::kPixels RGB565 pixels (row stride Panel::kWidth).
+
+// Renders sclera + iris + pupil (dilated) into frame (RGB565).
 // pupil_scale in params modifies pupil radius: final_pupil_r = base_pupil_fraction * iris_radius * clamp(pupil_scale,0.1..2.0)
+// (for a pupil_shape other than Circle, the size the shape is scaled to; see pupil_shape.hpp)
+template <class Panel>
 void render_eye(uint16_t *frame, const EyeRenderParams &params);
 
-// Performance path: render everything EXCEPT eyelids into frame (sclera, iris, pupil, highlights, optional tint)
+// Performance path: render everything EXCEPT eyelids into frame (sclera, iris, pupil, highlights)
 // Eyelids can then be applied differently per eye without re-doing base work.
+template <class Panel>
 void render_eye_base(uint16_t *frame, const EyeRenderParams &params);
 
+// Render the shared iris disc into the sprite buffer of params.style's cache slot (ignores
+// iris_center_x/y). The returned reference stays valid until the next call for the same style.
+template <class Panel>
+const IrisSprite<Panel>& render_iris_sprite(const EyeRenderParams &params);
+
+// As above, but sprite pixels that none of the eyes shows through its lids are left unrendered.
+template <class Panel>
+const IrisSprite<Panel>& render_iris_sprite(const EyeRenderParams &params, const CulledEye<Panel> *eyes, int count);
+
+// Visible span per row for params' eyelid state (eyelid_open, shape arrays, mirror_eyelids).
+template <class Panel>
+void compute_eyelid_spans(const EyeRenderParams &params, EyelidSpans<Panel> &out);
+
+// Widen spans kept from an earlier frame (same eyelid state) for params' sub-pixel shift, if it is
+// active now and they were computed without it. Compose and the sprite cull need the extra pixels.
+template <class Panel>
+void widen_eyelid_spans(const EyeRenderParams &params, EyelidSpans<Panel> &spans);
+
+// Build the style's cache slot (radius/angle/highlight LUTs for params.style and params' radii) in
+// steps, returning once now_us() has advanced budget_us past the call. Returns true when the style
+// is ready, after which render_iris_sprite for it does no table work. Call once per frame while
+// switching styles so the ~6k atan2 lattice never lands in a single frame.
+template <class Panel>
+bool prepare_eye_style(const EyeRenderParams &params, uint32_t budget_us, uint32_t (*now_us)());
+
+// Free the style's cache slot, for a style whose data is about to be replaced in place (a streamed
+// style's RAM arena being reloaded); the next prepare or render for it starts from scratch.
+template <class Panel>
+void forget_eye_style(const EyeStyle &style);
+
+// Copy the sclera window for params.iris_center_x/y and paste the sprite centred there.
+// Equivalent to render_eye_base when sprite was rendered from the same iris/pupil/highlight params.
+// With spans, only the visible pixels are written; apply_eyelids then gives the same result as an
+// unculled compose. With spans and rows, pure sclera rows are not copied at all: rows->row[y] points
+// at the asset instead, and only rows->row (not frame) holds the complete eye.
+template <class Panel>
+void compose_eye(uint16_t *frame, const IrisSprite<Panel> &sprite, const EyeRenderParams &params,
+                 const EyelidSpans<Panel> *spans = nullptr, FrameRows<Panel> *rows = nullptr);
+
 // Apply only eyelids (uses eyelid_open, shape arrays, colors, mirror_eyelids). Leaves other pixels intact.
+template <class Panel>
 void apply_eyelids(uint16_t *frame, const EyeRenderParams &params);
 
 } // namespace eyes
@@ -0,0 +1,41 @@
+#include "eye_style.hpp"
+
+#include <cstring>
+
+namespace eyes {
+
+namespace {
+    using StyleFn = const EyeStyle &(*)();
+    constexpr StyleFn kStyles[] = {
+        &styles::default_eye,
+#if PME_EXTRA_EYE_STYLES
+        &styles::cat,
+        &styles::dragon,
+        &styles::goat,
+        &styles::newt,
+        &styles::terminator,
+#endif
+    };
+    constexpr int kStyleCount = (int)(sizeof(kStyles) / sizeof(kStyles[0]));
+}
+
+int eye_style_count() { return kStyleCount; }
+
+const EyeStyle &eye_style(int index) {
+    if (index < 0) index = 0; else if (index >= kStyleCount) index = kStyleCount - 1;
+    return kStyles[index]();
+}
+
+const EyeStyle *find_eye_style(const char *name) {
+    for (StyleFn fn : kStyles)
+        if (std::strcmp(fn().name, name) == 0) return &fn();
+    return nullptr;
+}
+
+int eye_style_index(const EyeStyle &style) {
+    for (int i = 0; i < kStyleCount; ++i)
+        if (&kStyles[i]() == &style) return i;
+    return -1;
+}
+
+} // namespace eyes
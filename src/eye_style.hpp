@@ -0,0 +1,49 @@
+// Eye styles: one Uncanny Eyes asset set (sclera, iris map, eyelid maps) per style, selectable at
+// runtime. Styles only point at flash data; per-style derived LUTs live in the renderer's caches.
+// A style may synthesise its sclera (src/procedural_sclera.hpp) instead of pointing at a table, and
+// may hold its sclera and iris map as palette indices (src/indexed_assets.hpp).
+#pragma once
+#include <cstdint>
+#include "indexed_assets.hpp"
+#include "pupil_shape.hpp"
+
+namespace eyes {
+
+class ProceduralSclera;
+
+struct EyeStyle {
+    const char *name;
+    const uint16_t *sclera;   // RGB565, sclera_h rows of sclera_w; at least one reference screen
+                              // (nullptr: indexed->sclera, else sclera_gen synthesises it)
+    int sclera_w;
+    int sclera_h;
+    const uint16_t *iris_map; // RGB565, iris_map_h radius rows of iris_map_w angle columns
+                              // (nullptr: indexed->iris_map)
+    int iris_map_w;
+    int iris_map_h;
+    int iris_w;               // iris diameter on the 128x128 reference screen
+    const uint8_t *upper;     // eyelid threshold maps, reference screen size (see default_eye.hpp)
+    const uint8_t *lower;
+    const ProceduralSclera *sclera_gen = nullptr;
+    PupilShape pupil_shape = PupilShape::Circle;   // pupil the style is drawn with (App::apply_style)
+    const IndexedAssets *indexed = nullptr;        // palette-indexed sclera / iris map (PME_INDEXED_ASSETS)
+};
+
+namespace styles {
+const EyeStyle &default_eye();
+#if PME_EXTRA_EYE_STYLES
+const EyeStyle &cat();
+const EyeStyle &dragon();
+const EyeStyle &goat();
+const EyeStyle &newt();
+const EyeStyle &terminator();
+#endif
+} // namespace styles
+
+// Registry of the styles built into this image; index 0 is the default style.
+int eye_style_count();
+const EyeStyle &eye_style(int index);       // index is clamped into range
+const EyeStyle *find_eye_style(const char *name);
+int eye_style_index(const EyeStyle &style); // -1 if not registered
+
+} // namespace eyes
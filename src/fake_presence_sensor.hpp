@@ -0,0 +1,54 @@
+// Stand-in PresenceSensor with no hardware behind it: someone wandering through the field of view
+// on a slow Lissajous path, leaving for a few seconds now and then, sampled at the real sensor's rate
+// and delivered after a fixed acquisition delay. For host simulation (tools/presence_sim.cpp) and for
+// exercising target tracking on a board without a sensor (PME_FAKE_PRESENCE).
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "presence_sensor.hpp"
+
+namespace eyes {
+
+class FakePresenceSensor : public PresenceSensor {
+public:
+    explicit FakePresenceSensor(uint32_t period_us = 100000, uint32_t delay_us = 4000)
+        : period_us_(period_us), delay_us_(delay_us) {}
+
+    bool init() override { return true; }
+
+    void poll(uint32_t now_us) override {
+        if (!started_) { sample_us_ = now_us; started_ = true; }
+        if ((int32_t)(now_us - (sample_us_ + delay_us_)) < 0) return;
+        truth(sample_us_, latest_);
+        latest_.stamp_us = sample_us_ + delay_us_;
+        fresh_ = true;
+        sample_us_ += period_us_;
+    }
+
+    bool take(PresenceReading& out) override {
+        if (!fresh_) return false;
+        out = latest_;
+        fresh_ = false;
+        return true;
+    }
+
+    // Where the visitor actually is at t_us (what an ideal sensor would report)
+    static void truth(uint32_t t_us, PresenceReading& r) {
+        const float t = t_us * 1e-6f;
+        r.present = std::fmod(t, 20.f) < 14.f;          // gone for 6 s in every 20
+        r.x = 0.8f * std::sin(t * 0.7f);
+        r.y = 0.4f * std::sin(t * 0.45f + 1.f);
+        r.distance_mm = 900.f + 400.f * std::sin(t * 0.3f);
+    }
+
+private:
+    uint32_t period_us_;
+    uint32_t delay_us_;
+    bool started_ = false;
+    uint32_t sample_us_ = 0;
+    PresenceReading latest_{};
+    bool fresh_ = false;
+};
+
+} // namespace eyes
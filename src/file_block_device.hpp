@@ -0,0 +1,84 @@
+// Host stand-in BlockDevice reading blocks from a file (an asset pack written by
+// tools/asset_pack.py). Reads finish at once, or, with a Timing and a clock, when an SD card in SPI
+// mode would have delivered them: a new stream pays the command latency, every block its transfer
+// time, and a read that continues where the last one ended pays no command. For host tests and
+// benchmarks (tools/asset_stream_bench.cpp); needs stdio file access, so not for the firmware.
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "block_device.hpp"
+
+namespace eyes {
+
+class FileBlockDevice : public BlockDevice {
+public:
+    struct Timing {
+        uint32_t command_us = 0;    // CMD18 to the first start token
+        uint32_t block_us = 0;      // one block: token wait, 512 data bytes, CRC
+    };
+    using NowFn = uint64_t (*)(void *ctx);
+
+    explicit FileBlockDevice(const char *path) : path_(path) {}
+    ~FileBlockDevice() override { if (f_) std::fclose(f_); }
+
+    // Model transfer times against now(ctx) (microseconds)
+    void set_timing(const Timing &t, NowFn now, void *ctx) { timing_ = t; now_ = now; now_ctx_ = ctx; }
+
+    bool init() override {
+        if (!(f_ = std::fopen(path_, "rb"))) return false;
+        std::fseek(f_, 0, SEEK_END);
+        const long size = std::ftell(f_);
+        blocks_ = size > 0 ? (uint32_t)((size + kBlockSize - 1) / kBlockSize) : 0;
+        return true;
+    }
+    uint32_t block_count() const override { return blocks_; }
+
+    bool start_read(uint32_t lba, uint32_t count, uint8_t *dst) override {
+        if (!f_ || busy_ || count == 0 || lba >= blocks_ || count > blocks_ - lba) return false;
+        // The data is read now but only becomes visible (busy() false) at the modelled time
+        std::memset(dst, 0, count * kBlockSize);
+        ok_ = std::fseek(f_, (long)lba * kBlockSize, SEEK_SET) == 0 &&
+              std::fread(dst, 1, count * kBlockSize, f_) > 0;
+        if (!ok_) ++errors_;
+        ++reads_;
+        const bool continues = streaming_ && lba == next_lba_;
+        if (!continues) ++commands_;
+        if (now_) {
+            done_us_ = now_(now_ctx_) + (continues ? 0 : timing_.command_us) + count * timing_.block_us;
+            busy_ = true;
+        }
+        streaming_ = ok_;
+        next_lba_ = lba + count;
+        return true;
+    }
+    void poll() override {
+        if (busy_ && now_(now_ctx_) >= done_us_) busy_ = false;
+    }
+    bool busy() const override { return busy_; }
+    bool ok() const override { return ok_; }
+    uint32_t errors() const override { return errors_; }
+    // Time the read in progress completes (modelled timing)
+    uint64_t done_us() const { return done_us_; }
+    uint32_t reads() const { return reads_; }
+    uint32_t commands() const { return commands_; }   // reads that started a new stream
+
+private:
+    const char *path_;
+    std::FILE *f_ = nullptr;
+    uint32_t blocks_ = 0;
+    Timing timing_{};
+    NowFn now_ = nullptr;
+    void *now_ctx_ = nullptr;
+    bool busy_ = false;
+    bool ok_ = false;
+    bool streaming_ = false;
+    uint32_t next_lba_ = 0;
+    uint64_t done_us_ = 0;
+    uint32_t errors_ = 0;
+    uint32_t reads_ = 0;
+    uint32_t commands_ = 0;
+};
+
+} // namespace eyes
@@ -0,0 +1,41 @@
+#include "gaze_tracker.hpp"
+
+namespace eyes {
+
+void GazeTracker::add(const PresenceReading& r) {
+    // Absent readings count only through lost_after_us, so one missed frame does not drop the target
+    if (!r.present) return;
+    meas_x_ = cx_ + (cfg_.mirror_x ? -r.x : r.x) * cfg_.range_x_px;
+    meas_y_ = cy_ + (cfg_.flip_y ? -r.y : r.y) * cfg_.range_y_px;
+    meas_dist_ = r.distance_mm;
+    if (!seen_) {
+        // New arrival: start from the first fix rather than sliding in from wherever the eye was
+        sm_x_ = meas_x_; sm_y_ = meas_y_; dist_ = meas_dist_;
+        seen_ = true;
+    }
+    last_seen_us_ = r.stamp_us;
+    stamp_us_ = r.stamp_us;
+}
+
+GazeTracker::Action GazeTracker::step(float dt, uint32_t now_us) {
+    if (!seen_) return Action::None;
+    if (now_us - last_seen_us_ > cfg_.lost_after_us) {
+        seen_ = false;
+        if (!tracking_) return Action::None;
+        tracking_ = false;
+        return Action::Release;
+    }
+    // First-order low-pass; dt / (tau + dt) is the stable discrete form, no exp() per frame
+    const float k = dt / (cfg_.time_constant_s + dt);
+    sm_x_ += (meas_x_ - sm_x_) * k;
+    sm_y_ += (meas_y_ - sm_y_) * k;
+    dist_ += (meas_dist_ - dist_) * k;
+    const float dx = sm_x_ - out_x_, dy = sm_y_ - out_y_;
+    if (tracking_ && dx * dx + dy * dy < cfg_.deadband_px * cfg_.deadband_px) return Action::None;
+    out_x_ = sm_x_;
+    out_y_ = sm_y_;
+    tracking_ = true;
+    return Action::Look;
+}
+
+} // namespace eyes
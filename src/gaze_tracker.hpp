@@ -0,0 +1,52 @@
+// Presence readings -> a smoothed look-at target in panel pixels. No hardware dependencies (host
+// simulation: tools/presence_sim.cpp).
+#pragma once
+
+#include <cstdint>
+#include "presence_sensor.hpp"
+
+namespace eyes {
+
+struct GazeTrackerConfig {
+    float range_x_px = 40.f;            // iris travel from the centre for a target at the edge of the field of view
+    float range_y_px = 32.f;
+    bool mirror_x = true;               // the sensor faces the viewer: its left is the prop's right
+    bool flip_y = false;                // sensor mounted upside down
+    float time_constant_s = 0.2f;       // smoothing of the target position and distance
+    float deadband_px = 2.5f;           // re-aim (a new saccade) only once the target has moved this far
+    uint32_t lost_after_us = 1500000;   // release the gaze after this long without presence
+};
+
+class GazeTracker {
+public:
+    enum class Action { None, Look, Release };
+
+    GazeTracker(float frame_w, float frame_h, const GazeTrackerConfig& cfg = {})
+        : cfg_(cfg), cx_(frame_w * 0.5f), cy_(frame_h * 0.5f) {}
+
+    // Feed each new reading
+    void add(const PresenceReading& r);
+    // Advance smoothing by dt. Look: aim at x(), y() from distance_mm() (changed past the deadband);
+    // Release: nobody seen for lost_after_us.
+    Action step(float dt, uint32_t now_us);
+
+    bool tracking() const { return tracking_; }
+    float x() const { return out_x_; }
+    float y() const { return out_y_; }
+    float distance_mm() const { return dist_; }
+    // Sample time of the newest reading folded into the current target (for sensor-to-gaze latency)
+    uint32_t reading_stamp_us() const { return stamp_us_; }
+
+private:
+    GazeTrackerConfig cfg_;
+    float cx_, cy_;
+    bool seen_ = false;                 // a present reading is being followed
+    uint32_t last_seen_us_ = 0;
+    uint32_t stamp_us_ = 0;
+    float meas_x_ = 0.f, meas_y_ = 0.f, meas_dist_ = 0.f;
+    float sm_x_ = 0.f, sm_y_ = 0.f, dist_ = 0.f;
+    bool tracking_ = false;             // a Look is in effect
+    float out_x_ = 0.f, out_y_ = 0.f;
+};
+
+} // namespace eyes
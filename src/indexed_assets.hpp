@@ -0,0 +1,44 @@
+// Palette-indexed eye textures: a style's sclera and iris map as 8-bit indices into 256-entry RGB565
+// palettes (tools/palettize.py), half the flash and XIP traffic of the RGB565 tables. The renderer
+// looks every texel up through the palette, so recolouring a texture is a rewrite of its palette
+// (256 entries) rather than of its pixels: palette animation for glowing or recoloured eyes. No
+// hardware dependencies; tools/palette_bench.cpp compares quality and speed with the RGB565 path.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include "pixel_kernels.hpp"
+
+namespace eyes {
+
+constexpr int kPaletteSize = 256;
+
+// Indexed textures of one style (EyeStyle::indexed). Each index map has the size of the RGB565 map
+// it replaces (sclera_w x sclera_h, iris_map_w x iris_map_h).
+struct IndexedAssets {
+    const uint8_t *sclera;          // nullptr: the style's sclera table or sclera_gen
+    const uint16_t *sclera_palette;
+    const uint8_t *iris_map;
+    const uint16_t *iris_palette;
+};
+
+// Palette animation, O(kPaletteSize) per frame whatever the texture size. out may alias base.
+
+// Every entry blended toward color by alpha (0..32)
+inline void tint_palette(uint16_t *out, const uint16_t *base, uint16_t color, uint32_t alpha) {
+    for (int i = 0; i < kPaletteSize; ++i) out[i] = px::blend565(base[i], color, alpha);
+}
+
+// Every entry brightened by color * alpha / 32 (alpha 0..32), saturating per channel: bright texels
+// wash out toward white first, which reads as the eye glowing rather than being painted over
+inline void glow_palette(uint16_t *out, const uint16_t *base, uint16_t color, uint32_t alpha) {
+    const uint32_t gr = ((color >> 11) * alpha) >> 5, gg = (((color >> 5) & 63u) * alpha) >> 5, gb = ((color & 31u) * alpha) >> 5;
+    for (int i = 0; i < kPaletteSize; ++i) {
+        const uint32_t c = base[i];
+        const uint32_t r = std::min<uint32_t>((c >> 11) + gr, 31u);
+        const uint32_t g = std::min<uint32_t>(((c >> 5) & 63u) + gg, 63u);
+        const uint32_t b = std::min<uint32_t>((c & 31u) + gb, 31u);
+        out[i] = (uint16_t)(r << 11 | g << 5 | b);
+    }
+}
+
+} // namespace eyes
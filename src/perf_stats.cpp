@@ -0,0 +1,44 @@
+#include "perf_stats.hpp"
+
+#if PME_PERF_STATS
+
+#include <cstdio>
+#include "pico/stdlib.h"
+
+namespace eyes::perf {
+
+namespace {
+    constexpr uint32_t kReportFrames = 250; // ~5 s at 50 fps
+    constexpr int kCount = static_cast<int>(Section::COUNT);
+    const char* const kSectionNames[kCount] = { "iris", "compose", "sphere", "eyelids", "blit", "style", "frame" };
+    uint64_t g_total_us[kCount]{};
+    uint32_t g_max_us[kCount]{};
+    uint32_t g_samples[kCount]{};
+    uint32_t g_frames = 0;
+}
+
+uint32_t now_us() { return time_us_32(); }
+
+void add(Section s, uint32_t us) {
+    int i = static_cast<int>(s);
+    g_total_us[i] += us;
+    if (us > g_max_us[i]) g_max_us[i] = us;
+    ++g_samples[i];
+}
+
+void end_frame() {
+    if (++g_frames < kReportFrames) return;
+    printf("perf (%lu frames):", (unsigned long)g_frames);
+    for (int i = 0; i < kCount; ++i) {
+        if (!g_samples[i]) continue;
+        printf(" %s avg %lu max %lu us;", kSectionNames[i],
+               (unsigned long)(g_total_us[i] / g_samples[i]), (unsigned long)g_max_us[i]);
+        g_total_us[i] = 0; g_max_us[i] = 0; g_samples[i] = 0;
+    }
+    printf("\n");
+    g_frames = 0;
+}
+
+} // namespace eyes::perf
+
+#endif // PME_PERF_STATS
@@ -0,0 +1,39 @@
+// Lightweight per-section frame timing (enable with -DPME_PERF_STATS=1, see CMakeLists.txt)
+#pragma once
+
+#include <cstdint>
+
+#ifndef PME_PERF_STATS
+#define PME_PERF_STATS 0
+#endif
+
+namespace eyes::perf {
+
+// Timed sections of the frame. Keep names in sync with kSectionNames in perf_stats.cpp.
+enum class Section : uint8_t { IrisSprite, Compose, ComposeSphere, Eyelids, Blit, StyleBuild, Frame, COUNT };
+
+#if PME_PERF_STATS
+uint32_t now_us();
+void add(Section s, uint32_t us);
+// Call once per frame; prints average/max per section every kReportFrames frames and resets.
+void end_frame();
+
+// RAII timer for one section
+class Scope {
+public:
+    explicit Scope(Section s) : s_(s), t0_(now_us()) {}
+    ~Scope() { add(s_, now_us() - t0_); }
+private:
+    Section s_;
+    uint32_t t0_;
+};
+#else
+inline void add(Section, uint32_t) {}
+inline void end_frame() {}
+class Scope {
+public:
+    explicit Scope(Section) {}
+};
+#endif
+
+} // namespace eyes::perf
@@ -0,0 +1,113 @@
+// Pixel kernels for the render/transmit hot loops, two RGB565 pixels (or four 8-bit thresholds) per
+// 32-bit word. On ARMv8-M with the DSP extension (RP2350's Cortex-M33) the packed SIMD instructions
+// are used (REV16, UQADD8/UQSUB8); elsewhere, or with -DPME_PORTABLE_KERNELS, plain C++ fallbacks with
+// identical results are compiled instead. Selection is compile time only (PME_DSP_KERNELS);
+// tools/kernel_test.cpp checks both against per-pixel reference code.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__ARM_FEATURE_SIMD32) && !defined(PME_PORTABLE_KERNELS)
+#include <arm_acle.h>
+#define PME_DSP_KERNELS 1
+#else
+#define PME_DSP_KERNELS 0
+#endif
+
+namespace eyes::px {
+
+// Unaligned-safe word access (a single LDR/STR on the M33)
+inline uint32_t load32(const void *p) { uint32_t w; std::memcpy(&w, p, 4); return w; }
+inline void store32(void *p, uint32_t w) { std::memcpy(p, &w, 4); }
+
+inline uint16_t swap16(uint16_t v) { return (uint16_t)((v >> 8) | (v << 8)); }
+
+// Byte-swap each halfword of a word (two RGB565 pixels)
+inline uint32_t swap16x2(uint32_t w) {
+#if PME_DSP_KERNELS
+    return __rev16(w);
+#else
+    return ((w & 0x00FF00FFu) << 8) | ((w >> 8) & 0x00FF00FFu);
+#endif
+}
+
+// Reverse the byte order of a word (four thresholds read right-to-left for mirrored rows)
+inline uint32_t reverse4(uint32_t w) {
+#if PME_DSP_KERNELS
+    return __rev(w);
+#else
+    return (w >> 24) | ((w >> 8) & 0x0000FF00u) | ((w << 8) & 0x00FF0000u) | (w << 24);
+#endif
+}
+
+// dst[i] = byte-swapped src[i] (big-endian SPI order); dst may alias src
+inline void swap_bytes(uint16_t *dst, const uint16_t *src, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) store32(dst + i, swap16x2(load32(src + i)));
+    if (i < n) dst[i] = swap16(src[i]);
+}
+
+inline void copy(uint16_t *dst, const uint16_t *src, size_t n) { std::memcpy(dst, src, n * sizeof(uint16_t)); }
+
+// dst[i] = palette[src[i]]: a row of 8-bit indexed texels to RGB565, four indices per load and two
+// pixels per store (the byte order of the indices within a word is little-endian, as on the M33)
+inline void expand_indexed(uint16_t *dst, const uint8_t *src, const uint16_t *palette, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const uint32_t w = load32(src + i);
+        store32(dst + i, palette[w & 0xFFu] | (uint32_t)palette[(w >> 8) & 0xFFu] << 16);
+        store32(dst + i + 2, palette[(w >> 16) & 0xFFu] | (uint32_t)palette[w >> 24] << 16);
+    }
+    for (; i < n; ++i) dst[i] = palette[src[i]];
+}
+
+inline void fill(uint16_t *dst, uint16_t color, size_t n) {
+    const uint32_t w = color * 0x00010001u;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) store32(dst + i, w);
+    if (i < n) dst[i] = color;
+}
+
+// Per byte of `bytes`: 0xFF where byte <= cutoff (0..255), else 0x00.
+// DSP: (255 - byte) +sat cutoff reaches 0xFF exactly when byte <= cutoff; -sat 0xFE leaves 1/0.
+inline uint32_t le_mask4(uint32_t bytes, uint32_t cutoff) {
+#if PME_DSP_KERNELS
+    uint32_t hit = __uqsub8(__uqadd8(~bytes, cutoff * 0x01010101u), 0xFEFEFEFEu);
+    return hit * 0xFFu;
+#else
+    // Even and odd bytes in 16-bit lanes: 0x100 + cutoff - byte keeps bit 8 exactly when byte <= cutoff
+    const uint32_t c = cutoff * 0x00010001u + 0x01000100u;
+    const uint32_t even = (c - (bytes & 0x00FF00FFu)) & 0x01000100u;
+    const uint32_t odd = (c - ((bytes >> 8) & 0x00FF00FFu)) & 0x01000100u;
+    return ((even >> 8) | odd) * 0xFFu;
+#endif
+}
+
+// a + (b - a) * alpha / 32 per channel (alpha 0..32). The pixel is spread to 0x07E0F81F layout so all
+// three channels share one multiply; used for both targets, so results never depend on the build.
+inline uint16_t blend565(uint16_t a, uint16_t b, uint32_t alpha) {
+    uint32_t ea = (a | ((uint32_t)a << 16)) & 0x07E0F81Fu;
+    uint32_t eb = (b | ((uint32_t)b << 16)) & 0x07E0F81Fu;
+    uint32_t e = (ea + (((eb - ea) * alpha) >> 5)) & 0x07E0F81Fu;
+    return (uint16_t)(e | (e >> 16));
+}
+
+// Per-channel mean (rounded down) of the two RGB565 pixels in each halfword of a and b: clearing
+// each channel's low bit before the shift keeps channels (and the two pixels) from bleeding.
+inline uint32_t avg565x2(uint32_t a, uint32_t b) { return (a & b) + (((a ^ b) & 0xF7DEF7DEu) >> 1); }
+
+// a + (b - a) * phase / 4 per channel for both pixels of a word (phase 1..3), as an averaging ladder:
+// 1/4 = avg(a, avg(a, b)), 3/4 = avg(b, avg(a, b)). Sub-pixel placement, two pixels per step.
+inline uint32_t quarter_lerp565x2(uint32_t a, uint32_t b, unsigned phase) {
+    uint32_t m = avg565x2(a, b);
+    return phase == 2 ? m : avg565x2(phase == 1 ? a : b, m);
+}
+
+// dst[i] = blend565(dst[i], src[i], alpha): cross-fade two whole frames
+inline void blend(uint16_t *dst, const uint16_t *src, uint32_t alpha, size_t n) {
+    for (size_t i = 0; i < n; ++i) dst[i] = blend565(dst[i], src[i], alpha);
+}
+
+} // namespace eyes::px
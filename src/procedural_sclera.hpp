@@ -0,0 +1,157 @@
+// Procedural sclera: synthesises the sclera texture from a few colours instead of reading a
+// 200x200 RGB565 table from flash. Radial shading (centre colour toward the rim colour) comes from a
+// small rsq-indexed table, veins from a 64x64 tile of vein levels that wraps seamlessly. Both index
+// a colour table holding two pixels per word, so a pixel pair is two loads and a store. All tables
+// are built at compile time from a ScleraRecipe (about 12 KB of flash in place of 80 KB). No hardware
+// dependencies; see tools/sclera_bench.cpp for a comparison with a table sclera.
+#pragma once
+#include <cstdint>
+#include "pixel_kernels.hpp"
+
+namespace eyes {
+
+struct ScleraRecipe {
+    uint16_t centre;        // RGB565 at the middle of the texture
+    uint16_t rim;           // RGB565 at the texture corners
+    uint16_t vein;          // RGB565 of a vein at full strength
+    uint8_t vein_centre;    // vein blend (0..32) at the middle: veins fade out toward the iris
+    uint8_t vein_rim;       // vein blend (0..32) at the corners
+    uint8_t veins;          // vein walks drawn into the tile (branches come on top)
+    uint32_t seed;
+};
+
+class ProceduralSclera {
+public:
+    static constexpr int kTileBits = 6;
+    static constexpr int kTile = 1 << kTileBits;
+    static constexpr int kLevels = 32;       // radial shading steps
+    static constexpr int kVeinLevels = 8;    // 0 = no vein
+    static constexpr int kShadeSize = 256;
+
+    // Texture size (a sclera_w x sclera_h window, like a table sclera's)
+    constexpr ProceduralSclera(const ScleraRecipe &r, int w, int h) : w_(w), h_(h) {
+        const int cx = w / 2, cy = h / 2;
+        const int max_rsq = cx * cx + cy * cy;
+        while ((max_rsq >> shift_) >= kShadeSize) ++shift_;
+        // Level linear in the distance from the centre, as a table sclera's shading falls off; each
+        // entry is taken at the middle of its rsq step
+        const int max_d = isqrt(max_rsq);
+        for (int i = 0; i < kShadeSize; ++i) {
+            const int d = isqrt((i << shift_) + (1 << shift_) / 2);
+            shade_[i] = (uint8_t)((kLevels - 1) * (d < max_d ? d : max_d) / max_d);
+        }
+        for (int l = 0; l < kLevels; ++l) {
+            const uint16_t base = mix(r.centre, r.rim, l * 32 / (kLevels - 1));
+            const int strength = r.vein_centre + (r.vein_rim - r.vein_centre) * l / (kLevels - 1);
+            uint16_t c[kVeinLevels]{};
+            for (int v = 0; v < kVeinLevels; ++v) c[v] = mix(base, r.vein, strength * v / (kVeinLevels - 1));
+            for (int v0 = 0; v0 < kVeinLevels; ++v0)
+                for (int v1 = 0; v1 < kVeinLevels; ++v1)
+                    pairs_[l * kPairs + v0 * kVeinLevels + v1] = c[v0] | (uint32_t)c[v1] << 16;
+        }
+        uint8_t veins[kTile * kTile]{};
+        draw_veins(r, veins);
+        // Each tile pixel holds the pair index of itself and its right-hand neighbour (wrapping)
+        for (int y = 0; y < kTile; ++y)
+            for (int x = 0; x < kTile; ++x)
+                tile_[y * kTile + x] = (uint8_t)(veins[y * kTile + x] * kVeinLevels + veins[y * kTile + ((x + 1) & (kTile - 1))]);
+    }
+
+    int width() const { return w_; }
+    int height() const { return h_; }
+
+    uint16_t pixel(int tx, int ty) const {
+        const int dy = ty - h_ / 2;
+        return (uint16_t)group_pairs(tx, dy * dy)[tile_[((ty & (kTile - 1)) << kTileBits) | (tx & (kTile - 1))]];
+    }
+
+    // n texture pixels of row ty from column tx0, the same values as pixel(). The shading level is
+    // looked up once per group, then pixels go out in pairs.
+    void row(uint16_t *dst, int tx0, int ty, int n) const {
+        const int dy = ty - h_ / 2, dy2 = dy * dy;
+        const uint8_t *tile = tile_ + ((ty & (kTile - 1)) << kTileBits);
+        const int end = tx0 + n;
+        for (int tx = tx0; tx < end;) {
+            const uint32_t *pairs = group_pairs(tx, dy2);
+            int group_end = (tx | (kGroup - 1)) + 1;
+            if (group_end > end) group_end = end;
+            for (; tx + 1 < group_end; tx += 2, dst += 2) px::store32(dst, pairs[tile[tx & (kTile - 1)]]);
+            if (tx < group_end) { *dst++ = (uint16_t)pairs[tile[tx & (kTile - 1)]]; ++tx; }
+        }
+    }
+
+private:
+    // Radial shading is constant over kGroup-column groups (aligned in the texture), taken at the
+    // group's middle: one level step at most, even near the corners where it changes fastest
+    static constexpr int kGroup = 8;
+    static constexpr int kPairs = kVeinLevels * kVeinLevels;
+    const uint32_t *group_pairs(int tx, int dy2) const {
+        const int gx = (tx & ~(kGroup - 1)) + kGroup / 2 - w_ / 2;
+        return pairs_ + shade_[(gx * gx + dy2) >> shift_] * kPairs;
+    }
+
+    static constexpr int isqrt(int v) {
+        int r = 0;
+        while ((r + 1) * (r + 1) <= v) ++r;
+        return r;
+    }
+
+    // a + (b - a) * alpha / 32 per channel
+    static constexpr uint16_t mix(uint16_t a, uint16_t b, int alpha) {
+        auto ch = [&](int shift, int mask) {
+            int ca = (a >> shift) & mask, cb = (b >> shift) & mask;
+            return (uint16_t)(((ca + (cb - ca) * alpha / 32) & mask) << shift);
+        };
+        return (uint16_t)(ch(11, 31) | ch(5, 63) | ch(0, 31));
+    }
+
+    // Random walks on the wrapping tile that bend a little each step, thin out (level drops) as
+    // they go, and now and then fork a shorter branch
+    static constexpr void draw_veins(const ScleraRecipe &r, uint8_t *tile) {
+        uint32_t s = r.seed ? r.seed : 1u;
+        auto rnd = [&s](int n) {
+            s = s * 1664525u + 1013904223u;
+            return (int)((s >> 8) % (uint32_t)n);
+        };
+        struct Walk { int x, y, dx, dy, steps, level; };
+        Walk stack[16]{};
+        int depth = 0;
+        for (int v = 0; v < r.veins; ++v) {
+            // Direction vector in 1/256 px, unit length, from one of 16 headings
+            constexpr int kDirs[16][2] = {{256, 0}, {237, 98}, {181, 181}, {98, 237}, {0, 256}, {-98, 237},
+                                          {-181, 181}, {-237, 98}, {-256, 0}, {-237, -98}, {-181, -181},
+                                          {-98, -237}, {0, -256}, {98, -237}, {181, -181}, {237, -98}};
+            const int d = rnd(16);
+            stack[depth++] = Walk{rnd(kTile) << 8, rnd(kTile) << 8, kDirs[d][0], kDirs[d][1],
+                                  40 + rnd(50), kVeinLevels - 1};
+            while (depth) {
+                Walk w = stack[--depth];
+                for (int i = 0; i < w.steps; ++i) {
+                    const int vx = (w.x >> 8) & (kTile - 1), vy = (w.y >> 8) & (kTile - 1);
+                    const int lv = w.level - i * (w.level - 1) / w.steps;
+                    uint8_t &t = tile[(vy << kTileBits) | vx];
+                    if (t < lv) t = (uint8_t)lv;
+                    // Turn by 0 or +-0.1 rad: cos/sin as 255/256 and 26/256
+                    const int turn = rnd(3) - 1;
+                    if (turn) {
+                        const int ndx = (w.dx * 255 - turn * w.dy * 26) / 256;
+                        const int ndy = (w.dy * 255 + turn * w.dx * 26) / 256;
+                        w.dx = ndx; w.dy = ndy;
+                    }
+                    w.x += w.dx; w.y += w.dy;
+                    if (lv > 2 && depth < 16 && rnd(24) == 0)
+                        stack[depth++] = rnd(2) ? Walk{w.x, w.y, w.dy, -w.dx, w.steps / 3 + rnd(10), lv - 1}
+                                                : Walk{w.x, w.y, -w.dy, w.dx, w.steps / 3 + rnd(10), lv - 1};
+                }
+            }
+        }
+    }
+
+    int w_, h_;
+    int shift_ = 0;
+    uint8_t shade_[kShadeSize]{};             // (rsq >> shift_) -> radial level
+    uint32_t pairs_[kLevels * kPairs]{};      // [level][vein level, right neighbour's] -> two RGB565
+    uint8_t tile_[kTile * kTile]{};           // pair index per tile pixel
+};
+
+} // namespace eyes
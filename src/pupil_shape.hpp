@@ -0,0 +1,134 @@
+// Pupil shapes as per-row span tables. Each shape is one span per row, mirror-symmetric about both
+// axes, so a row's pupil is [-w, w] around the iris centre; w comes from a table of the half-width
+// against the row's distance from the centre, normalised to the shape's half-height. Shapes change
+// with dilation (a cat's slit opens toward round), so there is one table per dilation level and a
+// pupil between levels interpolates the two around it. All tables are built at compile time (about
+// 4.5 KB of flash). No hardware dependencies; tools/pupil_bench.cpp times the shapes on the host.
+#pragma once
+#include <cstdint>
+
+namespace eyes {
+
+enum class PupilShape : uint8_t {
+    Circle,     // the renderer keeps its exact per-radius test for it (tables unused)
+    Ellipse,    // upright, widening as it dilates
+    Slit,       // lens between two arcs: a thin slit constricted, near round dilated
+    Star,       // four concave points, rounder as it dilates
+    COUNT
+};
+
+class PupilShapeTables {
+public:
+    static constexpr int kLevels = 9;       // dilation 0, 1/8 .. 1
+    static constexpr int kRows = 64;        // |dy| / half-height in 1/64 steps
+    static constexpr int kOne = 4096;       // table units (Q12): kOne = the half-height
+
+    constexpr PupilShapeTables() {
+        for (int s = 0; s < (int)PupilShape::COUNT; ++s) {
+            for (int l = 0; l < kLevels; ++l) {
+                const double d = (double)l / (kLevels - 1);
+                height_[s][l] = (uint16_t)(half_height((PupilShape)s, d) * kOne + 0.5);
+                for (int r = 0; r <= kRows; ++r) {
+                    double w = half_width((PupilShape)s, d, (double)r / kRows);
+                    w = w < 0. ? 0. : (w > 1. ? 1. : w);
+                    width_[s][l][r] = (uint16_t)(w * kOne + 0.5);
+                }
+            }
+        }
+    }
+
+    // Dilation 0..1 from the animator's pupil scale (0.6 constricted .. 1.4 dilated)
+    static constexpr float dilation(float pupil_scale) {
+        const float d = (pupil_scale - 0.6f) * 1.25f;
+        return d < 0.f ? 0.f : (d > 1.f ? 1.f : d);
+    }
+
+    // One shape at one pupil size, resolved once per sprite; then a lookup per row
+    class Spans {
+    public:
+        // Half-height in px: rows beyond it have no pupil
+        float half_height() const { return hh_; }
+        // Half-width in px of the pupil on the row dy from the centre (0 = none)
+        float half_width(int dy) const {
+            const float v = (dy < 0 ? -dy : dy) * row_scale_;
+            if (v >= (float)kRows) return 0.f;
+            const int r = (int)v;
+            const float f = v - (float)r;
+            const float w0 = a_[r] + (b_[r] - a_[r]) * lf_, w1 = a_[r + 1] + (b_[r + 1] - a_[r + 1]) * lf_;
+            return (w0 + (w1 - w0) * f) * px_per_unit_;
+        }
+
+    private:
+        friend class PupilShapeTables;
+        const uint16_t *a_ = nullptr, *b_ = nullptr;   // tables of the levels below and above
+        float lf_ = 0.f;                                // weight of b_
+        float hh_ = 0.f;
+        float row_scale_ = 0.f;                         // table rows per px
+        float px_per_unit_ = 0.f;
+    };
+
+    // pupil_r: the circle's radius at this size (base_pupil_fraction * iris radius * scale)
+    Spans spans(PupilShape shape, float pupil_r, float dilation) const {
+        Spans sp;
+        const int s = (int)shape;
+        const float x = dilation * (kLevels - 1);
+        int l = (int)x;
+        if (l > kLevels - 2) l = kLevels - 2;
+        sp.a_ = width_[s][l];
+        sp.b_ = width_[s][l + 1];
+        sp.lf_ = x - (float)l;
+        const float h = height_[s][l] + (height_[s][l + 1] - height_[s][l]) * sp.lf_;
+        sp.hh_ = pupil_r * h * (1.f / kOne);
+        sp.row_scale_ = sp.hh_ > 0.f ? kRows / sp.hh_ : 0.f;
+        sp.px_per_unit_ = sp.hh_ * (1.f / kOne);
+        if (sp.hh_ <= 0.f) sp.row_scale_ = (float)kRows;    // every row beyond the table: no pupil
+        return sp;
+    }
+
+private:
+    static constexpr double sqrt_(double x) {
+        if (x <= 0.) return 0.;
+        double r = x > 1. ? x : 1.;
+        for (int i = 0; i < 40; ++i) r = 0.5 * (r + x / r);
+        return r;
+    }
+
+    // Half-height, in pupil radii, at dilation d
+    static constexpr double half_height(PupilShape s, double d) {
+        switch (s) {
+            case PupilShape::Ellipse: return 1.2;
+            case PupilShape::Slit: return 4.2 - 2.2 * d;    // about 0.8 of the iris radius throughout
+            case PupilShape::Star: return 1.3;
+            default: return 1.;
+        }
+    }
+
+    // Half-width, in half-heights, at v = |dy| / half-height (0..1)
+    static constexpr double half_width(PupilShape s, double d, double v) {
+        const double round = sqrt_(1. - v * v);
+        switch (s) {
+            case PupilShape::Ellipse: return (0.55 + 0.25 * d) * round;
+            case PupilShape::Slit: {
+                // Two arcs through the tips (0, +-1) and the widest point (w0, 0)
+                const double w0 = 0.06 + 0.5 * d;
+                const double rho = (1. + w0 * w0) / (2. * w0);
+                return sqrt_(rho * rho - v * v) - (rho - w0);
+            }
+            case PupilShape::Star: {
+                // Astroid-like |x|^1/2 + |y|^1/2 <= 1 blended toward the circle
+                const double k = 0.25 + 0.45 * d;
+                const double sv = 1. - sqrt_(v);
+                return (1. - k) * sv * sv + k * round;
+            }
+            default: return round;
+        }
+    }
+
+    uint16_t height_[(int)PupilShape::COUNT][kLevels]{};
+    uint16_t width_[(int)PupilShape::COUNT][kLevels][kRows + 1]{};
+};
+
+// The tables, in flash
+inline constexpr PupilShapeTables kPupilShapes{};
+
+} // namespace eyes
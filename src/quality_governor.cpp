@@ -0,0 +1,58 @@
+#include "quality_governor.hpp"
+
+namespace eyes {
+
+const char* quality_tier_name(QualityTier tier) {
+    switch (tier) {
+        case QualityTier::Full: return "full";
+        case QualityTier::ReducedRegion: return "reduced region";
+        case QualityTier::CachedIris: return "cached iris";
+        case QualityTier::NoSecondaryHighlight: return "no secondary highlight";
+        case QualityTier::HalfRateLids: return "half-rate lids";
+        default: return "?";
+    }
+}
+
+bool QualityGovernor::update(uint32_t frame_us) {
+    ++stats_.frames;
+    ++stats_.frames_at[(int)tier_];
+    if (frame_us > cfg_.period_us) ++stats_.overruns;
+    if (frame_us > stats_.worst_us) stats_.worst_us = frame_us;
+    // EWMA, 1/8 per frame; the first frame seeds it
+    avg_us_ = stats_.frames == 1 ? frame_us : avg_us_ - (avg_us_ >> 3) + (frame_us >> 3);
+    if (since_restore_ != UINT32_MAX) ++since_restore_;
+    // The average needs a few frames to show what the last change did
+    if (settle_ > 0) { --settle_; return false; }
+
+    over_ = avg_us_ > cfg_.budget_us ? over_ + 1 : 0;
+    under_ = avg_us_ < cfg_.restore_us ? under_ + 1 : 0;
+    if (over_ >= cfg_.degrade_frames && tier_ < cfg_.floor) {
+        // Given back too early: wait twice as long before the next try
+        if (since_restore_ < hold_) {
+            hold_ *= 2;
+            if (hold_ > cfg_.max_restore_frames) hold_ = cfg_.max_restore_frames;
+        }
+        tier_ = (QualityTier)((int)tier_ + 1);
+        ++stats_.degrades;
+        over_ = under_ = 0;
+        settle_ = kSettleFrames;
+        since_restore_ = UINT32_MAX;
+        return true;
+    }
+    if (under_ >= hold_ && tier_ > QualityTier::Full) {
+        tier_ = (QualityTier)((int)tier_ - 1);
+        ++stats_.restores;
+        over_ = under_ = 0;
+        settle_ = kSettleFrames;
+        since_restore_ = 0;
+        return true;
+    }
+    // Stayed restored for a whole hold: the backoff is forgotten
+    if (since_restore_ >= hold_ && since_restore_ != UINT32_MAX) {
+        hold_ = cfg_.restore_frames;
+        since_restore_ = UINT32_MAX;
+    }
+    return false;
+}
+
+} // namespace eyes
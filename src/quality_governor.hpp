@@ -0,0 +1,72 @@
+// Frame-budget governor: measured frame times -> a rendering quality tier, so the animation keeps its
+// rate when features stack up (style fades, tint, both highlights, blinks on both panels) instead of
+// stuttering. No hardware dependencies (host simulation: tools/governor_sim.cpp).
+#pragma once
+
+#include <cstdint>
+
+namespace eyes {
+
+// Cheapest visual loss first; each tier keeps every saving of the ones before it
+enum class QualityTier : uint8_t {
+    Full,
+    ReducedRegion,      // blit only the rows the lids leave visible (this frame or the last)
+    CachedIris,         // re-render the iris sprite only when the pupil has moved a quarter pixel
+    NoSecondaryHighlight,
+    HalfRateLids,       // eyelids and their shapes follow the animation every other frame
+    COUNT
+};
+const char* quality_tier_name(QualityTier tier);
+
+struct QualityGovernorConfig {
+    uint32_t period_us = 20000;         // a frame longer than this is an overrun (a late frame)
+    uint32_t budget_us = 17000;         // step down while the average is above this
+    uint32_t restore_us = 13000;        // step back up while it is below this
+    uint16_t degrade_frames = 4;        // consecutive frames over budget before stepping down
+    uint16_t restore_frames = 100;      // consecutive frames under restore_us before stepping up
+    uint16_t max_restore_frames = 1600; // cap of the backoff below
+    QualityTier floor = QualityTier::HalfRateLids;  // lowest tier it may step down to
+};
+
+// One update() per frame with the time the frame took. The average is an EWMA over ~8 frames. Two
+// thresholds and hold times give the hysteresis: a one-off long frame changes nothing, each change
+// is given 8 frames to show in the average before the next, a tier is only given back once the
+// average has stayed well under budget, and a tier that has to be dropped again soon after it was
+// restored doubles the hold before the next attempt (up to max_restore_frames).
+class QualityGovernor {
+public:
+    struct Stats {
+        uint32_t frames = 0;
+        uint32_t overruns = 0;              // frames over period_us
+        uint32_t worst_us = 0;
+        uint32_t degrades = 0;
+        uint32_t restores = 0;
+        uint32_t frames_at[(int)QualityTier::COUNT]{};
+    };
+
+    explicit QualityGovernor(const QualityGovernorConfig& cfg = {}) : cfg_(cfg), hold_(cfg.restore_frames) {}
+
+    // Feed one frame time; true if the tier changed
+    bool update(uint32_t frame_us);
+    QualityTier tier() const { return tier_; }
+    bool at_least(QualityTier t) const { return tier_ >= t; }
+    uint32_t average_us() const { return avg_us_; }
+    const QualityGovernorConfig& config() const { return cfg_; }
+    const Stats& stats() const { return stats_; }
+    void reset_stats() { stats_ = Stats{}; }
+
+private:
+    static constexpr uint32_t kSettleFrames = 8;    // about the EWMA's time constant
+
+    QualityGovernorConfig cfg_;
+    QualityTier tier_ = QualityTier::Full;
+    uint32_t avg_us_ = 0;
+    uint32_t over_ = 0;             // consecutive frames with the average over budget
+    uint32_t under_ = 0;            // ... under restore_us
+    uint32_t hold_;                 // frames under restore_us needed to step up
+    uint32_t settle_ = 0;           // frames left before the next decision
+    uint32_t since_restore_ = UINT32_MAX;
+    Stats stats_{};
+};
+
+} // namespace eyes
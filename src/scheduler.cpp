@@ -0,0 +1,94 @@
+#include "scheduler.hpp"
+
+#include <cstdio>
+
+namespace eyes {
+
+int Scheduler::add(const char* name, TaskFn fn, void* ctx, uint32_t period_us, uint32_t deadline_us) {
+    if (count_ >= kMaxTasks || !fn) return -1;
+    Task& t = tasks_[count_];
+    t = Task{};
+    t.name = name;
+    t.fn = fn;
+    t.ctx = ctx;
+    t.period_us = period_us;
+    t.deadline_us = deadline_us ? deadline_us : period_us;
+    t.release_us = period_us ? clock_.now_us() : UINT64_MAX;
+    if (count_ == 0) window_start_us_ = clock_.now_us();
+    return count_++;
+}
+
+void Scheduler::wake(int id) {
+    if (id < 0 || id >= count_) return;
+    woken_.fetch_or(1u << id, std::memory_order_release);
+    clock_.signal();
+}
+
+int Scheduler::run_once() {
+    const uint64_t now = clock_.now_us();
+    // Releases: periodic tasks that have come due, then wakes (deadline from when they are seen)
+    uint32_t woken = woken_.exchange(0, std::memory_order_acquire);
+    for (int i = 0; i < count_; ++i) {
+        Task& t = tasks_[i];
+        if (t.pending) continue;
+        if (now >= t.release_us) {
+            t.pending = true;
+            t.due_us = t.release_us + t.deadline_us;
+        } else if (woken & (1u << i)) {
+            t.pending = true;
+            t.due_us = now + t.deadline_us;
+        }
+    }
+    int pick = -1;
+    uint64_t next_release = UINT64_MAX;
+    for (int i = 0; i < count_; ++i) {
+        const Task& t = tasks_[i];
+        if (t.pending && (pick < 0 || t.due_us < tasks_[pick].due_us)) pick = i;
+        if (t.release_us < next_release) next_release = t.release_us;
+    }
+    if (pick < 0) {
+        clock_.wait_until(next_release);
+        idle_us_ += clock_.now_us() - now;
+        return -1;
+    }
+    Task& t = tasks_[pick];
+    t.pending = false;
+    if (t.release_us <= now) {
+        // A run that falls a whole period behind skips releases rather than bunching them up
+        t.release_us += t.period_us;
+        if (t.release_us <= now) t.release_us = now + t.period_us;
+    }
+    t.fn(t.ctx, now);
+    const uint64_t end = clock_.now_us();
+    const uint32_t us = (uint32_t)(end - now);
+    TaskStats& s = t.stats;
+    ++s.runs;
+    s.busy_us += us;
+    if (us > s.max_us) s.max_us = us;
+    if (end > t.due_us) ++s.misses;
+    return pick;
+}
+
+void Scheduler::report() {
+    const uint64_t window = window_us();
+    if (!window) return;
+    printf("sched:");
+    for (int i = 0; i < count_; ++i) {
+        const TaskStats& s = tasks_[i].stats;
+        const uint32_t permille = (uint32_t)(s.busy_us * 1000 / window);
+        printf(" %s %lu.%lu%% max %lu us miss %lu/%lu |", tasks_[i].name, (unsigned long)(permille / 10),
+               (unsigned long)(permille % 10), (unsigned long)s.max_us, (unsigned long)s.misses,
+               (unsigned long)s.runs);
+    }
+    const uint32_t idle = (uint32_t)(idle_us_ * 1000 / window);
+    printf(" idle %lu.%lu%%\n", (unsigned long)(idle / 10), (unsigned long)(idle % 10));
+    reset_stats();
+}
+
+void Scheduler::reset_stats() {
+    for (int i = 0; i < count_; ++i) tasks_[i].stats = TaskStats{};
+    idle_us_ = 0;
+    window_start_us_ = clock_.now_us();
+}
+
+} // namespace eyes
@@ -0,0 +1,76 @@
+// Cooperative scheduler for the main loop. Tasks run to completion on core 0, earliest deadline first;
+// IRQ handlers and alarms only wake tasks. With nothing ready the clock idles until the next release.
+// No hardware dependencies: the target runs it on PicoClock (drivers/pico_clock.hpp), host tools on a
+// fake clock (tools/sched_sim.cpp).
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace eyes {
+
+class Clock {
+public:
+    virtual ~Clock() = default;
+    virtual uint64_t now_us() = 0;
+    // Idle until t_us; may return early (e.g. after signal() from an IRQ)
+    virtual void wait_until(uint64_t t_us) = 0;
+    // Cut a wait_until short; called by Scheduler::wake, so it must be IRQ-safe
+    virtual void signal() {}
+};
+
+class Scheduler {
+public:
+    static constexpr int kMaxTasks = 8;
+    using TaskFn = void (*)(void* ctx, uint64_t now_us);
+
+    struct TaskStats {
+        uint32_t runs = 0;
+        uint32_t misses = 0;    // runs that finished after their deadline
+        uint32_t max_us = 0;    // longest run
+        uint64_t busy_us = 0;
+    };
+
+    explicit Scheduler(Clock& clock) : clock_(clock) {}
+
+    // period_us = 0: runs only when woken. The deadline (0 = one period) counts from the release: the
+    // due time of a periodic run, or the wake() for a woken one. Returns the task id, -1 when full.
+    int add(const char* name, TaskFn fn, void* ctx, uint32_t period_us, uint32_t deadline_us = 0);
+    // Make a task ready now (DMA completion, alarm); safe from IRQ handlers
+    void wake(int id);
+    // Run the ready task with the earliest deadline (ties: the one added first), or idle until the
+    // next release or wake. Returns the id of the task that ran, -1 after idling.
+    int run_once();
+
+    int count() const { return count_; }
+    const char* name(int id) const { return tasks_[id].name; }
+    const TaskStats& stats(int id) const { return tasks_[id].stats; }
+    uint64_t idle_us() const { return idle_us_; }
+    uint64_t window_us() { return clock_.now_us() - window_start_us_; }
+    // One line: CPU share, longest run and deadline misses per task, and idle share, since the last
+    // report; then starts a new window
+    void report();
+    void reset_stats();
+
+private:
+    struct Task {
+        const char* name = nullptr;
+        TaskFn fn = nullptr;
+        void* ctx = nullptr;
+        uint32_t period_us = 0;
+        uint32_t deadline_us = 0;
+        uint64_t release_us = 0;    // next periodic release
+        uint64_t due_us = 0;        // deadline of the pending release
+        bool pending = false;
+        TaskStats stats;
+    };
+
+    Clock& clock_;
+    Task tasks_[kMaxTasks];
+    int count_ = 0;
+    std::atomic<uint32_t> woken_{0};    // bit per task, set by wake()
+    uint64_t idle_us_ = 0;
+    uint64_t window_start_us_ = 0;
+};
+
+} // namespace eyes
@@ -0,0 +1,55 @@
+// Single-writer snapshot: the writer (an audio callback, an IRQ or the other core) publishes a
+// small trivially copyable value, any reader copies out the latest complete one. Neither side
+// blocks or takes a lock; a reader that overlaps a publish sees the sequence move and copies again.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace eyes {
+
+template <class T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots are copied word by word");
+    static constexpr int kWords = (int)((sizeof(T) + 3) / 4);
+
+public:
+    // Writer only (one writer at a time)
+    void publish(const T& value) {
+        uint32_t w[kWords] = {};
+        std::memcpy(w, &value, sizeof(T));
+        const uint32_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);      // odd: a publish is in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < kWords; ++i) words_[i].store(w[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // Latest complete value; false (out untouched) if every try overlapped a publish, which only
+    // happens when the writer runs on the other core and publishes back to back
+    bool read(T& out) const {
+        for (int tries = 0; tries < kReadTries; ++tries) {
+            const uint32_t s = seq_.load(std::memory_order_acquire);
+            if (s & 1) continue;
+            uint32_t w[kWords];
+            for (int i = 0; i < kWords; ++i) w[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) != s) continue;
+            std::memcpy(&out, w, sizeof(T));
+            return true;
+        }
+        return false;
+    }
+
+    // Publishes so far
+    uint32_t version() const { return seq_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    static constexpr int kReadTries = 4;
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint32_t> words_[kWords]{};
+};
+
+} // namespace eyes
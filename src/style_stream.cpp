@@ -0,0 +1,105 @@
+#include "style_stream.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include "default_eye.hpp" // PME_EYELID_WIDTH/HEIGHT (reference screen)
+
+namespace eyes {
+
+namespace {
+    constexpr uint32_t kBlock = BlockCache::kBlockSize;
+    constexpr uint32_t align4(uint32_t n) { return (n + 3) & ~3u; }
+}
+
+const char *StyleStream::name(int index) const {
+    const int e = pack_.style_entry(index);
+    return e < 0 ? nullptr : pack_.entry(e).name;
+}
+
+bool StyleStream::begin(int index) {
+    part_ = kParts;
+    failed_ = false;
+    const int e = pack_.style_entry(index);
+    if (e < 0) return false;
+    const AssetPackEntry &s = pack_.entry(e);
+    // Parts in copy order, with their type and expected size (0 = taken from the entry)
+    struct Want { const char *suffix; AssetType type; int bytes_per_px; int w, h; };
+    constexpr Want kWant[kParts] = {
+        {"iris", AssetType::IrisMap, 2, 0, 0},
+        {"upper", AssetType::UpperLid, 1, PME_EYELID_WIDTH, PME_EYELID_HEIGHT},
+        {"lower", AssetType::LowerLid, 1, PME_EYELID_WIDTH, PME_EYELID_HEIGHT},
+        {"sclera", AssetType::Sclera, 2, 0, 0},
+    };
+    const AssetPackEntry *found[kParts];
+    uint32_t used = 0, total = 0;
+    for (int i = 0; i < kParts; ++i) {
+        char part_name[sizeof s.name + 8];
+        std::snprintf(part_name, sizeof part_name, "%s.%s", s.name, kWant[i].suffix);
+        const int pe = pack_.find(part_name);
+        if (pe < 0) return false;
+        const AssetPackEntry &p = pack_.entry(pe);
+        if (p.type != (uint16_t)kWant[i].type || !p.w || !p.h ||
+            p.size != (uint32_t)p.w * p.h * kWant[i].bytes_per_px ||
+            (kWant[i].w && (p.w != kWant[i].w || p.h != kWant[i].h))) return false;
+        found[i] = &p;
+        parts_[i] = Part{p.offset, p.size, arena_ + used};
+        used += align4(p.size);
+        total += p.size;
+        if (used > arena_size_) return false;
+    }
+    const AssetPackEntry &iris = *found[0], &sclera = *found[3];
+    // Same limits as the built-in styles (eye_style_asset.hpp)
+    if (!s.w || iris.h > 256 || sclera.w < PME_EYELID_WIDTH || sclera.h < PME_EYELID_HEIGHT) return false;
+    style_ = EyeStyle{s.name,
+                      reinterpret_cast<const uint16_t *>(parts_[3].dst), sclera.w, sclera.h,
+                      reinterpret_cast<const uint16_t *>(parts_[0].dst), iris.w, iris.h, s.w,
+                      parts_[1].dst, parts_[2].dst};
+    part_ = 0;
+    part_done_ = 0;
+    loaded_ = 0;
+    total_ = total;
+    errors_ = pack_.cache().stats().errors;
+    hint_read_ahead();
+    return true;
+}
+
+bool StyleStream::step(uint32_t budget_us, uint32_t (*now_us)()) {
+    if (part_ >= kParts) return !failed_;
+    BlockCache &cache = pack_.cache();
+    if (cache.stats().errors != errors_) {
+        failed_ = true;
+        part_ = kParts;
+        cache.prefetch(0, 0);
+        return false;
+    }
+    const uint32_t deadline = now_us() + budget_us;
+    while (part_ < kParts) {
+        const Part &p = parts_[part_];
+        const uint32_t at = p.offset + part_done_;
+        const uint8_t *b = cache.try_block(at / kBlock);
+        if (!b) break; // on its way; the next frame carries on
+        uint32_t n = kBlock - at % kBlock;
+        if (n > p.size - part_done_) n = p.size - part_done_;
+        std::memcpy(p.dst + part_done_, b + at % kBlock, n);
+        part_done_ += n;
+        loaded_ += n;
+        if (part_done_ == p.size) { ++part_; part_done_ = 0; }
+        if ((int32_t)(now_us() - deadline) >= 0) break;
+    }
+    hint_read_ahead();
+    return part_ >= kParts;
+}
+
+void StyleStream::hint_read_ahead() {
+    if (part_ >= kParts) { pack_.cache().prefetch(0, 0); return; }
+    // From the next byte to copy to the end of this part, and on through the parts that follow
+    // it on the device (the packer writes a style's parts back to back in copy order)
+    const Part &p = parts_[part_];
+    const uint32_t first = (p.offset + part_done_) / kBlock;
+    uint32_t end = (p.offset + p.size + kBlock - 1) / kBlock;
+    for (int i = part_ + 1; i < kParts && parts_[i].offset / kBlock == end; ++i)
+        end = (parts_[i].offset + parts_[i].size + kBlock - 1) / kBlock;
+    pack_.cache().prefetch(first, end - first);
+}
+
+} // namespace eyes
@@ -0,0 +1,58 @@
+// Loads one eye style from an AssetPack into a RAM arena over several frames, for App's style
+// switch. Parts are copied in the order the switch needs them (iris map and lids for the LUT build
+// and first sprite, then the sclera), and read-ahead is hinted for the rest of the style from the
+// current position, so the cache fetches ahead of the copy instead of on each miss. The arena holds
+// a single style: a loaded style must be off screen before the next load overwrites it.
+#pragma once
+
+#include <cstdint>
+#include "asset_pack.hpp"
+#include "eye_style.hpp"
+
+namespace eyes {
+
+class StyleStream {
+public:
+    StyleStream(AssetPack &pack, uint8_t *arena, uint32_t arena_size)
+        : pack_(pack), arena_(arena), arena_size_(arena_size) {}
+
+    int count() const { return pack_.style_count(); }
+    const char *name(int index) const;   // nullptr if out of range
+    // Start loading the pack's index-th style. False if it is missing a part, a part has the wrong
+    // size, or the style does not fit the arena.
+    bool begin(int index);
+    // Copy whatever the cache holds of the style (within about budget_us), then hint read-ahead for
+    // what comes next. Call once per frame; true once style() is complete.
+    bool step(uint32_t budget_us, uint32_t (*now_us)());
+    bool loading() const { return part_ < kParts; }
+    bool failed() const { return failed_; }
+    // Bytes copied so far / in the style being loaded
+    uint32_t loaded_bytes() const { return loaded_; }
+    uint32_t total_bytes() const { return total_; }
+    // The arena's style; complete once step() has returned true
+    const EyeStyle &style() const { return style_; }
+
+private:
+    static constexpr int kParts = 4;
+    struct Part {
+        uint32_t offset;    // on the device
+        uint32_t size;
+        uint8_t *dst;
+    };
+
+    void hint_read_ahead();
+
+    AssetPack &pack_;
+    uint8_t *arena_;
+    uint32_t arena_size_;
+    EyeStyle style_{};
+    Part parts_[kParts]{};
+    int part_ = kParts;         // part being copied
+    uint32_t part_done_ = 0;    // bytes of it copied
+    uint32_t loaded_ = 0;
+    uint32_t total_ = 0;
+    uint32_t errors_ = 0;       // cache read errors when the load began
+    bool failed_ = false;
+};
+
+} // namespace eyes
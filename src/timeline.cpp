@@ -0,0 +1,123 @@
+#include "timeline.hpp"
+
+#include <cstring>
+
+namespace eyes {
+
+bool TimelinePlayer::load(const uint8_t* data, size_t len) {
+    playing_ = false;
+    header_ = nullptr;
+    track_count_ = 0;
+    if (!data || len < sizeof(TimelineHeader) || ((uintptr_t)data & 3u)) return false;
+    auto* h = reinterpret_cast<const TimelineHeader*>(data);
+    if (std::memcmp(h->magic, "PMTL", 4) != 0 || h->version != kTimelineVersion) return false;
+    if (h->track_count > kMaxTracks || h->sample_rate == 0 || h->duration == 0) return false;
+    if (len < sizeof(TimelineHeader) + h->track_count * sizeof(TimelineTrackDesc)) return false;
+    auto* descs = reinterpret_cast<const TimelineTrackDesc*>(data + sizeof(TimelineHeader));
+    for (int i = 0; i < h->track_count; ++i) {
+        const TimelineTrackDesc& d = descs[i];
+        if (d.kind >= static_cast<uint8_t>(TimelineTrackKind::COUNT)) return false;
+        if (d.interp > static_cast<uint8_t>(TimelineInterp::Smooth)) return false;
+        if (d.key_count == 0 || (d.keys_offset & 3u)) return false;
+        if (d.keys_offset + (size_t)d.key_count * sizeof(TimelineKey) > len) return false;
+        Track& t = tracks_[i];
+        t.keys = reinterpret_cast<const TimelineKey*>(data + d.keys_offset);
+        t.count = d.key_count;
+        t.kind = static_cast<TimelineTrackKind>(d.kind);
+        t.interp = t.kind == TimelineTrackKind::Emotion ? TimelineInterp::Step : static_cast<TimelineInterp>(d.interp);
+        t.cursor = 0;
+    }
+    header_ = h;
+    track_count_ = h->track_count;
+    return true;
+}
+
+void TimelinePlayer::rewind() {
+    for (int i = 0; i < track_count_; ++i) tracks_[i].cursor = 0;
+    last_t_ = 0;
+}
+
+// Fire every cue crossed up to t (cursor = next unfired key)
+void TimelinePlayer::fire_cues(uint32_t t, TimelineFrame& out) {
+    for (int i = 0; i < track_count_; ++i) {
+        Track& tr = tracks_[i];
+        if (tr.kind != TimelineTrackKind::Cue) continue;
+        while (tr.cursor < tr.count && tr.keys[tr.cursor].time <= t) {
+            const TimelineKey& k = tr.keys[tr.cursor++];
+            if (out.cue_count < TimelineFrame::kMaxCues) {
+                out.cue_id[out.cue_count] = (uint8_t)k.v0;
+                out.cue_gain[out.cue_count] = k.v1 * (1.f / 4096.f);
+                ++out.cue_count;
+            }
+        }
+    }
+}
+
+void TimelinePlayer::start(uint64_t start_sample) {
+    if (!header_) return;
+    start_sample_ = start_sample;
+    rewind();
+    playing_ = true;
+}
+
+void TimelinePlayer::evaluate(uint64_t now_sample, TimelineFrame& out) {
+    out = TimelineFrame{};
+    if (!playing_ || !header_) { out.finished = true; return; }
+    uint64_t elapsed = now_sample > start_sample_ ? now_sample - start_sample_ : 0;
+    if (elapsed >= header_->duration) {
+        if (header_->flags & kTimelineLoop) {
+            // Re-anchor on the wrapped position so the clock never drifts from the audio
+            uint64_t wraps = elapsed / header_->duration;
+            start_sample_ += wraps * header_->duration;
+            elapsed -= wraps * header_->duration;
+            fire_cues(header_->duration, out); // the rest of the loop first
+            rewind();
+        } else {
+            elapsed = header_->duration;
+            playing_ = false;
+            out.finished = true;
+        }
+    }
+    const uint32_t t = (uint32_t)elapsed;
+    if (t < last_t_) {
+        // Clock stepped backwards: cursors restart from the first key, cues from the first after t
+        rewind();
+        for (int i = 0; i < track_count_; ++i) {
+            Track& tr = tracks_[i];
+            if (tr.kind != TimelineTrackKind::Cue) continue;
+            while (tr.cursor < tr.count && tr.keys[tr.cursor].time <= t) ++tr.cursor;
+        }
+    }
+    last_t_ = t;
+    fire_cues(t, out);
+
+    for (int i = 0; i < track_count_; ++i) {
+        Track& tr = tracks_[i];
+        if (tr.kind == TimelineTrackKind::Cue) continue;
+        if (t < tr.keys[0].time) continue; // not started yet
+        while (tr.cursor + 1 < tr.count && tr.keys[tr.cursor + 1].time <= t) ++tr.cursor;
+        const TimelineKey& a = tr.keys[tr.cursor];
+        float v0 = a.v0, v1 = a.v1;
+        if (tr.interp != TimelineInterp::Step && tr.cursor + 1 < tr.count) {
+            const TimelineKey& b = tr.keys[tr.cursor + 1];
+            float f = (float)(t - a.time) / (float)(b.time - a.time);
+            if (tr.interp == TimelineInterp::Smooth) f = f * f * (3.f - 2.f * f);
+            v0 += (b.v0 - a.v0) * f;
+            v1 += (b.v1 - a.v1) * f;
+        }
+        switch (tr.kind) {
+            case TimelineTrackKind::Gaze:
+                out.has_gaze = true; out.gaze_x = v0 * (1.f / 16.f); out.gaze_y = v1 * (1.f / 16.f); break;
+            case TimelineTrackKind::Pupil:
+                out.has_pupil = true; out.pupil_scale = v0 * (1.f / 4096.f); break;
+            case TimelineTrackKind::Eyelid:
+                out.has_eyelid = true; out.eyelid_open = v0 * (1.f / 4096.f); break;
+            case TimelineTrackKind::Emotion:
+                out.has_emotion = true; out.emotion = (uint8_t)a.v0; break;
+            default:
+                break;
+        }
+    }
+}
+
+} // namespace eyes
@@ -0,0 +1,105 @@
+// Scripted animation timelines (gaze, pupil, eyelid, emotion, audio cues).
+// Binary format is read in place (flash/XIP); see docs/timeline.md and tools/timeline_compile.py.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eyes {
+
+// ---- On-disk format (little-endian, every section 4-byte aligned) ----
+struct TimelineHeader {
+    char magic[4];          // "PMTL"
+    uint16_t version;       // kTimelineVersion
+    uint16_t track_count;
+    uint32_t sample_rate;   // timebase: audio samples per second
+    uint32_t duration;      // samples; playback ends (or wraps) here
+    uint32_t flags;         // TimelineFlags
+};
+
+struct TimelineTrackDesc {
+    uint8_t kind;           // TimelineTrackKind
+    uint8_t interp;         // TimelineInterp
+    uint16_t key_count;
+    uint32_t keys_offset;   // bytes from start of blob to TimelineKey[key_count], sorted by time
+};
+
+struct TimelineKey {
+    uint32_t time;          // sample position
+    int16_t v0;
+    int16_t v1;
+};
+
+static_assert(sizeof(TimelineHeader) == 20, "timeline header layout");
+static_assert(sizeof(TimelineTrackDesc) == 8, "timeline track layout");
+static_assert(sizeof(TimelineKey) == 8, "timeline key layout");
+
+constexpr uint16_t kTimelineVersion = 1;
+
+enum TimelineFlags : uint32_t { kTimelineLoop = 1u << 0 };
+
+// Value encoding per track kind:
+//  Gaze:    v0/v1 = iris offset from panel centre, 1/16 px at the 128x128 reference size
+//  Pupil:   v0 = pupil scale, Q12 (4096 = 1.0)
+//  Eyelid:  v0 = eyelid openness, Q12 (0 closed .. 4096 open)
+//  Emotion: v0 = emotion index (App::Emotion order); always stepped
+//  Cue:     v0 = audio clip id, v1 = gain Q12; fires once when crossed
+enum class TimelineTrackKind : uint8_t { Gaze, Pupil, Eyelid, Emotion, Cue, COUNT };
+enum class TimelineInterp : uint8_t { Step, Linear, Smooth };
+
+// Values sampled for one frame. has_* false means the track is absent or has not started yet.
+struct TimelineFrame {
+    static constexpr int kMaxCues = 4;
+    bool has_gaze = false;
+    float gaze_x = 0.f, gaze_y = 0.f;   // reference px offset from centre
+    bool has_pupil = false;
+    float pupil_scale = 1.f;
+    bool has_eyelid = false;
+    float eyelid_open = 1.f;
+    bool has_emotion = false;
+    uint8_t emotion = 0;
+    uint8_t cue_count = 0;              // cues crossed since the previous evaluate()
+    uint8_t cue_id[kMaxCues]{};
+    float cue_gain[kMaxCues]{};
+    bool finished = false;
+};
+
+// Evaluates a timeline against a monotonic sample clock. Each track caches its key cursor, so a
+// frame costs O(tracks) plus the keys actually crossed; no searching unless the clock jumps back.
+class TimelinePlayer {
+public:
+    static constexpr int kMaxTracks = 8;
+
+    // Validates and binds the blob (no copy; data must outlive playback and be 4-byte aligned).
+    bool load(const uint8_t* data, size_t len);
+    // Start playback with the timeline's t=0 at sample position start_sample of the clock.
+    void start(uint64_t start_sample);
+    void stop() { playing_ = false; }
+    bool playing() const { return playing_; }
+    uint32_t sample_rate() const { return header_ ? header_->sample_rate : 0; }
+
+    // Sample all tracks at clock position now_sample. Clears playing() once finished. Cues fire once
+    // per crossing: a looping timeline fires those before its end, then those after the wrap; when
+    // the clock steps backwards, cues at or before the new position are not fired again.
+    void evaluate(uint64_t now_sample, TimelineFrame& out);
+
+private:
+    struct Track {
+        const TimelineKey* keys;
+        uint16_t count;
+        uint16_t cursor;    // last key with time <= t (or next unfired key for cue tracks)
+        TimelineTrackKind kind;
+        TimelineInterp interp;
+    };
+    void rewind();
+    void fire_cues(uint32_t t, TimelineFrame& out);
+
+    const TimelineHeader* header_ = nullptr;
+    Track tracks_[kMaxTracks]{};
+    int track_count_ = 0;
+    uint64_t start_sample_ = 0;
+    uint32_t last_t_ = 0;
+    bool playing_ = false;
+};
+
+} // namespace eyes
@@ -0,0 +1,79 @@
+// Host benchmark of anti-aliasing (EyeRenderParams::antialias): one eye with the App's parameters
+// (sprite, compose, lids, culled), aliased against anti-aliased, flat and spherical, half open so
+// both lid edges cross the eye, with the pupil size varying so its edge table is rebuilt every run.
+// Anti-aliasing must change only edge pixels: some, and under 10% of the frame.
+//
+//     g++ -std=c++17 -O2 -Iinclude -Isrc -Iboards -Iassets/graphics -o antialias_bench tools/antialias_bench.cpp
+//         src/eye_renderer.cpp assets/graphics/default_eye.cpp
+//     ./antialias_bench
+#include "eye_renderer.hpp"
+#include "pico2_panel.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace eyes;
+
+namespace {
+
+using Panel = ActivePanel;
+constexpr int kRuns = 1000;
+bool g_ok = true;
+volatile uint32_t g_sink;
+
+void check(bool cond, const char *what) {
+    std::printf("  %-64s %s\n", what, cond ? "ok" : "FAILED");
+    g_ok = g_ok && cond;
+}
+
+template <class F>
+double us_per(F f) {
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kRuns; ++i) f(i);
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / kRuns;
+        if (us < best) best = us;
+    }
+    return best;
+}
+
+void render(uint16_t *frame, EyeRenderParams &p, int i) {
+    p.pupil_scale = 0.8f + 0.05f * (i % 8);
+    EyelidSpans<Panel> spans;
+    compute_eyelid_spans<Panel>(p, spans);
+    const CulledEye<Panel> eye{&p, &spans};
+    compose_eye<Panel>(frame, render_iris_sprite<Panel>(p, &eye, 1), p, &spans);
+    apply_eyelids<Panel>(frame, p);
+    g_sink = frame[i & 255];
+}
+
+uint16_t g_frame[2][Panel::kPixels];
+
+} // namespace
+
+int main() {
+    EyeRenderParams p;
+    p.iris_radius = kDefaultIrisRadius<Panel>;
+    p.sclera_parallax = 1.f;
+    p.eyelid_open = 0.5f;
+
+    std::printf("one eye (us, best of 5 x %d):\n", kRuns);
+    char what[96];
+    for (bool spherical : {false, true}) {
+        p.spherical = spherical;
+        double us[2];
+        for (int aa = 0; aa < 2; ++aa) {
+            p.antialias = aa == 1;
+            us[aa] = us_per([&](int i) { render(g_frame[aa], p, i); });
+            render(g_frame[aa], p, 3);
+        }
+        int changed = 0;
+        for (int i = 0; i < Panel::kPixels; ++i) changed += g_frame[0][i] != g_frame[1][i];
+        std::snprintf(what, sizeof what, "%s: %.2f aliased, %.2f anti-aliased, %d px changed",
+                      spherical ? "spherical" : "flat", us[0], us[1], changed);
+        check(changed > 0 && changed < Panel::kPixels / 10, what);
+    }
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
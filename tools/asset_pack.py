@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Build a PMEA asset pack (read by src/asset_pack.cpp) from Uncanny Eyes graphics headers and WAV clips.
+
+Each style becomes a Style entry plus its parts, written back to back in the order the firmware
+copies them (iris map, upper lid, lower lid, sclera) so read-ahead runs straight through a style.
+Clips must be mono 16-bit PCM. The pack is a raw image for the start of an SD card (no filesystem):
+
+    asset_pack.py -o eyes.pmea --style cat=external/Uncanny_Eyes/uncannyEyes/graphics/catEye.h \\
+                  --style newt=external/Uncanny_Eyes/uncannyEyes/graphics/newtEye.h --clip 3=growl.wav
+    dd if=eyes.pmea of=/dev/sdX bs=512 conv=fsync
+
+Layout and entry fields: docs/asset_streaming.md.
+"""
+import argparse
+import re
+import struct
+import sys
+import wave
+
+MAGIC = b"PMEA"
+VERSION = 1
+BLOCK = 512
+MAX_ENTRIES = 48  # AssetPack::kMaxEntries
+NAME_LEN = 24
+
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<24sIIHHHH")
+
+TYPE_STYLE, TYPE_SCLERA, TYPE_IRIS, TYPE_UPPER, TYPE_LOWER, TYPE_CLIP = range(1, 7)
+
+ARRAY_RE = re.compile(r"(?:static\s+)?(?:const\s+)?uint(8|16)_t\s+(\w+)\s*\[(\d+)\]\s*\[(\d+)\]\s*(?:PROGMEM\s*)?=\s*\{(.*?)\}\s*;",
+                      re.S)
+DEFINE_RE = re.compile(r"^\s*#define\s+(\w+)\s+(\d+)", re.M)
+NUMBER_RE = re.compile(r"0[xX][0-9a-fA-F]+|\d+")
+
+
+def parse_header(path):
+    text = open(path, encoding="utf-8", errors="replace").read()
+    text = re.sub(r"//[^\n]*|/\*.*?\*/", "", text, flags=re.S)
+    defines = {m.group(1): int(m.group(2)) for m in DEFINE_RE.finditer(text)}
+    arrays = {}
+    for m in ARRAY_RE.finditer(text):
+        bits, name, h, w = int(m.group(1)), m.group(2), int(m.group(3)), int(m.group(4))
+        values = [int(v, 0) for v in NUMBER_RE.findall(m.group(5))]
+        if len(values) != w * h:
+            raise ValueError(f"{path}: {name} has {len(values)} values, expected {w}x{h}")
+        fmt = "<%dH" % len(values) if bits == 16 else "%dB" % len(values)
+        arrays[name] = (w, h, struct.pack(fmt, *values))
+    return defines, arrays
+
+
+def style_entries(label, path):
+    defines, arrays = parse_header(path)
+    for name in ("iris", "upper", "lower", "sclera"):
+        if name not in arrays:
+            raise ValueError(f"{path}: no {name} array")
+    if "IRIS_WIDTH" not in defines:
+        raise ValueError(f"{path}: no IRIS_WIDTH")
+    for lid in ("upper", "lower"):
+        if arrays[lid][:2] != (128, 128):
+            raise ValueError(f"{path}: {lid} map must be 128x128 (the reference screen)")
+    entries = [(label, TYPE_STYLE, defines["IRIS_WIDTH"], 0, b"")]
+    for part, kind in (("iris", TYPE_IRIS), ("upper", TYPE_UPPER), ("lower", TYPE_LOWER), ("sclera", TYPE_SCLERA)):
+        w, h, data = arrays[part]
+        entries.append((f"{label}.{part}", kind, w, h, data))
+    return entries
+
+
+def clip_entry(clip_id, path):
+    with wave.open(path, "rb") as wav:
+        if wav.getnchannels() != 1 or wav.getsampwidth() != 2:
+            raise ValueError(f"{path}: clips must be mono 16-bit PCM")
+        rate = wav.getframerate()
+        if rate > 0xFFFF:
+            raise ValueError(f"{path}: sample rate {rate} does not fit the entry")
+        return (f"clip{clip_id}", TYPE_CLIP, rate, clip_id, wav.readframes(wav.getnframes()))
+
+
+def build(entries):
+    if len(entries) > MAX_ENTRIES:
+        raise ValueError(f"{len(entries)} entries, the firmware reads at most {MAX_ENTRIES}")
+    align = lambda n: (n + BLOCK - 1) // BLOCK * BLOCK
+    dir_offset = HEADER.size
+    offset = align(dir_offset + ENTRY.size * len(entries))
+    directory, body = b"", b""
+    for name, kind, w, h, data in entries:
+        raw = name.encode()
+        if len(raw) >= NAME_LEN:
+            raise ValueError(f"name too long: {name}")
+        directory += ENTRY.pack(raw, offset, len(data), kind, w, h, 0)
+        padded = data + bytes(align(len(data)) - len(data))
+        body += padded
+        offset += len(padded)
+    head = HEADER.pack(MAGIC, VERSION, len(entries), dir_offset, 0) + directory
+    return head + bytes(align(len(head)) - len(head)) + body
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("-o", "--output", required=True)
+    ap.add_argument("--style", action="append", default=[], metavar="NAME=HEADER")
+    ap.add_argument("--clip", action="append", default=[], metavar="ID=WAV")
+    args = ap.parse_args()
+    try:
+        entries = []
+        for spec in args.style:
+            label, _, path = spec.partition("=")
+            entries += style_entries(label, path)
+        for spec in args.clip:
+            clip_id, _, path = spec.partition("=")
+            entries.append(clip_entry(int(clip_id), path))
+        image = build(entries)
+    except (OSError, ValueError) as e:
+        print(f"asset_pack: {e}", file=sys.stderr)
+        return 1
+    with open(args.output, "wb") as f:
+        f.write(image)
+    styles = sum(1 for e in entries if e[1] == TYPE_STYLE)
+    print(f"{args.output}: {styles} styles, {len(entries) - styles * 5} clips, {len(image)} bytes ({len(image) // BLOCK} blocks)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
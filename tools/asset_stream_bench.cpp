@@ -0,0 +1,194 @@
+// Host benchmark of asset streaming (BlockCache, AssetPack, StyleStream) on a pack file written by
+// tools/asset_pack.py: raw cache throughput over the file, a check of every streamed style against
+// a plain read of its entries (and of a style named "default" against the upstream header), and a
+// style switch on a fake clock with the App's task set (a 1 ms assets task woken by transfer
+// completions that moves blocks and copies the style, a 20 ms frame) over a modelled SD card, with
+// and without read-ahead. The model is a 25 MHz SPI card: ~1 ms to open a stream, ~220 us per block.
+//
+//     python3 tools/asset_pack.py -o eyes.pmea --style default=external/Uncanny_Eyes/uncannyEyes/graphics/defaultEye.h
+//     g++ -std=c++17 -O2 -Iinclude -Isrc -Iassets/graphics -o asset_stream_bench tools/asset_stream_bench.cpp
+//         src/block_cache.cpp src/asset_pack.cpp src/style_stream.cpp src/scheduler.cpp
+//     ./asset_stream_bench eyes.pmea
+#include "asset_pack.hpp"
+#include "block_cache.hpp"
+#include "default_eye.hpp"
+#include "file_block_device.hpp"
+#include "scheduler.hpp"
+#include "style_stream.hpp"
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#include "../external/Uncanny_Eyes/uncannyEyes/graphics/defaultEye.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace eyes;
+
+namespace {
+
+constexpr uint32_t kArenaBytes = 160 * 1024;
+uint8_t g_arena[kArenaBytes];
+
+double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Sequential and scattered reads through the cache with the device answering at once
+void raw_throughput(BlockCache &cache, uint32_t blocks) {
+    static uint8_t buf[BlockCache::kBlockSize];
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t b = 0; b < blocks; ++b) cache.read(b * BlockCache::kBlockSize, buf, sizeof buf);
+    const double seq = seconds_since(t0);
+    // Scattered reads over a working set twice the cache: LRU keeps about half of it
+    cache.reset_stats();
+    uint32_t s = 7;
+    const uint32_t span = blocks < 2u * BlockCache::kSlots ? blocks : 2u * BlockCache::kSlots;
+    t0 = std::chrono::steady_clock::now();
+    constexpr int kReads = 20000;
+    for (int i = 0; i < kReads; ++i) {
+        s = s * 1664525u + 1013904223u;
+        cache.read(((s >> 8) % span) * BlockCache::kBlockSize, buf, sizeof buf);
+    }
+    const double rnd = seconds_since(t0);
+    const BlockCache::Stats &st = cache.stats();
+    std::printf("raw: sequential %.1f MB/s over %u blocks; scattered over %u blocks %.1f MB/s, hit rate %.0f%%\n",
+                blocks * BlockCache::kBlockSize / seq / 1e6, blocks, span, kReads * BlockCache::kBlockSize / rnd / 1e6,
+                100.0 * st.hits / (st.hits + st.misses));
+}
+
+// Stream every style (device answering at once) and compare it with its entries read directly
+bool check_styles(AssetPack &pack, StyleStream &stream) {
+    bool ok = true;
+    for (int i = 0; i < stream.count(); ++i) {
+        if (!stream.begin(i)) { std::printf("check: style %s rejected\n", stream.name(i)); ok = false; continue; }
+        while (!stream.step(1000000, [] { return 0u; }) && !stream.failed()) pack.cache().poll();
+        const EyeStyle &s = stream.style();
+        struct Part { const char *suffix; const void *data; };
+        const Part parts[] = {{"iris", s.iris_map}, {"upper", s.upper}, {"lower", s.lower}, {"sclera", s.sclera}};
+        bool same = !stream.failed();
+        for (const Part &p : parts) {
+            char name[40];
+            std::snprintf(name, sizeof name, "%s.%s", s.name, p.suffix);
+            const AssetPackEntry &e = pack.entry(pack.find(name));
+            std::vector<uint8_t> direct(e.size);
+            same = same && pack.cache().read(e.offset, direct.data(), e.size) && std::memcmp(direct.data(), p.data, e.size) == 0;
+        }
+        if (std::strcmp(s.name, "default") == 0) {
+            same = same && s.sclera_w == SCLERA_WIDTH && s.iris_map_w == IRIS_MAP_WIDTH && s.iris_w == IRIS_WIDTH &&
+                   std::memcmp(s.sclera, sclera, sizeof sclera) == 0 && std::memcmp(s.iris_map, iris, sizeof iris) == 0 &&
+                   std::memcmp(s.upper, upper, sizeof upper) == 0 && std::memcmp(s.lower, lower, sizeof lower) == 0;
+        }
+        std::printf("check: style %s (%u bytes) %s\n", s.name, (unsigned)stream.total_bytes(), same ? "ok" : "MISMATCH");
+        ok = ok && same;
+    }
+    return ok;
+}
+
+// Fake scheduler clock: time moves when a task works or the scheduler idles; a modelled transfer
+// completing wakes the assets task, as the DMA IRQ does on the board
+class SimClock : public Clock {
+public:
+    FileBlockDevice *dev = nullptr;
+    Scheduler *sched = nullptr;
+    int assets_task = -1;
+
+    uint64_t now_us() override { return now_; }
+    void wait_until(uint64_t t_us) override {
+        if (signalled_) { signalled_ = false; return; }
+        if (pending_completion() && dev->done_us() < t_us) { advance_to(dev->done_us()); return; }
+        advance_to(t_us);
+        signalled_ = false;
+    }
+    void signal() override { signalled_ = true; }
+    void advance(uint64_t us) { advance_to(now_ + us); }
+
+private:
+    bool pending_completion() const { return dev->busy() && dev->done_us() != woken_for_; }
+    void advance_to(uint64_t t) {
+        now_ = t;
+        if (pending_completion() && dev->done_us() <= now_) {
+            woken_for_ = dev->done_us();
+            sched->wake(assets_task);
+        }
+    }
+    uint64_t now_ = 0;
+    uint64_t woken_for_ = UINT64_MAX;
+    bool signalled_ = false;
+};
+
+struct Sim {
+    SimClock clock;
+    Scheduler sched{clock};
+    BlockCache *cache = nullptr;
+    StyleStream *stream = nullptr;
+    int frames = 0;
+    bool done = false;
+};
+
+void simulate_switch(const char *path, int style, bool read_ahead) {
+    FileBlockDevice dev(path);
+    BlockCache cache(dev);
+    AssetPack pack(cache);
+    if (!dev.init() || !pack.open()) { std::printf("sim: no pack\n"); return; }
+    // Directory read at boot untimed; the switch itself on the modelled card
+    Sim sim;
+    FileBlockDevice::Timing timing;
+    timing.command_us = 1000;
+    timing.block_us = 220;
+    dev.set_timing(timing, [](void *c) { return static_cast<SimClock *>(c)->now_us(); }, &sim.clock);
+    cache.set_read_ahead(read_ahead);
+    cache.reset_stats();
+    StyleStream stream(pack, g_arena, sizeof g_arena);
+    sim.cache = &cache;
+    sim.stream = &stream;
+    sim.clock.dev = &dev;
+    sim.clock.sched = &sim.sched;
+    // As in App: the assets task moves blocks and copies the style; the frame only waits for it
+    sim.clock.assets_task = sim.sched.add("assets", [](void *p, uint64_t) {
+        Sim *m = static_cast<Sim *>(p);
+        m->cache->poll();
+        if (m->stream->loading()) m->stream->step(500, [] { return 0u; });
+        m->clock.advance(5);
+    }, &sim, 1000, 20000);
+    sim.sched.add("frame", [](void *p, uint64_t) {
+        Sim *m = static_cast<Sim *>(p);
+        ++m->frames;
+        m->done = !m->stream->loading();
+        m->clock.advance(12000); // render and blit
+    }, &sim, 20000);
+    stream.begin(style);
+    while (!sim.done && sim.clock.now_us() < 60000000) sim.sched.run_once();
+    const BlockCache::Stats &st = cache.stats();
+    std::printf("sim: read-ahead %-3s: %s %u bytes in %d frames (%.0f ms), %u device reads, %u stream opens, "
+                "hits %u misses %u prefetched %u (used %u)\n",
+                read_ahead ? "on" : "off", stream.failed() ? "FAILED" : "loaded", (unsigned)stream.total_bytes(),
+                sim.frames, sim.frames * 20.0, dev.reads(), dev.commands(), st.hits, st.misses, st.prefetched,
+                st.prefetch_used);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s pack.pmea\n", argv[0]);
+        return 2;
+    }
+    FileBlockDevice dev(argv[1]);
+    if (!dev.init()) { std::perror(argv[1]); return 1; }
+    static BlockCache cache(dev);
+    AssetPack pack(cache);
+    if (!pack.open()) { std::fprintf(stderr, "%s: not an asset pack\n", argv[1]); return 1; }
+    std::printf("pack: %d entries, %d styles, %u blocks\n", pack.count(), pack.style_count(), dev.block_count());
+    raw_throughput(cache, dev.block_count());
+    StyleStream stream(pack, g_arena, sizeof g_arena);
+    const bool ok = check_styles(pack, stream);
+    if (pack.style_count() > 0) {
+        simulate_switch(argv[1], 0, false);
+        simulate_switch(argv[1], 0, true);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+// Host benchmark for EyeAnimator::step: per-frame and per-eye cost for 1..8 eyes, either all
+// independent or one leader with followers (the pair/cluster setup, which only steps the leader).
+//
+//     g++ -std=c++17 -O2 -Isrc -o bench_animator tools/bench_animator.cpp src/eye_animator.cpp
+//     ./bench_animator
+#include "eye_animator.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace eyes;
+
+namespace {
+
+constexpr int kFrames = 200000;
+
+double ns_per_step(int eyes, bool followers) {
+    EyeAnimator anim(128.f, 128.f);
+    anim.set_gaze_margin(30);
+    for (int i = 0; i < eyes; ++i) {
+        anim.add_eye(EyeMount{(i - (eyes - 1) * 0.5f) * 40.f, followers && i > 0 ? 0 : -1});
+    }
+    AnimInputs in;
+    float sink = 0.f;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        anim.step(in);
+        sink += anim.iris_x(eyes - 1);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    if (sink == 42.f) std::puts(""); // keep the loop observable
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / kFrames;
+}
+
+} // namespace
+
+int main() {
+    std::printf("eyes  independent ns/step (ns/eye)  followers ns/step (ns/eye)\n");
+    for (int n = 1; n <= EyeAnimator::kMaxEyes; ++n) {
+        double a = ns_per_step(n, false);
+        double b = ns_per_step(n, true);
+        std::printf("%4d  %10.1f (%6.1f)            %10.1f (%6.1f)\n", n, a, a / n, b, b / n);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Host benchmark of eyelid culling (compute_eyelid_spans): render cost of both eyes with the App's
+// eye parameters (spherical, anti-aliased) across the blink cycle, rendering everything and then
+// only what the lids leave visible. Each eye of the culled frame must equal the unculled one.
+//
+//     g++ -std=c++17 -O2 -Iinclude -Isrc -Iboards -Iassets/graphics -o blink_bench tools/blink_bench.cpp
+//         src/eye_renderer.cpp assets/graphics/default_eye.cpp
+//     ./blink_bench
+#include "eye_renderer.hpp"
+#include "pico2_panel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+using namespace eyes;
+
+namespace {
+
+using Panel = ActivePanel;
+constexpr int kRuns = 500;
+constexpr float kOpen[] = {1.f, 0.75f, 0.5f, 0.25f, 0.1f, 0.f};
+bool g_ok = true;
+volatile uint32_t g_sink;
+
+template <class F>
+double us_per(F f) {
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kRuns; ++i) f(i);
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / kRuns;
+        if (us < best) best = us;
+    }
+    return best;
+}
+
+uint16_t g_frame[2][Panel::kPixels], g_full[2][Panel::kPixels];
+
+// Both eyes from one sprite, as App renders a frame (the pupil changes every frame, so the sprite
+// is redrawn); culled renders only the spans the lids leave open
+void render_pair(uint16_t (&out)[2][Panel::kPixels], EyeRenderParams &l, EyeRenderParams &r, bool culled, int i) {
+    l.pupil_scale = r.pupil_scale = 0.8f + 0.05f * (i % 8);
+    EyelidSpans<Panel> spans_l, spans_r;
+    const IrisSprite<Panel> *s;
+    const EyelidSpans<Panel> *sl = nullptr, *sr = nullptr;
+    if (culled) {
+        compute_eyelid_spans<Panel>(l, spans_l);
+        compute_eyelid_spans<Panel>(r, spans_r);
+        const CulledEye<Panel> eyes[2] = {{&l, &spans_l}, {&r, &spans_r}};
+        s = &render_iris_sprite<Panel>(l, eyes, 2);
+        sl = &spans_l;
+        sr = &spans_r;
+    } else {
+        s = &render_iris_sprite<Panel>(l);
+    }
+    compose_eye<Panel>(out[0], *s, l, sl);
+    apply_eyelids<Panel>(out[0], l);
+    compose_eye<Panel>(out[1], *s, r, sr);
+    apply_eyelids<Panel>(out[1], r);
+    g_sink = out[0][i & 255] ^ out[1][i & 255];
+}
+
+} // namespace
+
+int main() {
+    EyeRenderParams l;
+    l.iris_radius = kDefaultIrisRadius<Panel>;
+    l.spherical = true;
+    l.antialias = true;
+    l.sclera_parallax = 1.f;
+    l.mirror_eyelids = true;
+    EyeRenderParams r = l;
+    r.mirror_eyelids = false;
+    r.iris_center_x = l.iris_center_x - 6; // some vergence so the two eyes' spans differ
+
+    std::printf("both eyes (us, best of 5 x %d):\n", kRuns);
+    for (float open : kOpen) {
+        l.eyelid_open = r.eyelid_open = open;
+        const double full = us_per([&](int i) { render_pair(g_frame, l, r, false, i); });
+        const double culled = us_per([&](int i) { render_pair(g_frame, l, r, true, i); });
+        render_pair(g_full, l, r, false, 3);
+        render_pair(g_frame, l, r, true, 3);
+        const bool same = std::equal(&g_frame[0][0], &g_frame[0][0] + 2 * Panel::kPixels, &g_full[0][0]);
+        std::printf("  open %.2f: %7.2f full %7.2f culled, culled frame %s\n", (double)open, full, culled,
+                    same ? "identical ok" : "differs FAILED");
+        g_ok = g_ok && same;
+    }
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""Rebuild frames from the PicoMonsterEyes capture stream (PME_FRAME_CAPTURE, see docs/capture.md).
+
+Live from the stdio UART, writing one PNG per captured frame and echoing the firmware's text:
+    capture_decode.py --port /dev/ttyACM0 --out capture/
+
+From a raw dump (e.g. recorded with --save):
+    capture_decode.py --file capture.bin --out capture/
+
+Images start once every band has been received whole (a key band); until then the decoder has no
+reference to apply deltas to. Frames whose bands the firmware had to skip are still written: the
+skipped rows show the previous frame, and the summary counts them.
+"""
+import argparse
+import binascii
+import os
+import struct
+import sys
+import zlib
+
+SYNC = b"\xA5\xC3"
+HEADER = 14
+TYPE_BAND, TYPE_TEXT = 1, 2
+FLAG_KEY = 0x01
+W = H = 128
+BAND_ROWS = 16
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from pme_control import open_port  # noqa: E402
+
+
+def decode_rows(payload, ref, x, y, w, rows, key):
+    """Apply one band's tokens to ref (list of rows of RGB565 ints). Returns False on a short payload."""
+    i = 0
+    for r in range(rows):
+        line = ref[y + r]
+        c = x
+        end = x + w
+        while c < end:
+            if i >= len(payload):
+                return False
+            t = payload[i]
+            i += 1
+            n = (t & 0x7F) + 1
+            if t < 0x80:
+                c += n
+                continue
+            for _ in range(n):
+                v = payload[i] | (payload[i + 1] << 8)
+                i += 2
+                line[c] = v if key else line[c] ^ v
+                c += 1
+    return True
+
+
+def write_png(path, frame):
+    raw = bytearray()
+    for line in frame:
+        raw.append(0)
+        for v in line:
+            r, g, b = (v >> 11) & 0x1F, (v >> 5) & 0x3F, v & 0x1F
+            raw += bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)))
+
+    def chunk(kind, data):
+        return struct.pack(">I", len(data)) + kind + data + struct.pack(">I", zlib.crc32(kind + data))
+
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", len(frame[0]), len(frame), 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(bytes(raw), 6)))
+        f.write(chunk(b"IEND", b""))
+
+
+def write_raw(path, frame):
+    with open(path, "wb") as f:
+        for line in frame:
+            f.write(struct.pack(f"<{len(line)}H", *line))
+
+
+class Decoder:
+    def __init__(self, out, fmt):
+        self.out = out
+        self.write = write_png if fmt == "png" else write_raw
+        self.ext = fmt
+        self.buf = bytearray()
+        self.ref = {}        # display -> rows
+        self.keyed = {}      # display -> set of keyed bands
+        self.frame = {}      # display -> frame number being assembled
+        self.written = 0
+        self.bands = 0
+        self.keys = 0
+        self.crc_errors = 0
+        self.skipped_bands = 0
+        self.text = bytearray()
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            i = self.buf.find(SYNC)
+            if i < 0:
+                del self.buf[:-1]
+                return
+            del self.buf[:i]
+            if len(self.buf) < HEADER:
+                return
+            length = self.buf[11] | (self.buf[12] << 8)
+            total = HEADER + length + 2
+            if len(self.buf) < total:
+                return
+            body = bytes(self.buf[2:HEADER + length])
+            crc = self.buf[HEADER + length] | (self.buf[HEADER + length + 1] << 8)
+            if binascii.crc_hqx(body, 0xFFFF) != crc:
+                self.crc_errors += 1
+                del self.buf[:1]  # resync on the next marker
+                continue
+            del self.buf[:total]
+            self.packet(body)
+
+    def packet(self, body):
+        kind, display, flags = body[0], body[1], body[2]
+        payload = body[HEADER - 2:]
+        if kind == TYPE_TEXT:
+            sys.stdout.write(payload.decode("utf-8", "replace"))
+            sys.stdout.flush()
+            return
+        if kind != TYPE_BAND:
+            return
+        frame = body[3] | (body[4] << 8)
+        x, y, w, rows, skipped = body[5], body[6], body[7], body[8], body[11]
+        ref = self.ref.setdefault(display, [[0] * W for _ in range(H)])
+        keyed = self.keyed.setdefault(display, set())
+        if display in self.frame and frame != self.frame[display]:
+            self.emit(display)
+        self.frame[display] = frame
+        self.bands += 1
+        self.skipped_bands += skipped
+        key = bool(flags & FLAG_KEY)
+        if key:
+            self.keys += 1
+            if x == 0 and w == W:
+                keyed.update(range(y // BAND_ROWS, (y + rows - 1) // BAND_ROWS + 1))
+        decode_rows(payload, ref, x, y, w, rows, key)
+
+    def emit(self, display):
+        if len(self.keyed[display]) < H // BAND_ROWS:
+            return
+        path = os.path.join(self.out, f"d{display}_{self.written:05d}.{self.ext}")
+        self.write(path, self.ref[display])
+        self.written += 1
+
+    def finish(self):
+        for display in self.frame:
+            self.emit(display)
+        print(f"\n{self.written} frames, {self.bands} bands ({self.keys} key), "
+              f"{self.skipped_bands} bands skipped on the device, {self.crc_errors} CRC errors", file=sys.stderr)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--port", help="serial device on the stdio UART")
+    src.add_argument("--file", help="raw stream recorded earlier")
+    ap.add_argument("--baud", type=int, default=921600, help="PME_CAPTURE_BAUD (default 921600)")
+    ap.add_argument("--out", default="capture", help="directory for the frames")
+    ap.add_argument("--format", choices=("png", "raw"), default="png",
+                    help="png, or raw little-endian RGB565 (128x128)")
+    ap.add_argument("--save", help="also record the raw stream to this file (with --port)")
+    args = ap.parse_args()
+
+    os.makedirs(args.out, exist_ok=True)
+    dec = Decoder(args.out, args.format)
+    if args.file:
+        with open(args.file, "rb") as f:
+            dec.feed(f.read())
+        dec.finish()
+        return
+    fd = open_port(args.port, args.baud)
+    save = open(args.save, "wb") if args.save else None
+    try:
+        while True:
+            data = os.read(fd, 4096)
+            if not data:
+                break
+            if save:
+                save.write(data)
+            dec.feed(data)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if save:
+            save.close()
+        dec.finish()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,133 @@
+// Host test of the control-channel parser (src/command_protocol.hpp): every command type decodes
+// from a frame fed byte by byte, with the stamp of its last byte; a bad CRC, a wrong payload length
+// for the type and an unknown type are each counted once and dropped; the parser resyncs after
+// garbage (including stray and doubled sync bytes) and after each bad frame, so the next good frame
+// still decodes.
+//
+//     g++ -std=c++17 -O2 -Isrc -o command_test tools/command_test.cpp src/command_protocol.cpp
+//     ./command_test
+#include "command_protocol.hpp"
+
+#include <cstdio>
+#include <initializer_list>
+#include <vector>
+
+using namespace eyes;
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool cond, const char *what) {
+    std::printf("  %-64s %s\n", what, cond ? "ok" : "FAILED");
+    g_ok = g_ok && cond;
+}
+
+using Bytes = std::vector<uint8_t>;
+
+// A frame as tools/pme_control.py encodes it
+Bytes frame(uint8_t type, std::initializer_list<uint8_t> payload) {
+    Bytes f{CommandParser::kSync0, CommandParser::kSync1, type, (uint8_t)payload.size()};
+    for (uint8_t b : payload) f.push_back(b);
+    uint8_t crc = 0;
+    for (size_t i = 2; i < f.size(); ++i) crc = CommandParser::crc8(crc, f[i]);
+    f.push_back(crc);
+    return f;
+}
+
+Bytes cat(std::initializer_list<Bytes> parts) {
+    Bytes out;
+    for (const Bytes &p : parts) out.insert(out.end(), p.begin(), p.end());
+    return out;
+}
+
+// Feeds bytes (byte i stamped 1000 + i); returns the commands decoded
+std::vector<Command> feed(CommandParser &p, const Bytes &bytes) {
+    std::vector<Command> out;
+    Command c;
+    for (size_t i = 0; i < bytes.size(); ++i)
+        if (p.feed(bytes[i], 1000 + (uint32_t)i, c)) out.push_back(c);
+    return out;
+}
+
+void test_decode() {
+    std::printf("decode:\n");
+    CommandParser p;
+    // x = 12 px, y = -4 px (1/16 px), 300 mm
+    const Bytes look = frame(0x01, {0xC0, 0x00, 0xC0, 0xFF, 0x2C, 0x01});
+    std::vector<Command> c = feed(p, look);
+    check(c.size() == 1 && c[0].type == CommandType::LookAt && c[0].i16(0) == 192 && c[0].i16(2) == -64 &&
+              c[0].u16(4) == 300, "look at: signed and unsigned little-endian fields");
+    check(c.size() == 1 && c[0].received_us == 1000 + look.size() - 1, "stamp is the last byte's");
+    c = feed(p, cat({frame(0x02, {}), frame(0x03, {2}), frame(0x04, {}), frame(0x05, {7, 128}), frame(0x06, {1}),
+                     frame(0x07, {0x00, 0xF8, 204, 15})}));
+    const CommandType want[] = {CommandType::ReleaseLook, CommandType::Emotion, CommandType::Blink,
+                                CommandType::AudioCue, CommandType::Style, CommandType::Glow};
+    bool types = c.size() == 6;
+    for (size_t i = 0; types && i < 6; ++i) types = c[i].type == want[i];
+    check(types && c[1].payload[0] == 2 && c[3].payload[1] == 128 && c[5].u16(0) == 0xF800 && c[5].payload[3] == 15,
+          "back-to-back frames of every other type");
+    check(p.errors() == 0, "no errors on good frames");
+}
+
+void test_errors() {
+    std::printf("errors:\n");
+    CommandParser p;
+    Bytes bad_crc = frame(0x03, {1});
+    bad_crc.back() ^= 0x01;
+    std::vector<Command> c = feed(p, cat({bad_crc, frame(0x04, {})}));
+    check(p.errors() == 1 && c.size() == 1 && c[0].type == CommandType::Blink, "bad CRC dropped, next frame decodes");
+    Bytes bad_payload = frame(0x03, {1});
+    bad_payload[4] ^= 0x02; // payload byte flipped after the CRC was taken
+    c = feed(p, cat({bad_payload, frame(0x04, {})}));
+    check(p.errors() == 2 && c.size() == 1, "corrupted payload fails the CRC");
+
+    const Bytes bad_lens[] = {frame(0x01, {1, 2, 3, 4}), frame(0x02, {0}), frame(0x05, {1}),
+                              frame(0x07, {1, 2, 3, 4, 5})};
+    uint32_t before = p.errors();
+    bool dropped = true;
+    for (const Bytes &f : bad_lens) dropped = dropped && feed(p, cat({f, frame(0x04, {})})).size() == 1;
+    check(dropped && p.errors() == before + 4, "wrong payload length for the type: dropped, counted, resync");
+    before = p.errors();
+    c = feed(p, cat({frame(0x42, {}), frame(0x06, {3})}));
+    check(p.errors() == before + 1 && c.size() == 1 && c[0].type == CommandType::Style, "unknown type dropped");
+    // An oversize length must not run past the payload buffer
+    before = p.errors();
+    c = feed(p, cat({Bytes{CommandParser::kSync0, CommandParser::kSync1, 0x01, 200}, Bytes(40, 0x11), frame(0x04, {})}));
+    check(p.errors() == before + 1 && c.size() == 1, "oversize length rejected before its payload");
+}
+
+void test_resync() {
+    std::printf("resync:\n");
+    CommandParser p;
+    const Bytes garbage{0x00, 0xFF, 0x5A, 0xA5, 0x00, 0x5A, 0x13, 0x37};
+    std::vector<Command> c = feed(p, cat({garbage, frame(0x04, {})}));
+    check(c.size() == 1 && c[0].type == CommandType::Blink, "frame after garbage with stray sync bytes");
+    c = feed(p, cat({Bytes{0xA5, 0xA5, 0xA5}, frame(0x03, {4})}));
+    check(c.size() == 1 && c[0].payload[0] == 4, "repeated first sync byte before a frame");
+    // A frame cut short by a new one: the fragment's bytes are read as its payload and CRC, fail, and
+    // the parser is back in sync for the frame after
+    const Bytes cut = frame(0x05, {9, 9});
+    c = feed(p, cat({Bytes(cut.begin(), cut.begin() + 5), frame(0x04, {}), frame(0x06, {2})}));
+    check(c.size() == 1 && c[0].type == CommandType::Style, "truncated frame costs at most the next frame");
+    // Split at every position: the same command whatever the chunking
+    const Bytes look = frame(0x01, {1, 0, 2, 0, 3, 0});
+    bool split_ok = true;
+    for (size_t cut_at = 1; cut_at < look.size(); ++cut_at) {
+        CommandParser q;
+        std::vector<Command> a = feed(q, Bytes(look.begin(), look.begin() + cut_at));
+        std::vector<Command> b = feed(q, Bytes(look.begin() + cut_at, look.end()));
+        split_ok = split_ok && a.empty() && b.size() == 1 && b[0].u16(4) == 3;
+    }
+    check(split_ok, "frame split at every byte decodes once");
+}
+
+} // namespace
+
+int main() {
+    test_decode();
+    test_errors();
+    test_resync();
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
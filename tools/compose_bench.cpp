@@ -0,0 +1,85 @@
+// Host benchmark of compose_eye with the App's eye parameters (anti-aliased, sclera parallax on):
+// flat against spherical compose per eye, whole-pixel and sub-pixel placed, over a sweep of gaze
+// positions. Each variant is also checked to draw every pixel of the frame.
+//
+//     g++ -std=c++17 -O2 -Iinclude -Isrc -Iboards -Iassets/graphics -o compose_bench tools/compose_bench.cpp
+//         src/eye_renderer.cpp assets/graphics/default_eye.cpp
+//     ./compose_bench
+#include "eye_renderer.hpp"
+#include "pico2_panel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+using namespace eyes;
+
+namespace {
+
+using Panel = ActivePanel;
+constexpr int kRuns = 1000;
+bool g_ok = true;
+volatile uint32_t g_sink;
+
+void check(bool cond, const char *what) {
+    std::printf("  %-64s %s\n", what, cond ? "ok" : "FAILED");
+    g_ok = g_ok && cond;
+}
+
+template <class F>
+double us_per(F f) {
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kRuns; ++i) f(i);
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / kRuns;
+        if (us < best) best = us;
+    }
+    return best;
+}
+
+// Gaze sweep; sub-pixel runs cycle through the non-zero phases on both axes
+void place(EyeRenderParams &p, int i, bool sub) {
+    p.iris_center_x = Panel::kWidth / 2 + (i % 17) - 8;
+    p.iris_center_y = Panel::kHeight / 2 + (i % 11) - 5;
+    p.iris_phase_x = (uint8_t)(sub ? 1 + i % (kSubpixelPhases - 1) : 0);
+    p.iris_phase_y = (uint8_t)(sub ? 1 + (i / 3) % (kSubpixelPhases - 1) : 0);
+}
+
+uint16_t g_frame[Panel::kPixels], g_other[Panel::kPixels];
+
+} // namespace
+
+int main() {
+    EyeRenderParams p;
+    p.iris_radius = kDefaultIrisRadius<Panel>;
+    p.antialias = true;
+    p.sclera_parallax = 1.f;
+    const IrisSprite<Panel> &sprite = render_iris_sprite<Panel>(p);
+
+    std::printf("compose per eye (us, best of 5 x %d):\n", kRuns);
+    char what[96];
+    for (bool spherical : {false, true}) {
+        p.spherical = spherical;
+        double us[2];
+        for (int sub = 0; sub < 2; ++sub) {
+            us[sub] = us_per([&](int i) {
+                place(p, i, sub);
+                compose_eye<Panel>(g_frame, sprite, p);
+                g_sink = g_frame[i & 255];
+            });
+            // The same frame from two different starting contents
+            place(p, 7, sub);
+            std::fill(g_frame, g_frame + Panel::kPixels, 0x0000);
+            std::fill(g_other, g_other + Panel::kPixels, 0xFFFF);
+            compose_eye<Panel>(g_frame, sprite, p);
+            compose_eye<Panel>(g_other, sprite, p);
+            std::snprintf(what, sizeof what, "%s%s compose draws every pixel", spherical ? "spherical" : "flat",
+                          sub ? " sub-pixel" : "");
+            check(std::equal(g_frame, g_frame + Panel::kPixels, g_other), what);
+        }
+        std::printf("  %-9s %7.2f whole-pixel %7.2f sub-pixel\n", spherical ? "spherical" : "flat", us[0], us[1]);
+    }
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
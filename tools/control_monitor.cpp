@@ -0,0 +1,112 @@
+// Host end of the live control channel (docs/control.md): reads a serial device or pseudo-terminal,
+// feeds every byte to the firmware's CommandParser and prints each decoded command, with the
+// parser's error count whenever it grows. Without a path it creates a pty and prints its name, so
+// tools/pme_control.py can drive it like the board:
+//
+//     g++ -std=c++17 -O2 -Isrc -o control_monitor tools/control_monitor.cpp src/command_protocol.cpp
+//     ./control_monitor                       # prints "control pty: /dev/pts/N"
+//     python3 tools/pme_control.py --port /dev/pts/N look 12 -4 300
+//
+//     python3 tools/pme_control.py --pty      # the other way round: pme_control makes the pty
+//     ./control_monitor /dev/pts/N
+//
+// -n COUNT exits after COUNT commands (for scripts); otherwise it runs until the writer hangs up.
+#include "command_protocol.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace eyes;
+
+namespace {
+
+constexpr const char *kEmotions[] = {"neutral", "sad", "fear", "anger", "disgust"};
+
+uint32_t now_us() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool make_raw(int fd) {
+    termios t;
+    if (tcgetattr(fd, &t) != 0) return false;
+    cfmakeraw(&t);
+    return tcsetattr(fd, TCSANOW, &t) == 0;
+}
+
+void print(const Command &c) {
+    const uint8_t *p = c.payload;
+    switch (c.type) {
+        case CommandType::LookAt:
+            std::printf("look x %.2f y %.2f px, distance %u mm\n", c.i16(0) / 16.0, c.i16(2) / 16.0, c.u16(4));
+            break;
+        case CommandType::ReleaseLook: std::printf("release look\n"); break;
+        case CommandType::Emotion:
+            std::printf("emotion %s\n", p[0] < sizeof kEmotions / sizeof kEmotions[0] ? kEmotions[p[0]] : "(out of range)");
+            break;
+        case CommandType::Blink: std::printf("blink\n"); break;
+        case CommandType::AudioCue: std::printf("cue clip %u gain %.2f\n", p[0], p[1] / 255.0); break;
+        case CommandType::Style: std::printf("style %u\n", p[0]); break;
+        case CommandType::Glow:
+            std::printf("glow colour 0x%04X strength %.2f pulse %.1f Hz\n", c.u16(0), p[2] / 255.0, p[3] * 0.1);
+            break;
+    }
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    long limit = -1;
+    const char *path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-n") && i + 1 < argc) limit = std::atol(argv[++i]);
+        else path = argv[i];
+    }
+
+    int fd, slave = -1;
+    if (path) {
+        fd = open(path, O_RDONLY | O_NOCTTY);
+        if (fd < 0) { std::perror(path); return 1; }
+        if (isatty(fd)) make_raw(fd);
+    } else {
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) { std::perror("pty"); return 1; }
+        // Hold the slave open (raw, so no byte is translated) so writers may come and go
+        slave = open(ptsname(fd), O_RDWR | O_NOCTTY);
+        if (slave < 0 || !make_raw(slave)) { std::perror(ptsname(fd)); return 1; }
+        std::fprintf(stderr, "control pty: %s\n", ptsname(fd));
+    }
+
+    CommandParser parser;
+    Command cmd;
+    uint32_t errors = 0;
+    long count = 0;
+    uint8_t buf[256];
+    while (limit < 0 || count < limit) {
+        const ssize_t n = read(fd, buf, sizeof buf);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break; // EOF, or EIO once the pty's other end has closed
+        const uint32_t stamp = now_us();
+        for (ssize_t i = 0; i < n; ++i) {
+            if (parser.feed(buf[i], stamp, cmd)) {
+                print(cmd);
+                ++count;
+            }
+        }
+        if (parser.errors() != errors) {
+            errors = parser.errors();
+            std::printf("parse errors: %lu\n", (unsigned long)errors);
+            std::fflush(stdout);
+        }
+    }
+    if (slave >= 0) close(slave);
+    close(fd);
+    return 0;
+}
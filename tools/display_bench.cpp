@@ -0,0 +1,197 @@
+// Host benchmark of the SSD1351 driver on the host HAL (hal/hal_host.hpp): both panels of the board
+// on one modelled SPI bus, each with a software SSD1351 (hal/ssd1351_emulator.hpp) behind its CS pin.
+// Boots them as App::init does, then times every blit path of Ssd1351Display in bus time (with the
+// share that is not pixels: window commands and frame-size switches) and checks after each one that
+// the emulated RAM holds exactly what was blitted and nothing outside the window changed. Exits
+// non-zero on any mismatch, bus hazard, or RAM write that did not fill its window.
+//
+//     g++ -std=c++17 -O2 -DPME_HOST_BUILD=1 -DPME_DMA_IN_SCRATCH=0 -I. -Iinclude -Idrivers -Isrc -Iboards
+//         -Ihal -o display_bench tools/display_bench.cpp drivers/ssd1351_display.cpp src/color_pipeline.cpp
+//         hal/hal_host.cpp hal/ssd1351_emulator.cpp
+//     ./display_bench [left.ppm]
+#include "color_pipeline.hpp"
+#include "hal.hpp"
+#include "pico2_panel.hpp"
+#include "pico2_pins.hpp"
+#include "ssd1351_display.hpp"
+#include "ssd1351_emulator.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace eyes;
+using hal::HostBus;
+
+namespace {
+
+using Oled = Ssd1351Display<ActivePanel>;
+constexpr int W = ActivePanel::kWidth;
+constexpr int H = ActivePanel::kHeight;
+constexpr int kFrames = 20;
+
+uint16_t g_frame[H][W];
+uint16_t g_shadow[Ssd1351Emulator::kSize][Ssd1351Emulator::kSize]; // what the left panel should hold
+bool g_ok = true;
+
+void pattern(int seed) {
+    for (int y = 0; y < H; ++y)
+        for (int x = 0; x < W; ++x)
+            g_frame[y][x] = (uint16_t)(((x + seed) & 31) << 11 | ((y * 2 + seed) & 63) << 5 | ((x ^ y) & 31));
+}
+
+void expect(const Rect& area, const uint16_t* src, int stride) {
+    for (int y = 0; y < area.h; ++y)
+        std::memcpy(&g_shadow[area.y + y][area.x], src + (size_t)y * stride, area.w * sizeof(uint16_t));
+}
+
+bool panel_matches(const Ssd1351Emulator& panel) {
+    return panel.matches(&g_shadow[0][0], Rect{0, 0, Ssd1351Emulator::kSize, Ssd1351Emulator::kSize});
+}
+
+// Run one blit path kFrames times on the left panel and report it
+template <class Blit>
+void measure(const char* label, Ssd1351Emulator& panel, const Rect& area, Blit blit) {
+    HostBus& bus = HostBus::get();
+    bus.reset_stats();
+    panel.reset_stats();
+    panel.clear_dirty();
+    bool ok = true;
+    for (int f = 0; f < kFrames; ++f) {
+        pattern(f);
+        blit();
+        ok = ok && panel_matches(panel);
+    }
+    const HostBus::Stats& st = bus.stats();
+    const Rect d = panel.dirty();
+    ok = ok && st.hazards == 0 && panel.stats().short_writes == 0 &&
+         d.x == area.x && d.y == area.y && d.w == area.w && d.h == area.h;
+    const double bus_us = st.busy_ns * 1e-3 / kFrames;
+    const double pixel_us = area.w * area.h * 16 * 1e6 / bus.spi(0)->hz;
+    std::printf("%-22s %3ux%-3u bus %8.1f us (%5.1f not pixels)  %6llu bytes  %4u writes %4u DMA  %s\n", label,
+                area.w, area.h, bus_us, bus_us - pixel_us, (unsigned long long)(st.bytes / kFrames),
+                st.writes / kFrames, st.dma_transfers / kFrames, ok ? "ok" : "MISMATCH");
+    g_ok = g_ok && ok;
+}
+
+// The (CS, D/C)-tagged stream of one small blit, as the bus recorded it
+void show_trace(Oled& oled) {
+    HostBus& bus = HostBus::get();
+    bus.clear_record();
+    bus.set_recording(true);
+    const Rect area{60, 60, 4, 2};
+    oled.blit(&g_frame[0][0], area);
+    bus.set_recording(false);
+    expect(area, &g_frame[0][0], area.w);
+    std::printf("trace of a %ux%u blit at (%u,%u):\n", area.w, area.h, area.x, area.y);
+    for (const HostBus::Segment& s : bus.segments()) {
+        std::printf("  +%6.2f us  cs %2u %s %2u-bit:", (s.t_ns - bus.segments()[0].t_ns) * 1e-3, s.cs,
+                    s.dc ? "data" : "cmd ", s.frame_bits);
+        for (uint32_t i = 0; i < s.len && i < 16; ++i) std::printf(" %02X", bus.bytes()[s.offset + i]);
+        std::printf("%s\n", s.len > 16 ? " ..." : "");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    HostBus& bus = HostBus::get();
+    bus.reset();
+    static Ssd1351Emulator left_panel, right_panel;
+    bus.attach(0, &left_panel, pins::left_cs, pins::left_dc, pins::left_res);
+    bus.attach(0, &right_panel, pins::right_cs, pins::right_dc, pins::right_res);
+
+    // As App::init: 16 MHz, then raised to 30 MHz (the divider decides what that becomes)
+    SpiBus spi(bus.spi(0), 16 * 1000 * 1000);
+    spi.init();
+    spi.set_frequency(30 * 1000 * 1000);
+    std::printf("spi0: asked 30 MHz, clk_peri %lu Hz gives %lu Hz\n", (unsigned long)bus.clk_peri(),
+                (unsigned long)spi.frequency());
+    Oled left(spi, pins::left_cs, pins::left_dc, pins::left_res);
+    Oled right(spi, pins::right_cs, pins::right_dc, pins::right_res);
+    left.begin_reset();
+    right.begin_reset();
+    hal::sleep_ms(Oled::kResetPulseMs);
+    left.end_reset();
+    right.end_reset();
+    hal::sleep_ms(Oled::kResetPulseMs);
+    const uint64_t cfg0 = bus.now_ns();
+    bus.reset_stats();
+    if (!left.configure() || !right.configure()) return 1;
+    for (Ssd1351Emulator* p : {&left_panel, &right_panel}) {
+        const Ssd1351Emulator::Stats& s = p->stats();
+        const bool ok = p->display_on() && p->mux_ratio() == H - 1 && s.unknown == 0 && s.ignored == 0;
+        std::printf("configure: display %s, remap %02X, mux %u, %u commands, %u stray data bytes, %u ignored %s\n",
+                    p->display_on() ? "on" : "off", p->remap(), p->mux_ratio() + 1, s.commands, s.stray_data, s.ignored,
+                    ok ? "ok" : "MISMATCH");
+        g_ok = g_ok && ok;
+    }
+    std::printf("configure: both panels %.1f us on the bus\n\n", (bus.now_ns() - cfg0) * 1e-3);
+
+    const Rect full{0, 0, W, H};
+    measure("fill", left_panel, full, [&] {
+        left.fill(0x1234);
+        for (auto& row : g_shadow) for (uint16_t& p : row) p = 0x1234;
+    });
+    measure("blit (DMA)", left_panel, full, [&] {
+        left.blit(&g_frame[0][0], full);
+        expect(full, &g_frame[0][0], W);
+    });
+    // Rows alternating between the framebuffer and a second buffer: one DMA transfer per row
+    static uint16_t other[H][W];
+    measure("blit_rows (scattered)", left_panel, full, [&] {
+        const uint16_t* rows[H];
+        for (int y = 0; y < H; ++y) {
+            if (y & 1) std::memcpy(other[y], g_frame[y], sizeof other[y]);
+            rows[y] = y & 1 ? other[y] : g_frame[y];
+        }
+        left.blit_rows(rows, full);
+        expect(full, &g_frame[0][0], W);
+    });
+    ColorPipeline dim;
+    ColorParams cp;
+    cp.brightness = 160;
+    dim.set(cp);
+    measure("blit (color stage)", left_panel, full, [&] {
+        left.set_color_pipeline(&dim);
+        left.blit(&g_frame[0][0], full);
+        left.set_color_pipeline(nullptr);
+        static uint16_t converted[H][W];
+        dim.convert(&g_frame[0][0], &converted[0][0], (size_t)W * H);
+        expect(full, &converted[0][0], W);
+    });
+    measure("blit (no DMA)", left_panel, full, [&] {
+        left.enable_dma(false);
+        left.blit(&g_frame[0][0], full);
+        left.enable_dma(true);
+        expect(full, &g_frame[0][0], W);
+    });
+    // A partial window: only it may change on the panel
+    const Rect part{40, 50, 48, 32};
+    measure("blit (partial window)", left_panel, part, [&] {
+        left.blit(&g_frame[0][0], part);
+        expect(part, &g_frame[0][0], part.w);
+    });
+    const Rect row{0, 77, W, 1};
+    measure("blit (one row)", left_panel, row, [&] {
+        left.blit(&g_frame[0][0], row);
+        expect(row, &g_frame[0][0], W);
+    });
+    // Both panels per frame, as the render loop presents them
+    bus.reset_stats();
+    for (int f = 0; f < kFrames; ++f) {
+        pattern(f);
+        left.blit(&g_frame[0][0], full);
+        right.blit(&g_frame[0][0], full);
+    }
+    expect(full, &g_frame[0][0], W);
+    const bool both_ok = panel_matches(left_panel) && right_panel.matches(&g_frame[0][0], full) && bus.stats().hazards == 0;
+    std::printf("%-22s %3ux%-3u bus %8.1f us (%.1f fps bus limit)  %s\n\n", "both panels", W, H,
+                bus.stats().busy_ns * 1e-3 / kFrames, 1e9 * kFrames / bus.stats().busy_ns, both_ok ? "ok" : "MISMATCH");
+    g_ok = g_ok && both_ok;
+
+    show_trace(left);
+    g_ok = g_ok && panel_matches(left_panel);
+    if (argc > 1 && !left_panel.write_ppm(argv[1])) std::perror(argv[1]);
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
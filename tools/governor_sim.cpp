@@ -0,0 +1,100 @@
+// Host simulation of the frame-budget QualityGovernor: frame times from a cost model of the render
+// loop (a base load per scene plus the share each quality tier saves) with per-frame jitter and
+// occasional one-off spikes. Each case runs once at fixed full quality and once governed, and
+// prints overruns, tier changes and frames per tier. Checks that the governor cuts overruns under
+// sustained load to a tenth, never leaves full quality on light load or for a lone spike, settles
+// on one tier when the load sits just over budget, and gives the quality back once the load is gone.
+//
+//     g++ -std=c++17 -O2 -Isrc -o governor_sim tools/governor_sim.cpp src/quality_governor.cpp
+//     ./governor_sim
+#include "quality_governor.hpp"
+
+#include <cstdio>
+
+using namespace eyes;
+
+namespace {
+
+constexpr int kTiers = (int)QualityTier::COUNT;
+
+// Share of the frame a tier (and every tier before it) leaves, from the perf sections of a
+// two-panel frame: the reduced region saves blit rows under the lids, the cached iris the sprite,
+// the secondary glint a little compose, half-rate lids every other eyelid pass
+constexpr float kTierCost[kTiers] = {1.00f, 0.86f, 0.74f, 0.71f, 0.64f};
+
+struct Phase {
+    int frames;
+    uint32_t full_us;   // frame time at full quality
+};
+
+struct Case {
+    const char* name;
+    Phase phases[4];
+    int spike_every;    // one frame in this many takes 3x (0 = none)
+    uint32_t max_changes;
+    bool ends_full;     // the load is light again at the end
+};
+
+struct Result {
+    uint32_t overruns = 0;
+    uint32_t changes = 0;
+    uint32_t frames_at[kTiers]{};
+    QualityTier final_tier = QualityTier::Full;
+};
+
+uint32_t g_rng = 12345;
+uint32_t rnd() { g_rng = g_rng * 1664525u + 1013904223u; return g_rng >> 8; }
+
+Result run(const Case& c, bool governed) {
+    g_rng = 12345;
+    QualityGovernor gov;
+    Result r;
+    int frame = 0;
+    for (const Phase& ph : c.phases) {
+        for (int f = 0; f < ph.frames; ++f, ++frame) {
+            const QualityTier tier = governed ? gov.tier() : QualityTier::Full;
+            float us = ph.full_us * kTierCost[(int)tier];
+            us *= 0.94f + (rnd() % 1200) * 0.0001f;    // +-6% jitter
+            if (c.spike_every && frame % c.spike_every == c.spike_every - 1) us *= 3.f;
+            const uint32_t frame_us = (uint32_t)us;
+            if (frame_us > gov.config().period_us) ++r.overruns;
+            ++r.frames_at[(int)tier];
+            if (governed && gov.update(frame_us)) ++r.changes;
+        }
+    }
+    r.final_tier = gov.tier();
+    return r;
+}
+
+void print(const char* label, const Result& r) {
+    std::printf("  %-9s %5u overruns %3u changes  frames per tier", label, r.overruns, r.changes);
+    for (uint32_t n : r.frames_at) std::printf(" %5u", n);
+    std::printf("  ends %s\n", quality_tier_name(r.final_tier));
+}
+
+} // namespace
+
+int main() {
+    // 50 fps: 500 frames = 10 s
+    const Case cases[] = {
+        {"light load", {{3000, 11000}}, 0, 0, true},
+        {"light load, a spike every 4 s", {{3000, 11000}}, 200, 0, true},
+        {"style fade and tint for 10 s", {{500, 12000}, {500, 23000}, {3000, 12000}}, 0, 6, true},
+        {"sustained overload", {{3000, 26000}}, 0, 4, false},
+        {"just over budget", {{3000, 18500}}, 0, 1, false},
+        {"overload that comes and goes", {{400, 24000}, {300, 12000}, {400, 24000}, {2000, 12000}}, 0, 12, true},
+    };
+    bool ok = true;
+    for (const Case& c : cases) {
+        const Result fixed = run(c, false), gov = run(c, true);
+        std::printf("%s\n", c.name);
+        print("full", fixed);
+        print("governed", gov);
+        const bool pass = gov.overruns <= fixed.overruns && (fixed.overruns < 100 || gov.overruns * 10 <= fixed.overruns) &&
+                          gov.changes <= c.max_changes && (gov.final_tier == QualityTier::Full) == c.ends_full;
+        std::printf("  %s\n\n", pass ? "ok" : "FAILED");
+        ok = ok && pass;
+    }
+    std::printf("%s\n", ok ? "all ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+// Host check of the pixel kernels (src/pixel_kernels.hpp) against plain per-pixel reference code:
+// swap16x2, reverse4 and le_mask4 for every byte value in every lane (le_mask4 at every cutoff),
+// swap_bytes, fill and expand_indexed at every length up to 35 and every start alignment (in place
+// for swap_bytes, neighbours untouched), and avg565x2, quarter_lerp565x2 and blend565 per channel
+// over every channel extreme and a long pseudo-random sweep. Build it twice, so both selections are
+// covered: as is, which picks the DSP kernels when the compiler targets an Arm core with the SIMD32
+// extension (e.g. arm-linux-gnueabihf-g++ -static, run on a Pi or under qemu-arm), and with
+// -DPME_PORTABLE_KERNELS, which forces the plain C++ kernels the firmware falls back to.
+//
+//     g++ -std=c++17 -O2 -Isrc -o kernel_test tools/kernel_test.cpp && ./kernel_test
+//     g++ -std=c++17 -O2 -Isrc -DPME_PORTABLE_KERNELS -o kernel_test_portable tools/kernel_test.cpp && ./kernel_test_portable
+#include "pixel_kernels.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace eyes;
+
+namespace {
+
+bool g_ok = true;
+uint32_t g_seed = 12345;
+
+void check(bool cond, const char *what) {
+    std::printf("  %-64s %s\n", what, cond ? "ok" : "FAILED");
+    g_ok = g_ok && cond;
+}
+
+uint32_t rnd() { return g_seed = g_seed * 1664525u + 1013904223u; }
+
+// Four bytes of a test word from one swept value b: every lane sees every value as b runs 0..255
+uint32_t lanes(uint32_t b) { return b | (b ^ 0x5Au) << 8 | (255u - b) << 16 | ((b * 7u) & 0xFFu) << 24; }
+
+// --- reference kernels, one pixel or byte at a time ---
+
+uint32_t ref_swap16x2(uint32_t w) { return (uint32_t)px::swap16((uint16_t)w) | (uint32_t)px::swap16((uint16_t)(w >> 16)) << 16; }
+
+uint32_t ref_reverse4(uint32_t w) {
+    uint32_t r = 0;
+    for (int i = 0; i < 4; ++i) r |= ((w >> (8 * i)) & 0xFFu) << (8 * (3 - i));
+    return r;
+}
+
+uint32_t ref_le_mask4(uint32_t bytes, uint32_t cutoff) {
+    uint32_t m = 0;
+    for (int i = 0; i < 4; ++i)
+        if (((bytes >> (8 * i)) & 0xFFu) <= cutoff) m |= 0xFFu << (8 * i);
+    return m;
+}
+
+struct Rgb { int r, g, b; };
+Rgb split(uint16_t v) { return {v >> 11, (v >> 5) & 63, v & 31}; }
+uint16_t join(Rgb c) { return (uint16_t)(c.r << 11 | c.g << 5 | c.b); }
+
+// Per channel, rounded down
+uint16_t ref_avg(uint16_t a, uint16_t b) {
+    const Rgb x = split(a), y = split(b);
+    return join({(x.r + y.r) >> 1, (x.g + y.g) >> 1, (x.b + y.b) >> 1});
+}
+
+uint16_t ref_quarter(uint16_t a, uint16_t b, unsigned phase) {
+    const uint16_t m = ref_avg(a, b);
+    return phase == 2 ? m : ref_avg(phase == 1 ? a : b, m);
+}
+
+// a + (b - a) * alpha / 32 per channel, the quotient rounded toward minus infinity
+int lerp(int a, int b, int alpha) {
+    const int d = (b - a) * alpha;
+    return a + (d >= 0 ? d / 32 : -((-d + 31) / 32));
+}
+uint16_t ref_blend(uint16_t a, uint16_t b, int alpha) {
+    const Rgb x = split(a), y = split(b);
+    return join({lerp(x.r, y.r, alpha), lerp(x.g, y.g, alpha), lerp(x.b, y.b, alpha)});
+}
+
+// Both pixels of a word through a per-pixel reference
+template <class F>
+uint32_t per_pixel(uint32_t a, uint32_t b, F f) {
+    return (uint32_t)f((uint16_t)a, (uint16_t)b) | (uint32_t)f((uint16_t)(a >> 16), (uint16_t)(b >> 16)) << 16;
+}
+
+// Channel extremes and their neighbours, every combination
+constexpr uint16_t kEdges[] = {0x0000, 0x0821, 0x7BEF, 0x8410, 0xF7DE, 0xFFFF, 0xF800, 0x07E0, 0x001F, 0x07FF, 0xF81F, 0xFFE0};
+constexpr int kRandomPairs = 1 << 20;
+
+void byte_kernels() {
+    bool swap_ok = true, rev_ok = true, mask_ok = true;
+    for (uint32_t b = 0; b < 256; ++b) {
+        const uint32_t w = lanes(b);
+        swap_ok = swap_ok && px::swap16x2(w) == ref_swap16x2(w);
+        rev_ok = rev_ok && px::reverse4(w) == ref_reverse4(w);
+        for (uint32_t cut = 0; cut < 256; ++cut) mask_ok = mask_ok && px::le_mask4(w, cut) == ref_le_mask4(w, cut);
+    }
+    check(swap_ok, "swap16x2, every byte value in every lane");
+    check(rev_ok, "reverse4, every byte value in every lane");
+    check(mask_ok, "le_mask4, every byte value in every lane at every cutoff");
+}
+
+void row_kernels() {
+    constexpr int kMaxN = 35, kGuard = 4;
+    constexpr uint16_t kFill = 0xA55A, kMark = 0x1234;
+    uint16_t src[kMaxN + 2 * kGuard], dst[kMaxN + 2 * kGuard], want[kMaxN + 2 * kGuard];
+    uint8_t idx[kMaxN + 2 * kGuard];
+    uint16_t palette[256];
+    for (int i = 0; i < 256; ++i) palette[i] = (uint16_t)rnd();
+    bool swap_ok = true, inplace_ok = true, fill_ok = true, expand_ok = true;
+    for (int n = 0; n <= kMaxN; ++n) {
+        for (int off = 0; off < 2; ++off) {
+            // off = 1 starts on an odd halfword, so the word accesses straddle words
+            uint16_t *d = dst + kGuard + off;
+            for (uint16_t &v : src) v = (uint16_t)rnd();
+            for (uint8_t &v : idx) v = (uint8_t)rnd();
+            const uint16_t *s = src + kGuard + off;
+
+            for (uint16_t &v : dst) v = kMark;
+            std::memcpy(want, dst, sizeof dst);
+            for (int i = 0; i < n; ++i) want[kGuard + off + i] = px::swap16(s[i]);
+            px::swap_bytes(d, s, (size_t)n);
+            swap_ok = swap_ok && !std::memcmp(dst, want, sizeof dst);
+
+            std::memcpy(dst, src, sizeof dst);
+            std::memcpy(want, src, sizeof src);
+            for (int i = 0; i < n; ++i) want[kGuard + off + i] = px::swap16(src[kGuard + off + i]);
+            px::swap_bytes(d, d, (size_t)n);
+            inplace_ok = inplace_ok && !std::memcmp(dst, want, sizeof dst);
+
+            for (uint16_t &v : dst) v = kMark;
+            std::memcpy(want, dst, sizeof dst);
+            for (int i = 0; i < n; ++i) want[kGuard + off + i] = kFill;
+            px::fill(d, kFill, (size_t)n);
+            fill_ok = fill_ok && !std::memcmp(dst, want, sizeof dst);
+
+            for (int ioff = 0; ioff < 4; ++ioff) {
+                for (uint16_t &v : dst) v = kMark;
+                std::memcpy(want, dst, sizeof dst);
+                for (int i = 0; i < n; ++i) want[kGuard + off + i] = palette[idx[ioff + i]];
+                px::expand_indexed(d, idx + ioff, palette, (size_t)n);
+                expand_ok = expand_ok && !std::memcmp(dst, want, sizeof dst);
+            }
+        }
+    }
+    char what[96];
+    std::snprintf(what, sizeof what, "swap_bytes, lengths 0..%d, both alignments", kMaxN);
+    check(swap_ok, what);
+    check(inplace_ok, "swap_bytes in place");
+    std::snprintf(what, sizeof what, "fill, lengths 0..%d, both alignments", kMaxN);
+    check(fill_ok, what);
+    check(expand_ok, "expand_indexed, every length and index alignment");
+}
+
+// f(a, b) checked on every edge pair and kRandomPairs random pixel pairs
+template <class F>
+bool pairs(F f) {
+    bool ok = true;
+    for (uint16_t a : kEdges)
+        for (uint16_t b : kEdges) ok = ok && f(a, b);
+    for (int i = 0; i < kRandomPairs; ++i) ok = ok && f((uint16_t)rnd(), (uint16_t)(rnd() >> 16));
+    return ok;
+}
+
+void blend_kernels() {
+    check(pairs([](uint16_t a, uint16_t b) {
+              // The other halfword carries a different pair, so bleeding between pixels shows
+              const uint32_t wa = a | (uint32_t)(uint16_t)~b << 16, wb = b | (uint32_t)a << 16;
+              return px::avg565x2(wa, wb) == per_pixel(wa, wb, ref_avg);
+          }),
+          "avg565x2, per channel mean rounded down");
+    check(pairs([](uint16_t a, uint16_t b) {
+              const uint32_t wa = a | (uint32_t)b << 16, wb = b | (uint32_t)(uint16_t)~a << 16;
+              for (unsigned phase = 1; phase <= 3; ++phase) {
+                  const uint32_t want = per_pixel(wa, wb, [phase](uint16_t x, uint16_t y) { return ref_quarter(x, y, phase); });
+                  if (px::quarter_lerp565x2(wa, wb, phase) != want) return false;
+              }
+              return true;
+          }),
+          "quarter_lerp565x2, phases 1..3");
+    check(pairs([](uint16_t a, uint16_t b) {
+              for (int alpha = 0; alpha <= 32; ++alpha)
+                  if (px::blend565(a, b, (uint32_t)alpha) != ref_blend(a, b, alpha)) return false;
+              return true;
+          }),
+          "blend565, alpha 0..32");
+}
+
+} // namespace
+
+int main() {
+    std::printf("pixel kernels (%s):\n", PME_DSP_KERNELS ? "DSP" : "portable");
+    byte_kernels();
+    row_kernels();
+    blend_kernels();
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
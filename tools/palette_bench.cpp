@@ -0,0 +1,214 @@
+// Host comparison of the palette-indexed default style (PME_INDEXED_ASSETS) with its RGB565 tables:
+// flash and texture bytes, PSNR of each map and of whole rendered eyes (flat and spherical, a sweep
+// of gaze positions), time for the iris sprite and compose in both formats, and the cost of a
+// recolour done as palette animation (256 entries) against the same recolour per sprite pixel. On
+// the host every table sits in cache; on the RP2350 texels come through the 16 KB XIP cache, where
+// the indexed maps move half the bytes. Optionally writes both eyes and a glowing one as a PPM.
+//
+//     python3 tools/palettize.py -o /tmp/defaultEye_indexed.h external/Uncanny_Eyes/uncannyEyes/graphics/defaultEye.h
+//     g++ -std=c++17 -O2 -Iinclude -Isrc -Iboards -Iassets/graphics -I/tmp -o palette_bench tools/palette_bench.cpp
+//         src/eye_renderer.cpp assets/graphics/default_eye.cpp
+//     ./palette_bench [compare.ppm]
+#include "eye_renderer.hpp"
+#include "indexed_assets.hpp"
+#include "pico2_panel.hpp"
+#include "defaultEye_indexed.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+
+using namespace eyes;
+
+namespace {
+
+using Panel = ActivePanel;
+using Sprite = IrisSprite<Panel>;
+constexpr int kPositions = 9;
+constexpr uint16_t kGlowColor = 0xF800;
+bool g_ok = true;
+volatile uint32_t g_sink;
+
+void check(bool cond, const char *what) {
+    std::printf("  %-64s %s\n", what, cond ? "ok" : "FAILED");
+    g_ok = g_ok && cond;
+}
+
+template <class F>
+double us_per(int reps, F f) {
+    double best = 1e9;
+    for (int rep = 0; rep < 5; ++rep) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < reps; ++i) f(i);
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+        if (us < best) best = us;
+    }
+    return best;
+}
+
+void channels(uint16_t v, int c[3]) {
+    c[0] = (v >> 11) << 3 | (v >> 13);
+    c[1] = ((v >> 5) & 63) << 2 | ((v >> 9) & 3);
+    c[2] = (v & 31) << 3 | ((v >> 2) & 7);
+}
+
+// PSNR of b against a (8-bit channels); infinity when identical
+double psnr(const uint16_t *a, const uint16_t *b, int n) {
+    double err = 0;
+    for (int i = 0; i < n; ++i) {
+        int x[3], y[3];
+        channels(a[i], x);
+        channels(b[i], y);
+        for (int k = 0; k < 3; ++k) err += (x[k] - y[k]) * (x[k] - y[k]);
+    }
+    return err == 0 ? INFINITY : 10 * std::log10(255. * 255. * 3 * n / err);
+}
+
+void expand(uint16_t *out, const uint8_t *idx, const uint16_t *palette, int n) {
+    for (int i = 0; i < n; ++i) out[i] = palette[idx[i]];
+}
+
+EyeRenderParams params(const EyeStyle &style, int pos, bool spherical) {
+    EyeRenderParams p;
+    p.style = &style;
+    p.iris_radius = kDefaultIrisRadius<Panel>;
+    p.spherical = spherical;
+    p.sclera_parallax = 1.f;
+    // Gaze on a 3x3 grid, 16 px apart, at a quarter-pixel phase
+    set_iris_position(p, Panel::kWidth * 0.5f + 16.f * (pos % 3 - 1) + 0.25f, Panel::kHeight * 0.5f + 16.f * (pos / 3 - 1));
+    return p;
+}
+
+// Per-pixel form of glow_palette's arithmetic, what a recolour costs without a palette
+void glow_pixels(uint16_t *px, int n, uint16_t color, uint32_t alpha) {
+    const uint32_t gr = ((color >> 11) * alpha) >> 5, gg = (((color >> 5) & 63u) * alpha) >> 5, gb = ((color & 31u) * alpha) >> 5;
+    for (int i = 0; i < n; ++i) {
+        const uint32_t c = px[i];
+        const uint32_t r = std::min<uint32_t>((c >> 11) + gr, 31u);
+        const uint32_t g = std::min<uint32_t>(((c >> 5) & 63u) + gg, 63u);
+        const uint32_t b = std::min<uint32_t>((c & 31u) + gb, 31u);
+        px[i] = (uint16_t)(r << 11 | g << 5 | b);
+    }
+}
+
+uint16_t g_rgb[Panel::kPixels], g_idx[Panel::kPixels], g_glow[Panel::kPixels];
+
+void write_ppm(const char *path) {
+    FILE *f = std::fopen(path, "wb");
+    if (!f) { std::perror(path); return; }
+    std::fprintf(f, "P6 %d %d 255\n", 3 * Panel::kWidth, Panel::kHeight);
+    for (int y = 0; y < Panel::kHeight; ++y)
+        for (const uint16_t *img : {g_rgb, g_idx, g_glow})
+            for (int x = 0; x < Panel::kWidth; ++x) {
+                int c[3];
+                channels(img[y * Panel::kWidth + x], c);
+                unsigned char rgb[3] = {(unsigned char)c[0], (unsigned char)c[1], (unsigned char)c[2]};
+                std::fwrite(rgb, 1, 3, f);
+            }
+    std::fclose(f);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const EyeStyle &rgb = styles::default_eye();
+    static constexpr IndexedAssets kIndexed{&sclera_index[0][0], sclera_palette, &iris_index[0][0], iris_palette};
+    EyeStyle idx = rgb;
+    idx.name = "default-indexed";
+    idx.sclera = nullptr;
+    idx.iris_map = nullptr;
+    idx.indexed = &kIndexed;
+
+    const int sclera_n = rgb.sclera_w * rgb.sclera_h, iris_n = rgb.iris_map_w * rgb.iris_map_h;
+    std::printf("flash: RGB565 %d bytes, indexed %d bytes (maps %d + palettes %d)\n", 2 * (sclera_n + iris_n),
+                sclera_n + iris_n + 4 * kPaletteSize, sclera_n + iris_n, 4 * kPaletteSize);
+
+    std::printf("quality (PSNR against RGB565):\n");
+    static uint16_t sclera_x[PME_SCLERA_WIDTH * PME_SCLERA_HEIGHT], iris_x[PME_IRIS_MAP_WIDTH * PME_IRIS_MAP_HEIGHT];
+    expand(sclera_x, kIndexed.sclera, kIndexed.sclera_palette, sclera_n);
+    expand(iris_x, kIndexed.iris_map, kIndexed.iris_palette, iris_n);
+    char what[96];
+    const double q_sclera = psnr(rgb.sclera, sclera_x, sclera_n), q_iris = psnr(rgb.iris_map, iris_x, iris_n);
+    std::snprintf(what, sizeof what, "sclera map %.1f dB, iris map %.1f dB", q_sclera, q_iris);
+    check(q_sclera >= 30. && q_iris >= 30., what);
+    for (bool spherical : {false, true}) {
+        double worst = INFINITY;
+        for (int pos = 0; pos < kPositions; ++pos) {
+            render_eye<Panel>(g_rgb, params(rgb, pos, spherical));
+            render_eye<Panel>(g_idx, params(idx, pos, spherical));
+            worst = std::min(worst, psnr(g_rgb, g_idx, Panel::kPixels));
+        }
+        std::snprintf(what, sizeof what, "%s eye, worst of %d gaze positions: %.1f dB", spherical ? "spherical" : "flat",
+                      kPositions, worst);
+        check(worst >= 30., what);
+    }
+
+    std::printf("time (us, best of 5):\n");
+    for (bool spherical : {false, true}) {
+        double t[2][2];
+        const EyeStyle *styles[2] = {&rgb, &idx};
+        for (int s = 0; s < 2; ++s) {
+            EyeRenderParams p = params(*styles[s], 4, spherical);
+            t[s][0] = us_per(2000, [&](int i) {
+                p.pupil_scale = 0.6f + 0.1f * (i % 9);
+                g_sink = render_iris_sprite<Panel>(p).px[i & 255];
+            });
+            const Sprite &sprite = render_iris_sprite<Panel>(p);
+            t[s][1] = us_per(2000, [&](int i) {
+                compose_eye<Panel>(g_rgb, sprite, p);
+                g_sink = g_rgb[i & 255];
+            });
+        }
+        std::printf("  %-9s iris sprite %6.2f RGB565 %6.2f indexed, compose %6.2f RGB565 %6.2f indexed\n",
+                    spherical ? "spherical" : "flat", t[0][0], t[1][0], t[0][1], t[1][1]);
+    }
+
+    std::printf("recolour (iris glow toward 0x%04X):\n", kGlowColor);
+    static uint16_t pal[kPaletteSize];
+    const double t_pal = us_per(20000, [&](int i) {
+        glow_palette(pal, kIndexed.iris_palette, kGlowColor, 1 + i % 32);
+        g_sink = pal[i & 255];
+    });
+    EyeRenderParams p = params(idx, 4, false);
+    p.highlight_enabled = false;
+    static Sprite plain;
+    plain = render_iris_sprite<Panel>(p);
+    static Sprite pixels;
+    const double t_px = us_per(20000, [&](int i) {
+        pixels = plain;
+        glow_pixels(pixels.px, Sprite::kStride * Sprite::kStride, kGlowColor, 1 + i % 32);
+        g_sink = pixels.px[i & 255];
+    });
+    std::snprintf(what, sizeof what, "palette %.2f us, per sprite pixel %.2f us", t_pal, t_px);
+    check(t_pal < t_px, what);
+    // The palette-animated sprite equals the per-pixel recolour on every iris pixel (pupil stays black)
+    glow_palette(pal, kIndexed.iris_palette, kGlowColor, 16);
+    p.iris_palette = pal;
+    const Sprite &glowing = render_iris_sprite<Panel>(p);
+    pixels = plain;
+    glow_pixels(pixels.px, Sprite::kStride * Sprite::kStride, kGlowColor, 16);
+    int iris_px = 0, same = 0;
+    for (int y = 0; y <= 2 * plain.r; ++y)
+        for (int x = plain.r - plain.half_w[y]; x <= plain.r + plain.half_w[y]; ++x) {
+            const int i = y * Sprite::kStride + x;
+            if (!plain.px[i]) continue;
+            ++iris_px;
+            same += glowing.px[i] == pixels.px[i];
+        }
+    std::snprintf(what, sizeof what, "palette-animated sprite matches on %d of %d iris pixels", same, iris_px);
+    check(iris_px > 0 && same == iris_px, what);
+
+    if (argc > 1) {
+        render_eye<Panel>(g_rgb, params(rgb, 4, true));
+        render_eye<Panel>(g_idx, params(idx, 4, true));
+        EyeRenderParams g = params(idx, 4, true);
+        g.iris_palette = pal;
+        render_eye<Panel>(g_glow, g);
+        write_ppm(argv[1]);
+        std::printf("wrote %s (RGB565, indexed, indexed with glow)\n", argv[1]);
+    }
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
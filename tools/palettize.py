@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Convert the sclera and iris map of an Uncanny Eyes graphics header to 8-bit palette indices.
+
+Writes a header of four tables the firmware builds an indexed style from (src/indexed_assets.hpp,
+PME_INDEXED_ASSETS): sclera_palette / iris_palette (256 RGB565 entries each) and sclera_index /
+iris_index (one byte per texel, the upstream map's size). Each map gets its own palette, by median cut
+over its RGB565 colours (weighted by pixel count) refined with a few k-means passes; a map with at most
+256 distinct colours converts losslessly. The PSNR of each map against its RGB565 original is printed
+and recorded in the header.
+
+    palettize.py -o build/defaultEye_indexed.h external/Uncanny_Eyes/uncannyEyes/graphics/defaultEye.h
+
+CMake runs it for every built-in style when PME_INDEXED_ASSETS is on.
+"""
+import argparse
+import math
+import os
+import sys
+from collections import Counter
+
+from asset_pack import parse_header
+
+PALETTE = 256
+REFINE_PASSES = 4
+
+
+def rgb(c):
+    """RGB565 to 8-bit channels (bit replication, as the panel's 565 to 666 expansion)."""
+    r, g, b = c >> 11, (c >> 5) & 63, c & 31
+    return (r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2)
+
+
+def to565(r, g, b):
+    q = lambda v, bits: max(0, min((1 << bits) - 1, int(v * ((1 << bits) - 1) / 255.0 + 0.5)))
+    return q(r, 5) << 11 | q(g, 6) << 5 | q(b, 5)
+
+
+def median_cut(hist):
+    """hist: {rgb565: count}. Returns up to PALETTE colours (8-bit RGB means of the boxes)."""
+    boxes = [[(rgb(c), n) for c, n in hist.items()]]
+
+    def spread(box):
+        best = (0, 0)
+        for axis in range(3):
+            vals = [p[axis] for p, _ in box]
+            best = max(best, (max(vals) - min(vals), axis))
+        return best
+
+    while len(boxes) < PALETTE:
+        # Split the box with the most pixels times its widest channel range
+        scored = [(spread(b)[0] * sum(n for _, n in b), i) for i, b in enumerate(boxes) if len(b) > 1]
+        if not scored:
+            break
+        score, i = max(scored)
+        if score == 0:
+            break
+        box = boxes.pop(i)
+        axis = spread(box)[1]
+        box.sort(key=lambda e: e[0][axis])
+        half, acc, cut = sum(n for _, n in box) / 2, 0, 1
+        for k, (_, n) in enumerate(box[:-1]):
+            acc += n
+            cut = k + 1
+            if acc >= half:
+                break
+        boxes += [box[:cut], box[cut:]]
+    return [mean(b) for b in boxes]
+
+
+def mean(entries):
+    total = sum(n for _, n in entries)
+    return tuple(sum(p[a] * n for p, n in entries) / total for a in range(3))
+
+
+def nearest(p, palette):
+    best, best_d = 0, float("inf")
+    for i, q in enumerate(palette):
+        d = (p[0] - q[0]) ** 2 + (p[1] - q[1]) ** 2 + (p[2] - q[2]) ** 2
+        if d < best_d:
+            best, best_d = i, d
+    return best
+
+
+def quantize(pixels):
+    """Returns (palette of RGB565, index per pixel)."""
+    hist = Counter(pixels)
+    if len(hist) <= PALETTE:
+        palette = sorted(hist)
+    else:
+        centres = median_cut(hist)
+        for _ in range(REFINE_PASSES):
+            groups = {}
+            for c, n in hist.items():
+                groups.setdefault(nearest(rgb(c), centres), []).append((rgb(c), n))
+            centres = [mean(groups[i]) if i in groups else centres[i] for i in range(len(centres))]
+        palette = sorted(set(to565(*c) for c in centres))
+    # Darkest to brightest, so palette animation code can treat index ranges as tonal ranges
+    palette.sort(key=lambda c: sum(rgb(c)))
+    lookup = {c: nearest(rgb(c), [rgb(q) for q in palette]) for c in hist}
+    return palette, [lookup[c] for c in pixels]
+
+
+def psnr(pixels, palette, index):
+    err = 0
+    for c, i in zip(pixels, index):
+        a, b = rgb(c), rgb(palette[i])
+        err += (a[0] - b[0]) ** 2 + (a[1] - b[1]) ** 2 + (a[2] - b[2]) ** 2
+    mse = err / (3 * len(pixels))
+    return float("inf") if mse == 0 else 10 * math.log10(255 * 255 / mse)
+
+
+def c_table(decl, values, per_line):
+    rows = [", ".join(values[i:i + per_line]) for i in range(0, len(values), per_line)]
+    return decl + " = {\n    " + ",\n    ".join(rows) + "\n};\n"
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("header", help="upstream graphics header (sclera and iris tables)")
+    ap.add_argument("-o", "--output", required=True)
+    args = ap.parse_args()
+
+    _, arrays = parse_header(args.header)
+    out = [f"// Generated by tools/palettize.py from {os.path.basename(args.header)}; do not edit.\n",
+           "#pragma once\n#include <cstdint>\n\n"]
+    for name in ("sclera", "iris"):
+        if name not in arrays:
+            sys.exit(f"{args.header}: no {name} table")
+        w, h, data = arrays[name]
+        pixels = [int.from_bytes(data[i:i + 2], "little") for i in range(0, len(data), 2)]
+        palette, index = quantize(pixels)
+        q = psnr(pixels, palette, index)
+        quality = "lossless" if math.isinf(q) else f"PSNR {q:.1f} dB"
+        print(f"{name}: {w}x{h}, {len(set(pixels))} colours -> {len(palette)}, {quality}; "
+              f"{2 * w * h} -> {w * h + 2 * PALETTE} bytes")
+        palette += [0] * (PALETTE - len(palette))
+        out.append(f"// {name}: {len(set(pixels))} colours, {quality}\n")
+        out.append(c_table(f"static const uint16_t {name}_palette[{PALETTE}]", [f"0x{c:04X}" for c in palette], 12))
+        out.append(c_table(f"static const uint8_t {name}_index[{h}][{w}]", [str(i) for i in index], 24))
+        out.append("\n")
+    with open(args.output, "w") as f:
+        f.write("".join(out))
+
+
+if __name__ == "__main__":
+    main()
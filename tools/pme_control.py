@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Send live control commands to PicoMonsterEyes over its control UART (see docs/control.md).
+
+One-shot:
+    pme_control.py --port /dev/ttyUSB0 look 12 -4 300
+    pme_control.py --port /dev/ttyUSB0 emotion fear
+    pme_control.py --port /dev/ttyUSB0 blink
+
+Interactive (one command per line on stdin):
+    pme_control.py --port /dev/ttyUSB0
+    pme_control.py --pty            # create a pseudo-terminal and print its path; point
+                                    # tools/control_monitor.cpp or an emulator (e.g. via socat) at it
+
+A pty only holds bytes while something reads it, so --pty is interactive only. For one-shot
+commands without hardware, let control_monitor create the pty and pass its path to --port.
+
+Commands: look X Y [DIST_MM] | release | emotion NAME|INDEX | blink | cue CLIP [GAIN] | style INDEX
+          | glow RGB565 [STRENGTH [PULSE_HZ]]   (e.g. glow 0xF800 0.8 1.5; glow 0 0 turns it off)
+"""
+import argparse
+import os
+import struct
+import sys
+import termios
+import tty
+
+SYNC = b"\xA5\x5A"
+LOOK, RELEASE, EMOTION, BLINK, CUE, STYLE, GLOW = 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+EMOTIONS = {"neutral": 0, "sad": 1, "fear": 2, "anger": 3, "disgust": 4}
+BAUDS = {115200: termios.B115200, 230400: termios.B230400, 460800: getattr(termios, "B460800", None),
+         921600: getattr(termios, "B921600", None)}
+
+
+def crc8(data):
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def frame(ctype, payload=b""):
+    body = bytes([ctype, len(payload)]) + payload
+    return SYNC + body + bytes([crc8(body)])
+
+
+def encode(words):
+    cmd, args = words[0].lower(), words[1:]
+    if cmd == "look":
+        x, y = float(args[0]), float(args[1])
+        dist = int(args[2]) if len(args) > 2 else 0
+        return frame(LOOK, struct.pack("<hhH", int(round(x * 16)), int(round(y * 16)), dist))
+    if cmd == "release":
+        return frame(RELEASE)
+    if cmd == "emotion":
+        e = args[0].lower()
+        return frame(EMOTION, bytes([EMOTIONS[e] if e in EMOTIONS else int(e)]))
+    if cmd == "blink":
+        return frame(BLINK)
+    if cmd == "cue":
+        gain = float(args[1]) if len(args) > 1 else 1.0
+        return frame(CUE, bytes([int(args[0]), max(0, min(255, int(round(gain * 255))))]))
+    if cmd == "style":
+        return frame(STYLE, bytes([int(args[0])]))
+    if cmd == "glow":
+        strength = float(args[1]) if len(args) > 1 else 1.0
+        pulse = float(args[2]) if len(args) > 2 else 0.0
+        return frame(GLOW, struct.pack("<HBB", int(args[0], 0), max(0, min(255, int(round(strength * 255)))),
+                                       max(0, min(255, int(round(pulse * 10))))))
+    raise ValueError(f"unknown command '{cmd}'")
+
+
+def open_port(path, baud):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        speed = BAUDS.get(baud)
+        if speed is not None:
+            attrs = termios.tcgetattr(fd)
+            attrs[4] = attrs[5] = speed
+            termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--port", help="serial device (default: create a pty with --pty)")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--pty", action="store_true", help="create a pseudo-terminal and print the peer path")
+    ap.add_argument("command", nargs="*")
+    args = ap.parse_args()
+
+    if args.pty and args.command:
+        ap.error("--pty is interactive only (nobody has the pty open yet, so a one-shot command would be lost); "
+                 "run tools/control_monitor.cpp and pass the pty it prints to --port")
+    if args.pty:
+        fd, peer = os.openpty()
+        tty.setraw(peer)
+        print(f"control pty: {os.ttyname(peer)}", file=sys.stderr)
+    elif args.port:
+        fd = open_port(args.port, args.baud)
+    else:
+        ap.error("need --port or --pty")
+
+    if args.command:
+        os.write(fd, encode(args.command))
+        return
+    for line in sys.stdin:
+        words = line.split()
+        if not words:
+            continue
+        try:
+            os.write(fd, encode(words))
+        except (ValueError, IndexError, KeyError) as e:
+            print(f"error: {e}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,79 @@
+// Host simulation of sensor-driven gaze: FakePresenceSensor -> GazeTracker -> EyeAnimator at 50 fps.
+// Reports how far the eye trails the visitor (panel px) and the sensor-to-gaze latency, i.e. from a
+// sample arriving to the frame whose iris first moved toward it.
+//
+//     g++ -std=c++17 -O2 -Isrc -Iinclude -o presence_sim tools/presence_sim.cpp src/gaze_tracker.cpp src/eye_animator.cpp
+//     ./presence_sim
+#include "eye_animator.hpp"
+#include "fake_presence_sensor.hpp"
+#include "gaze_tracker.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace eyes;
+
+int main() {
+    constexpr float kW = 128.f, kH = 128.f;
+    constexpr uint32_t kFrameUs = 20000;
+    constexpr uint32_t kRunUs = 60000000;
+    constexpr float kMargin = 30.f;
+    FakePresenceSensor sensor;
+    GazeTracker tracker(kW, kH);
+    GazeTrackerConfig cfg;
+    EyeAnimator anim(kW, kH);
+    anim.set_gaze_margin((int)kMargin);
+    anim.add_eye(EyeMount{0.f, -1});
+    sensor.init();
+
+    double err_sum = 0.0, err_max = 0.0;
+    uint32_t err_n = 0, looks = 0, releases = 0;
+    uint64_t lat_sum = 0;
+    uint32_t lat_n = 0, lat_max = 0;
+    bool pending = false;
+    uint32_t pending_us = 0;
+    AnimInputs in;
+    in.dt = kFrameUs * 1e-6f;
+    for (uint32_t now = 0; now < kRunUs; now += kFrameUs) {
+        sensor.poll(now);
+        PresenceReading r;
+        if (sensor.take(r)) tracker.add(r);
+        switch (tracker.step(in.dt, now)) {
+        case GazeTracker::Action::Look:
+            anim.look_at(tracker.x(), tracker.y(), tracker.distance_mm());
+            ++looks;
+            if (!pending) { pending = true; pending_us = tracker.reading_stamp_us(); }
+            break;
+        case GazeTracker::Action::Release:
+            anim.release_look();
+            ++releases;
+            break;
+        default:
+            break;
+        }
+        anim.step(in);
+        // The frame rendered now shows the new aim: that closes the latency sample
+        if (pending) {
+            uint32_t lat = now + kFrameUs - pending_us;
+            lat_sum += lat; ++lat_n;
+            if (lat > lat_max) lat_max = lat;
+            pending = false;
+        }
+        // Tracking error against the visitor's true position, clamped to where the iris can go
+        PresenceReading t;
+        FakePresenceSensor::truth(now, t);
+        if (t.present && tracker.tracking()) {
+            float tx = std::fmin(std::fmax(kW * 0.5f + (cfg.mirror_x ? -t.x : t.x) * cfg.range_x_px, kMargin), kW - kMargin);
+            float ty = std::fmin(std::fmax(kH * 0.5f + t.y * cfg.range_y_px, kMargin), kH - kMargin);
+            double e = std::hypot(anim.iris_x(0) - tx, anim.iris_y(0) - ty);
+            err_sum += e; ++err_n;
+            if (e > err_max) err_max = e;
+        }
+    }
+    std::printf("looks %u  releases %u\n", looks, releases);
+    std::printf("tracking error avg %.2f px  max %.2f px (%u frames)\n",
+                err_n ? err_sum / err_n : 0.0, err_max, err_n);
+    std::printf("sensor->gaze latency avg %.1f ms  max %.1f ms\n",
+                lat_n ? lat_sum / (double)lat_n / 1000.0 : 0.0, lat_max / 1000.0);
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Host benchmark and check of the pupil shapes (src/pupil_shape.hpp): time to render the default
+// style's iris sprite with each shape, aliased and anti-aliased, over a sweep of dilations, against
+// the circle. Each time is the fastest of many, taken in turn across the shapes so host noise hits
+// them all alike; times are reported, not checked, as a shared host can't hold a margin of a few
+// percent. Then per shape the pupil's size across dilation (rows x widest row in px, must grow as
+// it dilates) and its mirror symmetry, the checks. Optionally writes every shape at five dilations
+// as a PPM.
+//
+//     g++ -std=c++17 -O2 -Iinclude -Isrc -Iboards -Iassets/graphics -o pupil_bench tools/pupil_bench.cpp
+//         src/eye_renderer.cpp assets/graphics/default_eye.cpp
+//     ./pupil_bench [shapes.ppm]
+#include "eye_renderer.hpp"
+#include "pico2_panel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+using namespace eyes;
+
+namespace {
+
+using Sprite = IrisSprite<ActivePanel>;
+constexpr int kStride = Sprite::kStride;
+constexpr const char* kNames[] = {"circle", "ellipse", "slit", "star"};
+constexpr int kShapes = (int)PupilShape::COUNT;
+constexpr float kScales[] = {0.6f, 0.8f, 1.0f, 1.2f, 1.4f};
+constexpr int kRepeats = 25;     // timings per shape, fastest kept
+bool g_ok = true;
+
+EyeRenderParams params(PupilShape shape, bool aa) {
+    EyeRenderParams p;
+    p.iris_radius = kDefaultIrisRadius<ActivePanel>;
+    p.pupil_shape = shape;
+    p.antialias = aa;
+    return p;
+}
+
+// us per sprite for one timing of kRuns sprites across the dilation sweep
+double time_sprite(PupilShape shape, bool aa) {
+    EyeRenderParams p = params(shape, aa);
+    constexpr int kRuns = 400;
+    unsigned sink = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRuns; ++i) {
+        p.pupil_scale = 0.6f + 0.1f * (i % 9);
+        sink += render_iris_sprite<ActivePanel>(p).px[i % kStride];
+    }
+    if (sink == 1) std::printf(" ");
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / kRuns;
+}
+
+// Pupil pixels (black, highlights off) of one sprite: rows, widest row, and mirror symmetry
+struct Extent { int rows = 0, widest = 0; bool symmetric = true; };
+
+Extent measure(const Sprite& s) {
+    Extent e;
+    for (int y = 0; y <= 2 * s.r; ++y) {
+        int n = 0;
+        for (int x = -s.half_w[y]; x <= s.half_w[y]; ++x) {
+            const bool in = s.px[y * kStride + s.r + x] == 0;
+            n += in;
+            e.symmetric = e.symmetric && in == (s.px[y * kStride + s.r - x] == 0);
+        }
+        e.rows += n > 0;
+        if (n > e.widest) e.widest = n;
+    }
+    return e;
+}
+
+void write_ppm(const char* path) {
+    // kShapes rows of sprites, one column per dilation
+    const int cell = kStride, w = cell * 5, h = cell * kShapes;
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) { std::perror(path); return; }
+    std::fprintf(f, "P6\n%d %d\n255\n", w, h);
+    static uint8_t img[kStride * kShapes][kStride * 5][3];
+    for (int s = 0; s < kShapes; ++s) {
+        for (int k = 0; k < 5; ++k) {
+            EyeRenderParams p = params((PupilShape)s, true);
+            p.pupil_scale = kScales[k];
+            const Sprite& sp = render_iris_sprite<ActivePanel>(p);
+            for (int y = 0; y <= 2 * sp.r; ++y) {
+                for (int x = -sp.half_w[y]; x <= sp.half_w[y]; ++x) {
+                    const uint16_t c = sp.px[y * kStride + sp.r + x];
+                    uint8_t* o = img[s * cell + y][k * cell + sp.r + x];
+                    o[0] = (uint8_t)((c >> 11) * 255 / 31);
+                    o[1] = (uint8_t)(((c >> 5) & 63) * 255 / 63);
+                    o[2] = (uint8_t)((c & 31) * 255 / 31);
+                }
+            }
+        }
+    }
+    std::fwrite(img, 1, sizeof img, f);
+    std::fclose(f);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::printf("iris sprite, dilation sweep (us, best of %d):\n", kRepeats);
+    double best[kShapes][2];
+    for (auto& b : best) b[0] = b[1] = 1e9;
+    for (int rep = 0; rep < kRepeats; ++rep)
+        for (int s = 0; s < kShapes; ++s)
+            for (int aa = 0; aa < 2; ++aa) best[s][aa] = std::min(best[s][aa], time_sprite((PupilShape)s, aa == 1));
+    for (int s = 0; s < kShapes; ++s)
+        std::printf("  %-8s %7.2f aliased %7.2f anti-aliased  (%3.0f%% / %3.0f%% of the circle)\n", kNames[s], best[s][0],
+                    best[s][1], 100. * best[s][0] / best[0][0], 100. * best[s][1] / best[0][1]);
+    std::printf("pupil rows x widest row (px) at pupil scale 0.6 .. 1.4:\n");
+    for (int s = 0; s < kShapes; ++s) {
+        EyeRenderParams p = params((PupilShape)s, false);
+        p.highlight_enabled = false;
+        bool ok = true;
+        Extent last;
+        std::printf("  %-8s", kNames[s]);
+        for (float scale : kScales) {
+            p.pupil_scale = scale;
+            const Extent e = measure(render_iris_sprite<ActivePanel>(p));
+            std::printf(" %3dx%-3d", e.rows, e.widest);
+            ok = ok && e.symmetric && e.rows > 0 && e.widest > last.widest;
+            last = e;
+        }
+        std::printf(" %s\n", ok ? "ok" : "FAILED");
+        g_ok = g_ok && ok;
+    }
+    if (argc > 1) write_ppm(argv[1]);
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
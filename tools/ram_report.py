@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""Static RAM budget per subsystem from a GNU ld map file (e.g. build/PicoMonsterEyes.elf.map).
+
+    python tools/ram_report.py build/PicoMonsterEyes.elf.map
+
+Groups every RAM input section by the named placement sections from include/mem_placement.hpp
+(framebuffer, render LUTs, DMA buffers, streamed style slot) and otherwise by source directory, and shows use of each
+memory region (main striped SRAM, SCRATCH_X, SCRATCH_Y).
+"""
+import re
+import sys
+from collections import defaultdict
+
+RAM_OUTPUT_SECTIONS = (".data", ".bss", ".scratch_x", ".scratch_y", ".uninitialized_data", ".ram_vector_table",
+                       ".tdata", ".tbss", ".heap", ".stack_dummy", ".stack1_dummy")
+NAMED = {
+    "pme_framebuffer": "framebuffer",
+    "pme_luts": "render LUTs + iris sprite",
+    "pme_dma": "DMA line buffers",
+    "pme_assets": "streamed style slot",
+}
+REGION_RE = re.compile(r"^(\w+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+OUT_RE = re.compile(r"^(\.[\w.]+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+IN_RE = re.compile(r"^ (\.[\w.$-]+|COMMON)?\s*0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+IN_NAME_RE = re.compile(r"^ (\.[\w.$-]+|COMMON)\s*$")
+
+
+def subsystem(section, obj):
+    for key, label in NAMED.items():
+        if key in section:
+            return label
+    m = re.search(r"\.dir/(?:.*/)?(src|drivers|assets|boards)/", obj) or re.search(r"/(src|drivers|assets)/", obj)
+    if m:
+        return m.group(1) + "/"
+    if "main.c" in obj:
+        return "main"
+    if "pico-sdk" in obj or "pico_" in obj or "hardware_" in obj:
+        return "pico-sdk"
+    if obj.endswith(".a") or ".a(" in obj or "lib" in obj:
+        return "toolchain libs"
+    return "other"
+
+
+def parse(path):
+    regions = {}
+    usage = defaultdict(int)
+    outputs = []  # (name, addr, size)
+    in_memcfg = in_map = False
+    out = None
+    pending = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Memory Configuration"):
+                in_memcfg = True
+                continue
+            if line.startswith("Linker script and memory map"):
+                in_memcfg, in_map = False, True
+                continue
+            if in_memcfg:
+                m = REGION_RE.match(line)
+                if m and m.group(1) != "Name":
+                    regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+                continue
+            if not in_map:
+                continue
+            m = OUT_RE.match(line)
+            if m:
+                out = m.group(1) if m.group(1).startswith(RAM_OUTPUT_SECTIONS) else None
+                if out:
+                    outputs.append((out, int(m.group(2), 16), int(m.group(3), 16)))
+                continue
+            if out is None:
+                continue
+            m = IN_NAME_RE.match(line)
+            if m:
+                pending = m.group(1)
+                continue
+            m = IN_RE.match(line)
+            if m:
+                name = m.group(1) or pending or out
+                pending = None
+                size = int(m.group(3), 16)
+                if size:
+                    usage[subsystem(name, m.group(4))] += size
+    return regions, outputs, usage
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    regions, outputs, usage = parse(sys.argv[1])
+    print("RAM by subsystem:")
+    for label, size in sorted(usage.items(), key=lambda kv: -kv[1]):
+        print(f"  {label:<28} {size:>8} B")
+    print(f"  {'total':<28} {sum(usage.values()):>8} B")
+    ram_regions = {k: v for k, v in regions.items() if k != "FLASH" and v[1] < 0x1000000}
+    if ram_regions:
+        print("RAM by region:")
+        for name, (origin, length) in ram_regions.items():
+            used = sum(sz for _, addr, sz in outputs if origin <= addr < origin + length)
+            print(f"  {name:<12} {used:>8} / {length:<8} B ({100.0 * used / length:5.1f}%)")
+
+
+if __name__ == "__main__":
+    main()
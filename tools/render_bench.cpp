@@ -0,0 +1,223 @@
+// Host benchmark of the panel-templated renderer (include/panel_geometry.hpp). At 128x128 it times
+// render_eye and a frame's two-eye path (iris sprite, then compose and eyelids per eye) over a sweep
+// of gaze positions and pupil sizes; built against the last pre-template renderer as well, it times
+// that code on the same work and fails if the templated paths are more than 10% slower (best of
+// many interleaved repeats, so a noisy host shows up in both columns). It then renders and times a
+// Panel240x240 eye, the geometry the host build instantiates besides ActivePanel, and checks every
+// pixel of the larger frame is drawn. Last, it checks the HalfRateLids quality tier: two eyes that
+// keep every other frame's eyelid spans (as Eye::tick does) into one shared frame, against each eye
+// rendered with fresh spans, while the sub-pixel phase turns on between lid frames. CMake builds the current-renderer variant with
+// -DPME_HOST_BUILD=ON; for the comparison extract the renderer from before panel_geometry.hpp:
+//
+//     mkdir -p /tmp/pretemplate && c=$(git log --format=%h --diff-filter=A -- include/panel_geometry.hpp)
+//     git show $c^:src/eye_renderer.hpp > /tmp/pretemplate/eye_renderer.hpp
+//     git show $c^:src/eye_renderer.cpp > /tmp/pretemplate/eye_renderer.cpp
+//     g++ -std=c++17 -O2 -Deyes=eyes_pretemplate -Iinclude -Isrc -Iassets/graphics -c -o /tmp/pretemplate/eye_renderer.o
+//         /tmp/pretemplate/eye_renderer.cpp
+//     g++ -std=c++17 -O2 -DPME_HOST_BUILD=1 -DPME_RENDER_BENCH_PRETEMPLATE=1 -Iinclude -Isrc -Iboards
+//         -Iassets/graphics -I/tmp -o render_bench tools/render_bench.cpp src/eye_renderer.cpp
+//         assets/graphics/default_eye.cpp /tmp/pretemplate/eye_renderer.o
+//     ./render_bench
+#include "eye_renderer.hpp"
+#include "pico2_panel.hpp"
+
+#if PME_RENDER_BENCH_PRETEMPLATE
+// The old renderer, compiled into its own namespace so both link into one program
+#define eyes eyes_pretemplate
+#include "pretemplate/eye_renderer.hpp"
+#undef eyes
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+using namespace eyes;
+
+namespace {
+
+constexpr int kRuns = 200;   // frames per timing
+constexpr int kRepeats = 15; // timings per path, best kept
+bool g_ok = true;
+volatile uint32_t g_sink;
+
+void check(bool cond, const char *what) {
+    std::printf("  %-64s %s\n", what, cond ? "ok" : "FAILED");
+    g_ok = g_ok && cond;
+}
+
+// us per run of f(i), i = 0 .. kRuns-1
+template <class F>
+double us_once(F f) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRuns; ++i) f(i);
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / kRuns;
+}
+
+// Sweep of gaze positions (whole pixels, which the old renderer supports) and pupil sizes
+int gaze_x(int i, int w) { return w / 2 + (i % 17) - 8; }
+int gaze_y(int i, int h) { return h / 2 + (i % 11) - 5; }
+float pupil(int i) { return 0.6f + 0.1f * (i % 9); }
+
+template <class Panel>
+EyeRenderParams params(int i) {
+    EyeRenderParams p;
+    p.iris_radius = kDefaultIrisRadius<Panel>;
+    p.iris_center_x = gaze_x(i, Panel::kWidth);
+    p.iris_center_y = gaze_y(i, Panel::kHeight);
+    p.pupil_scale = pupil(i);
+    p.eyelid_open = 0.75f;
+    return p;
+}
+
+template <class Panel>
+void render_new(uint16_t *frame, int i) {
+    render_eye<Panel>(frame, params<Panel>(i));
+    g_sink = frame[i & 255];
+}
+
+// One frame of two eyes sharing a sprite, the second converged 6 px and with mirrored lids
+template <class Panel>
+void frame_new(uint16_t *frame, int i) {
+    EyeRenderParams l = params<Panel>(i), r = l;
+    r.iris_center_x -= 6;
+    r.mirror_eyelids = true;
+    const IrisSprite<Panel> &s = render_iris_sprite<Panel>(l);
+    compose_eye<Panel>(frame, s, l);
+    apply_eyelids<Panel>(frame, l);
+    compose_eye<Panel>(frame, s, r);
+    apply_eyelids<Panel>(frame, r);
+    g_sink = frame[i & 255];
+}
+
+#if PME_RENDER_BENCH_PRETEMPLATE
+namespace old = eyes_pretemplate;
+
+old::EyeRenderParams params_old(int i) {
+    old::EyeRenderParams p;
+    p.iris_center_x = gaze_x(i, p.frame_w);
+    p.iris_center_y = gaze_y(i, p.frame_h);
+    p.pupil_scale = pupil(i);
+    p.eyelid_open = 0.75f;
+    return p;
+}
+
+void render_old(uint16_t *frame, int i) {
+    old::render_eye(frame, params_old(i));
+    g_sink = frame[i & 255];
+}
+
+void frame_old(uint16_t *frame, int i) {
+    old::EyeRenderParams l = params_old(i), r = l;
+    r.iris_center_x -= 6;
+    r.mirror_eyelids = true;
+    const old::IrisSprite &s = old::render_iris_sprite(l);
+    old::compose_eye(frame, s, l);
+    old::apply_eyelids(frame, l);
+    old::compose_eye(frame, s, r);
+    old::apply_eyelids(frame, r);
+    g_sink = frame[i & 255];
+}
+#endif
+
+uint16_t g_frame[Panel240x240::kPixels], g_other[Panel240x240::kPixels];
+
+// App's eyes over a run of frames with the lids updated on even frames only (HalfRateLids). The
+// gaze lands on whole pixels on lid frames and between pixels on the others, so the spans kept from
+// a lid frame never had the sub-pixel margin. Both eyes share g_frame, so anything compose misses
+// shows the other eye; each eye is compared with the same eye rendered on its own with fresh spans.
+template <class Panel>
+bool half_rate_lids_match() {
+    EyeRenderParams eye[2];
+    EyelidSpans<Panel> spans[2], fresh;
+    for (int e = 0; e < 2; ++e) {
+        eye[e].iris_radius = kDefaultIrisRadius<Panel>;
+        eye[e].spherical = true;
+        eye[e].antialias = true;
+        eye[e].sclera_parallax = 1.f;
+        eye[e].mirror_eyelids = e == 0;
+    }
+    bool same = true;
+    for (int f = 0; f < 24; ++f) {
+        const bool lids = !(f & 1);
+        const float sub = lids ? 0.f : 0.25f * (1 + f % 6 / 2);
+        for (int e = 0; e < 2; ++e) {
+            set_iris_position(eye[e], Panel::kWidth * 0.5f + (f % 7) - 3 - 5 * e + sub, Panel::kHeight * 0.5f + (f % 5) - 2 + sub);
+            eye[e].pupil_scale = pupil(f);
+            if (lids) {
+                eye[e].eyelid_open = 0.35f + 0.05f * (f % 9);
+                compute_eyelid_spans<Panel>(eye[e], spans[e]);
+            } else {
+                widen_eyelid_spans<Panel>(eye[e], spans[e]);
+            }
+        }
+        const CulledEye<Panel> culled[2] = {{&eye[0], &spans[0]}, {&eye[1], &spans[1]}};
+        const IrisSprite<Panel> &s = render_iris_sprite<Panel>(eye[0], culled, 2);
+        for (int e = 0; e < 2; ++e) {
+            compose_eye<Panel>(g_frame, s, eye[e], &spans[e]);
+            apply_eyelids<Panel>(g_frame, eye[e]);
+            compute_eyelid_spans<Panel>(eye[e], fresh);
+            const CulledEye<Panel> alone{&eye[e], &fresh};
+            std::fill(g_other, g_other + Panel::kPixels, 0xF81F);
+            compose_eye<Panel>(g_other, render_iris_sprite<Panel>(eye[e], &alone, 1), eye[e], &fresh);
+            apply_eyelids<Panel>(g_other, eye[e]);
+            same = same && std::equal(g_frame, g_frame + Panel::kPixels, g_other);
+            // The sprite is shared: put the pair's back for the second eye
+            render_iris_sprite<Panel>(eye[0], culled, 2);
+        }
+    }
+    return same;
+}
+
+} // namespace
+
+int main() {
+    using P128 = ActivePanel;
+    using P240 = Panel240x240;
+    static_assert(P128::kWidth == 128 && P128::kHeight == 128, "the comparison is at 128x128");
+    char what[96];
+
+    std::printf("128x128 (us per frame, best of %d x %d frames):\n", kRepeats, kRuns);
+    const char *names[] = {"render_eye", "sprite, 2 x (compose, lids)"};
+    for (int path = 0; path < 2; ++path) {
+        double t_new = 1e9;
+#if PME_RENDER_BENCH_PRETEMPLATE
+        double t_old = 1e9;
+#endif
+        for (int rep = 0; rep < kRepeats; ++rep) {
+            t_new = std::min(t_new, us_once([&](int i) { path ? frame_new<P128>(g_frame, i) : render_new<P128>(g_frame, i); }));
+#if PME_RENDER_BENCH_PRETEMPLATE
+            t_old = std::min(t_old, us_once([&](int i) { path ? frame_old(g_frame, i) : render_old(g_frame, i); }));
+#endif
+        }
+#if PME_RENDER_BENCH_PRETEMPLATE
+        std::snprintf(what, sizeof what, "%s: %.1f templated, %.1f pre-template", names[path], t_new, t_old);
+        check(t_new <= t_old * 1.1, what);
+#else
+        std::printf("  %s: %.1f (build with the pre-template renderer to compare)\n", names[path], t_new);
+#endif
+    }
+
+    std::printf("240x240:\n");
+    // Every pixel drawn: the same frame from two different starting contents
+    std::fill(g_frame, g_frame + P240::kPixels, 0x0000);
+    std::fill(g_other, g_other + P240::kPixels, 0xFFFF);
+    frame_new<P240>(g_frame, 3);
+    frame_new<P240>(g_other, 3);
+    check(std::equal(g_frame, g_frame + P240::kPixels, g_other), "two-eye frame draws every pixel");
+    const IrisSprite<P240> &s = render_iris_sprite<P240>(params<P240>(0));
+    std::snprintf(what, sizeof what, "iris sprite radius %d px (default %.1f)", s.r, kDefaultIrisRadius<P240>);
+    check(s.r == (int)kDefaultIrisRadius<P240>, what);
+    double t[2] = {1e9, 1e9};
+    for (int rep = 0; rep < kRepeats; ++rep) {
+        t[0] = std::min(t[0], us_once([&](int i) { render_new<P240>(g_frame, i); }));
+        t[1] = std::min(t[1], us_once([&](int i) { frame_new<P240>(g_frame, i); }));
+    }
+    std::printf("  %s: %.1f us, %s: %.1f us\n", names[0], t[0], names[1], t[1]);
+
+    std::printf("half-rate lids (128x128):\n");
+    check(half_rate_lids_match<P128>(), "shared frame with kept spans matches fresh spans per eye");
+
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// Host simulation of the main loop's Scheduler on a fake clock: the App task set (control, sensor,
+// frame, stats) with modelled run times, sensor DMA completions arriving as wakes, and an overload
+// case where the frame outgrows its period. Prints the scheduler report per case and checks it.
+//
+//     g++ -std=c++17 -O2 -Isrc -o sched_sim tools/sched_sim.cpp src/scheduler.cpp
+//     ./sched_sim
+#include "scheduler.hpp"
+
+#include <cstdio>
+
+using namespace eyes;
+
+namespace {
+
+// Time moves only when a task "works" (advance) or the scheduler idles; external events (DMA
+// completions) fire at their time either way
+class FakeClock : public Clock {
+public:
+    using EventFn = void (*)(void* ctx);
+
+    uint64_t now_us() override { return now_; }
+    void wait_until(uint64_t t_us) override {
+        if (signalled_) { signalled_ = false; return; }
+        advance_to(t_us, true);
+        signalled_ = false;
+    }
+    void signal() override { signalled_ = true; }
+    void advance(uint64_t us) { advance_to(now_ + us, false); }
+    // Recurring event every period_us, starting at first_us
+    void every(uint64_t first_us, uint64_t period_us, EventFn fn, void* ctx) {
+        ev_at_ = first_us; ev_period_ = period_us; ev_fn_ = fn; ev_ctx_ = ctx;
+    }
+
+private:
+    void advance_to(uint64_t t, bool stop_on_event) {
+        while (ev_fn_ && ev_at_ <= t) {
+            now_ = ev_at_;
+            ev_at_ += ev_period_;
+            ev_fn_(ev_ctx_);
+            if (stop_on_event) return; // the wake ends the idle wait
+        }
+        now_ = t;
+    }
+
+    uint64_t now_ = 0;
+    bool signalled_ = false;
+    uint64_t ev_at_ = 0, ev_period_ = 0;
+    EventFn ev_fn_ = nullptr;
+    void* ev_ctx_ = nullptr;
+};
+
+struct Sim {
+    FakeClock clock;
+    Scheduler sched{clock};
+    uint32_t frame_us = 0;
+    uint32_t seed = 12345;
+    int sensor = -1;
+    int samples = 0;        // DMA completions
+    int sensor_latency_max = 0;
+    uint64_t sample_at = 0;
+    bool sample_waiting = false;
+
+    uint32_t jitter(uint32_t range) {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) % (range + 1);
+    }
+};
+
+bool run_case(const char* title, uint32_t frame_us, bool expect_frame_misses) {
+    Sim sim;
+    sim.frame_us = frame_us;
+    Scheduler& s = sim.sched;
+    s.add("ctrl", [](void* p, uint64_t) { static_cast<Sim*>(p)->clock.advance(20); }, &sim, 2000, 20000);
+    sim.sensor = s.add("sensor", [](void* p, uint64_t now) {
+        Sim* m = static_cast<Sim*>(p);
+        if (m->sample_waiting) {
+            int lat = (int)(now - m->sample_at);
+            if (lat > m->sensor_latency_max) m->sensor_latency_max = lat;
+            m->sample_waiting = false;
+            m->clock.advance(60); // locate the blob
+        }
+        m->clock.advance(5);
+    }, &sim, 10000, 20000);
+    s.add("frame", [](void* p, uint64_t) {
+        Sim* m = static_cast<Sim*>(p);
+        m->clock.advance(m->frame_us + m->jitter(2000));
+    }, &sim, 20000);
+    s.add("stats", [](void* p, uint64_t) { static_cast<Sim*>(p)->clock.advance(300); }, &sim, 1000000);
+    // Sensor frames complete every 100 ms (DMA IRQ -> wake)
+    sim.clock.every(3333, 100000, [](void* p) {
+        Sim* m = static_cast<Sim*>(p);
+        ++m->samples;
+        m->sample_at = m->clock.now_us();
+        m->sample_waiting = true;
+        m->sched.wake(m->sensor);
+    }, &sim);
+    while (sim.clock.now_us() < 5000000) s.run_once();
+
+    std::printf("%s (frame %u-%u us of 20000)\n  ", title, frame_us, frame_us + 2000);
+    const uint32_t frame_misses = s.stats(2).misses, ctrl_misses = s.stats(0).misses;
+    const uint32_t frames = s.stats(2).runs, ctrl_runs = s.stats(0).runs;
+    s.report();
+    std::printf("  sensor samples %d, worst sample->task %d us\n", sim.samples, sim.sensor_latency_max);
+    // Within budget nothing misses. Over it the frame misses, and since a task cannot be preempted the
+    // others only run between frames, nearly every time (EDF can put a lagging frame first)
+    bool ok = expect_frame_misses
+        ? frame_misses > 0 && ctrl_runs * 10 >= frames * 9 && sim.sensor_latency_max <= 2 * 23000
+        : frame_misses == 0 && frames >= 249 && ctrl_misses == 0 && sim.sensor_latency_max <= 20000;
+    std::printf("  %s\n", ok ? "ok" : "FAIL");
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    bool ok = run_case("nominal", 12000, false);
+    ok = run_case("heavy", 17500, false) && ok;
+    ok = run_case("overload", 21000, true) && ok;
+    return ok ? 0 : 1;
+}
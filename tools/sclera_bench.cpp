@@ -0,0 +1,154 @@
+// Host comparison of the procedural sclera (PME_PROCEDURAL_SCLERA) with the default style's sclera
+// table: mean colour over the visible window and over rings around its centre, which must stay
+// within kMeanBound and kRingBound per channel (kDefaultScleraRecipe's centre and rim colours are
+// fitted to the table's ring means); time per 128-pixel row (flat compose) and per sampled pixel
+// (spherical compose); and optionally both windows side by side as a PPM. The timings are the
+// host's only: here the table sits in cache, on the RP2350 it is read through the 16 KB XIP cache,
+// and that cost has not been measured on hardware.
+//
+//     g++ -std=c++17 -O2 -Isrc -Iassets/graphics -o sclera_bench tools/sclera_bench.cpp
+//     ./sclera_bench [compare.ppm]
+#include "default_eye.hpp"
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#include "../external/Uncanny_Eyes/uncannyEyes/graphics/defaultEye.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+using namespace eyes;
+
+namespace {
+
+constexpr int kW = SCLERA_WIDTH, kH = SCLERA_HEIGHT;
+constexpr int kWin = PME_EYELID_WIDTH;            // visible window (one reference screen)
+constexpr int kX0 = (kW - kWin) / 2, kY0 = (kH - kWin) / 2;
+constexpr ProceduralSclera kGen{kDefaultScleraRecipe, kW, kH};
+constexpr int kRing = 8;                          // ring width (px) for the radial means
+constexpr int kRings = kWin / 2 / kRing;          // out to the window's inscribed circle
+constexpr double kMeanBound = 4;                  // max |window mean difference| per channel (0..255)
+constexpr double kRingBound = 10;                 // max |ring mean difference| per channel
+bool g_ok = true;
+
+uint16_t g_table[kWin * kWin], g_proc[kWin * kWin];
+volatile uint32_t g_sink;
+
+template <class F>
+double ns_per(int reps, F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < reps; ++i) f(i);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / reps;
+}
+
+void check(bool cond, const char *what) {
+    std::printf("  %-64s %s\n", what, cond ? "ok" : "FAILED");
+    g_ok = g_ok && cond;
+}
+
+void channels(uint16_t v, int c[3]) { c[0] = (v >> 11) << 3; c[1] = ((v >> 5) & 63) << 2; c[2] = (v & 31) << 3; }
+
+void write_ppm(const char *path) {
+    FILE *f = std::fopen(path, "wb");
+    if (!f) { std::perror(path); return; }
+    std::fprintf(f, "P6 %d %d 255\n", 2 * kWin, kWin);
+    for (int y = 0; y < kWin; ++y)
+        for (const uint16_t *img : {g_table, g_proc})
+            for (int x = 0; x < kWin; ++x) {
+                int c[3];
+                channels(img[y * kWin + x], c);
+                unsigned char rgb[3] = {(unsigned char)c[0], (unsigned char)c[1], (unsigned char)c[2]};
+                std::fwrite(rgb, 1, 3, f);
+            }
+    std::fclose(f);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    for (int y = 0; y < kWin; ++y) {
+        std::memcpy(&g_table[y * kWin], &sclera[kY0 + y][kX0], kWin * sizeof(uint16_t));
+        kGen.row(&g_proc[y * kWin], kX0, kY0 + y, kWin);
+    }
+    double mean[2][3] = {}, diff = 0, ring[kRings][2][3] = {};
+    int ring_n[kRings] = {};
+    for (int i = 0; i < kWin * kWin; ++i) {
+        int a[3], b[3];
+        channels(g_table[i], a);
+        channels(g_proc[i], b);
+        const int dx = i % kWin - kWin / 2, dy = i / kWin - kWin / 2;
+        const int r = (int)std::sqrt((double)(dx * dx + dy * dy)) / kRing;
+        if (r < kRings) ++ring_n[r];
+        for (int k = 0; k < 3; ++k) {
+            mean[0][k] += a[k]; mean[1][k] += b[k];
+            diff += std::abs(a[k] - b[k]);
+            if (r < kRings) { ring[r][0][k] += a[k]; ring[r][1][k] += b[k]; }
+        }
+    }
+    const double n = kWin * kWin;
+    double worst = 0;
+    for (int k = 0; k < 3; ++k) worst = std::fmax(worst, std::fabs(mean[0][k] - mean[1][k]) / n);
+    std::printf("window mean RGB: table (%.0f, %.0f, %.0f), procedural (%.0f, %.0f, %.0f); mean |diff| %.1f per pixel channel\n",
+                mean[0][0] / n, mean[0][1] / n, mean[0][2] / n, mean[1][0] / n, mean[1][1] / n, mean[1][2] / n,
+                diff / (3 * n));
+    char what[96];
+    std::snprintf(what, sizeof what, "window means differ by %.1f per channel at most (bound %.0f)", worst, kMeanBound);
+    check(worst <= kMeanBound, what);
+    std::printf("ring means RGB (%d px rings), table / procedural:\n", kRing);
+    worst = 0;
+    for (int r = 0; r < kRings; ++r) {
+        double t[3], p[3];
+        for (int k = 0; k < 3; ++k) {
+            t[k] = ring[r][0][k] / ring_n[r];
+            p[k] = ring[r][1][k] / ring_n[r];
+            worst = std::fmax(worst, std::fabs(t[k] - p[k]));
+        }
+        std::printf("  %3d-%3d px: (%3.0f, %3.0f, %3.0f) / (%3.0f, %3.0f, %3.0f)\n", r * kRing, (r + 1) * kRing, t[0], t[1],
+                    t[2], p[0], p[1], p[2]);
+    }
+    std::snprintf(what, sizeof what, "ring means differ by %.1f per channel at most (bound %.0f)", worst, kRingBound);
+    check(worst <= kRingBound, what);
+    std::printf("flash: table %u bytes, procedural %u bytes\n", (unsigned)sizeof(sclera), (unsigned)sizeof(kGen));
+
+    // Rows as flat compose reads them, the window moving with parallax
+    static uint16_t row[kWin];
+    constexpr int kReps = 200000;
+    const double copy_ns = ns_per(kReps, [](int i) {
+        const int y = kY0 + i % kWin, x0 = kX0 + (i / kWin) % 17 - 8;
+        std::memcpy(row, &sclera[y][x0], sizeof row);
+        g_sink = row[i & (kWin - 1)];
+    });
+    const double gen_ns = ns_per(kReps, [](int i) {
+        const int y = kY0 + i % kWin, x0 = kX0 + (i / kWin) % 17 - 8;
+        kGen.row(row, x0, y, kWin);
+        g_sink = row[i & (kWin - 1)];
+    });
+    std::printf("row of %d px (host): table copy %.1f ns, procedural %.1f ns\n", kWin, copy_ns, gen_ns);
+
+    // Scattered single pixels as spherical compose samples them
+    uint32_t s = 1;
+    const double tbl_px = ns_per(kReps * 16, [&s](int) {
+        s = s * 1664525u + 1013904223u;
+        g_sink = sclera[(s >> 8) % kH][(s >> 20) % kW];
+    });
+    s = 1;
+    const double gen_px = ns_per(kReps * 16, [&s](int) {
+        s = s * 1664525u + 1013904223u;
+        g_sink = kGen.pixel((int)((s >> 20) % kW), (int)((s >> 8) % kH));
+    });
+    std::printf("sampled pixel (host): table %.2f ns, procedural %.2f ns\n", tbl_px, gen_px);
+    std::printf("host timings only: the table is cached here; its cost through the RP2350's XIP cache, and\n"
+                "so the procedural sclera's speed relative to it there, is unmeasured\n");
+
+    if (argc > 1) {
+        write_ppm(argv[1]);
+        std::printf("wrote %s (table left, procedural right)\n", argv[1]);
+    }
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}
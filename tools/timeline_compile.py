@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Compile a JSON animation timeline into the PMTL binary read by src/timeline.cpp.
+
+Input (times in seconds, converted to audio samples at sample_rate):
+
+    {
+      "sample_rate": 22050,
+      "duration": 6.0,
+      "loop": false,
+      "tracks": [
+        {"kind": "gaze",    "interp": "smooth", "keys": [[0.0, 0, 0], [0.4, -18, 6]]},
+        {"kind": "pupil",   "interp": "linear", "keys": [[0.0, 1.0], [0.5, 0.7]]},
+        {"kind": "eyelid",  "interp": "smooth", "keys": [[0.0, 1.0], [2.0, 0.4]]},
+        {"kind": "emotion", "keys": [[0.0, "fear"], [3.0, "anger"]]},
+        {"kind": "cue",     "keys": [[0.05, 3], [2.5, 4, 0.8]]}
+      ]
+    }
+
+Gaze values are pixels from the panel centre at the 128x128 reference size; pupil is the scale
+multiplier; eyelid is openness 0..1; cue keys are [time, clip_id, gain=1.0].
+
+Usage:
+    timeline_compile.py scare.json -o scare.pmtl [--header scare_timeline.hpp --name kScareTimeline]
+"""
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"PMTL"
+VERSION = 1
+FLAG_LOOP = 1
+
+KINDS = {"gaze": 0, "pupil": 1, "eyelid": 2, "emotion": 3, "cue": 4}
+INTERPS = {"step": 0, "linear": 1, "smooth": 2}
+# Must match App::Emotion order
+EMOTIONS = {"neutral": 0, "sad": 1, "fear": 2, "anger": 3, "disgust": 4}
+
+HEADER = struct.Struct("<4sHHIII")
+TRACK = struct.Struct("<BBHI")
+KEY = struct.Struct("<Ihh")
+
+
+def clamp16(v):
+    return max(-32768, min(32767, int(round(v))))
+
+
+def encode_key(kind, key, sample_rate, where):
+    t = int(round(float(key[0]) * sample_rate))
+    if t < 0 or t > 0xFFFFFFFF:
+        raise ValueError(f"{where}: time out of range")
+    if kind == "gaze":
+        v0, v1 = clamp16(float(key[1]) * 16), clamp16(float(key[2]) * 16)
+    elif kind in ("pupil", "eyelid"):
+        v0, v1 = clamp16(float(key[1]) * 4096), 0
+    elif kind == "emotion":
+        e = key[1]
+        v0 = EMOTIONS[e.lower()] if isinstance(e, str) else int(e)
+        v1 = 0
+    else:  # cue
+        v0 = int(key[1])
+        v1 = clamp16(float(key[2] if len(key) > 2 else 1.0) * 4096)
+    return t, v0, v1
+
+
+def compile_timeline(doc):
+    sample_rate = int(doc.get("sample_rate", 22050))
+    tracks = doc["tracks"]
+    if not 0 < len(tracks) <= 8:
+        raise ValueError("timeline needs 1..8 tracks")
+    encoded = []
+    last_time = 0
+    for i, tr in enumerate(tracks):
+        kind = tr["kind"].lower()
+        if kind not in KINDS:
+            raise ValueError(f"track {i}: unknown kind '{tr['kind']}'")
+        interp = "step" if kind in ("emotion", "cue") else tr.get("interp", "linear").lower()
+        keys = [encode_key(kind, k, sample_rate, f"track {i} key {j}") for j, k in enumerate(tr["keys"])]
+        if not keys or len(keys) > 0xFFFF:
+            raise ValueError(f"track {i}: needs 1..65535 keys")
+        keys.sort(key=lambda k: k[0])
+        last_time = max(last_time, keys[-1][0])
+        encoded.append((KINDS[kind], INTERPS[interp], keys))
+
+    duration = int(round(float(doc["duration"]) * sample_rate)) if "duration" in doc else last_time + 1
+    flags = FLAG_LOOP if doc.get("loop") else 0
+
+    offset = HEADER.size + TRACK.size * len(encoded)
+    descs, blobs = [], []
+    for kind, interp, keys in encoded:
+        descs.append(TRACK.pack(kind, interp, len(keys), offset))
+        blob = b"".join(KEY.pack(*k) for k in keys)
+        blobs.append(blob)
+        offset += len(blob)
+    head = HEADER.pack(MAGIC, VERSION, len(encoded), sample_rate, max(duration, 1), flags)
+    return head + b"".join(descs) + b"".join(blobs)
+
+
+def write_header(path, name, data):
+    with open(path, "w") as f:
+        f.write("// Generated by tools/timeline_compile.py - do not edit\n#pragma once\n#include <cstdint>\n\n")
+        f.write(f"alignas(4) inline constexpr uint8_t {name}[{len(data)}] = {{\n")
+        for i in range(0, len(data), 16):
+            f.write("    " + ", ".join(f"0x{b:02X}" for b in data[i:i + 16]) + ",\n")
+        f.write("};\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input")
+    ap.add_argument("-o", "--output", help="binary output (.pmtl)")
+    ap.add_argument("--header", help="also emit a C++ header with the blob as an array")
+    ap.add_argument("--name", default="kTimeline", help="array name for --header")
+    args = ap.parse_args()
+    with open(args.input) as f:
+        data = compile_timeline(json.load(f))
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(data)
+    if args.header:
+        write_header(args.header, args.name, data)
+    print(f"{args.input}: {len(data)} bytes", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
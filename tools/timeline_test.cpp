@@ -0,0 +1,167 @@
+// Host test of TimelinePlayer (src/timeline.hpp) on timelines built in memory: load validation,
+// linear and stepped sampling, cues over a loop wrap (those before the end and after the wrap both
+// fire), the clock stepping backwards (tracks re-sample, cues behind the new position stay quiet,
+// those ahead of it fire again), and the end of a non-looping timeline.
+//
+//     g++ -std=c++17 -O2 -Isrc -o timeline_test tools/timeline_test.cpp src/timeline.cpp
+//     ./timeline_test
+#include "timeline.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+
+using namespace eyes;
+
+namespace {
+
+bool g_ok = true;
+
+void check(bool cond, const char *what) {
+    std::printf("  %-64s %s\n", what, cond ? "ok" : "FAILED");
+    g_ok = g_ok && cond;
+}
+
+constexpr uint32_t kRate = 1000;     // 1 sample per ms keeps the times readable
+constexpr uint32_t kDuration = 1000;
+
+// Gaze: linear 0 -> 160 (10 px) over 0..1000. Emotion: 1 from 0, 3 from 600.
+// Cues: id 1 at 100, id 2 at 950, id 3 at 990.
+struct Blob {
+    alignas(4) uint8_t bytes[256];
+    size_t len = 0;
+};
+
+Blob make_timeline(bool loop) {
+    Blob b;
+    TimelineHeader h{};
+    std::memcpy(h.magic, "PMTL", 4);
+    h.version = kTimelineVersion;
+    h.track_count = 3;
+    h.sample_rate = kRate;
+    h.duration = kDuration;
+    h.flags = loop ? (uint32_t)kTimelineLoop : 0u;
+    const TimelineKey gaze[] = {{0, 0, 0}, {1000, 160, -160}};
+    const TimelineKey emotion[] = {{0, 1, 0}, {600, 3, 0}};
+    const TimelineKey cues[] = {{100, 1, 4096}, {950, 2, 2048}, {990, 3, 4096}};
+    const TimelineTrackDesc descs[] = {
+        {(uint8_t)TimelineTrackKind::Gaze, (uint8_t)TimelineInterp::Linear, 2, 0},
+        {(uint8_t)TimelineTrackKind::Emotion, (uint8_t)TimelineInterp::Step, 2, 0},
+        {(uint8_t)TimelineTrackKind::Cue, (uint8_t)TimelineInterp::Step, 3, 0},
+    };
+    size_t off = sizeof h + sizeof descs;
+    TimelineTrackDesc d[3];
+    std::memcpy(d, descs, sizeof d);
+    const TimelineKey *keys[] = {gaze, emotion, cues};
+    for (int i = 0; i < 3; ++i) {
+        d[i].keys_offset = (uint32_t)off;
+        std::memcpy(b.bytes + off, keys[i], d[i].key_count * sizeof(TimelineKey));
+        off += d[i].key_count * sizeof(TimelineKey);
+    }
+    std::memcpy(b.bytes, &h, sizeof h);
+    std::memcpy(b.bytes + sizeof h, d, sizeof d);
+    b.len = off;
+    return b;
+}
+
+// The cue ids fired by one frame, in order
+bool cues_are(const TimelineFrame &f, std::initializer_list<int> ids) {
+    if (f.cue_count != ids.size()) return false;
+    int i = 0;
+    for (int id : ids)
+        if (f.cue_id[i++] != id) return false;
+    return true;
+}
+
+void test_load() {
+    std::printf("load:\n");
+    TimelinePlayer p;
+    Blob b = make_timeline(false);
+    check(p.load(b.bytes, b.len), "valid timeline");
+    check(!p.load(b.bytes, b.len - 1), "truncated keys rejected");
+    check(!p.load(b.bytes + 1, b.len - 1), "misaligned blob rejected");
+    b.bytes[0] = 'X';
+    check(!p.load(b.bytes, b.len), "bad magic rejected");
+}
+
+void test_sampling() {
+    std::printf("sampling:\n");
+    TimelinePlayer p;
+    Blob b = make_timeline(false);
+    p.load(b.bytes, b.len);
+    p.start(5000);
+    TimelineFrame f;
+    p.evaluate(5250, f);
+    check(f.has_gaze && std::fabs(f.gaze_x - 2.5f) < 1e-4f && std::fabs(f.gaze_y + 2.5f) < 1e-4f,
+          "linear gaze at a quarter of the way");
+    check(f.has_emotion && f.emotion == 1 && !f.has_pupil && !f.has_eyelid, "stepped emotion, absent tracks unset");
+    p.evaluate(5700, f);
+    check(f.emotion == 3, "emotion steps at its key");
+}
+
+void test_loop_wrap() {
+    std::printf("loop wrap:\n");
+    TimelinePlayer p;
+    Blob b = make_timeline(true);
+    p.load(b.bytes, b.len);
+    p.start(0);
+    TimelineFrame f;
+    p.evaluate(0, f);
+    p.evaluate(500, f);
+    check(cues_are(f, {1}), "cue at 100 fires once crossed");
+    p.evaluate(940, f);
+    check(cues_are(f, {}), "no cue between 500 and 940");
+    p.evaluate(1020, f);
+    check(cues_are(f, {2, 3}) && !f.finished && p.playing(), "cues at 950 and 990 fire on the wrapping frame");
+    check(std::fabs(f.gaze_x - 0.2f) < 1e-4f, "tracks sample the wrapped position (20)");
+    p.evaluate(1120, f);
+    check(cues_are(f, {1}), "cue at 100 fires again on the second pass");
+    p.evaluate(2110, f);
+    check(cues_are(f, {2, 3, 1}), "a frame spanning the end and the next start fires all three");
+}
+
+void test_backwards() {
+    std::printf("clock stepping backwards:\n");
+    TimelinePlayer p;
+    Blob b = make_timeline(false);
+    p.load(b.bytes, b.len);
+    p.start(0);
+    TimelineFrame f;
+    p.evaluate(960, f);
+    check(cues_are(f, {1, 2}) && f.emotion == 3, "cues at 100 and 950 fire up to 960");
+    p.evaluate(500, f);
+    check(cues_are(f, {}) && f.emotion == 1 && std::fabs(f.gaze_x - 5.f) < 1e-4f,
+          "back to 500: tracks re-sample, no cue fires");
+    p.evaluate(960, f);
+    check(cues_are(f, {2}), "forward to 960 again: only the cue ahead (950) fires");
+    p.evaluate(960, f);
+    check(cues_are(f, {}), "same position: nothing fires");
+}
+
+void test_end() {
+    std::printf("non-looping end:\n");
+    TimelinePlayer p;
+    Blob b = make_timeline(false);
+    p.load(b.bytes, b.len);
+    p.start(0);
+    TimelineFrame f;
+    p.evaluate(940, f);
+    p.evaluate(1500, f);
+    check(cues_are(f, {2, 3}) && f.finished && !p.playing(), "cues before the end fire on the last frame");
+    check(f.has_gaze && std::fabs(f.gaze_x - 10.f) < 1e-4f, "last frame samples the end");
+    p.evaluate(1600, f);
+    check(f.finished && f.cue_count == 0 && !f.has_gaze, "after the end: finished, nothing sampled");
+}
+
+} // namespace
+
+int main() {
+    test_load();
+    test_sampling();
+    test_loop_wrap();
+    test_backwards();
+    test_end();
+    std::printf("%s\n", g_ok ? "all ok" : "FAILED");
+    return g_ok ? 0 : 1;
+}